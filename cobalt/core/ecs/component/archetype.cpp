@@ -0,0 +1,76 @@
+/**
+ * @file archetype.cpp
+ * @brief An archetype is a table holding every entity that owns exactly the same set of components.
+ * @author Tomás Marques
+ * @date 02-09-2024
+ */
+
+#include "core/ecs/component/archetype.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        Archetype::Archetype(const ComponentProperties::Signature& signature, Vec<Scope<ComponentStorageInterface>>&& columns,
+                             std::pmr::memory_resource* resource) noexcept
+            : signature(signature), entities(resource), columns(Move(columns)), columnIndices(), edges() {
+            uint column = 0;
+            for (uint64 i = 0; i < signature.size(); i++) {
+                if (signature.test(i)) {
+                    columnIndices.resize(i + 1, NO_COLUMN);
+                    columnIndices[i] = column++;
+                }
+            }
+        }
+
+        uint64 Archetype::add(const EntityProperties::ID entityID) noexcept {
+            entities.push_back(entityID);
+            return entities.size() - 1;
+        }
+
+        EntityProperties::ID Archetype::remove(const uint64 row) noexcept {
+            for (auto& column : columns) {
+                column->remove(row);
+            }
+            const EntityProperties::ID removed = entities[row];
+            entities[row] = entities.back();
+            entities.pop_back();
+            return row < entities.size() ? entities[row] : removed;
+        }
+
+        uint64 Archetype::moveTo(const uint64 row, Archetype& other) {
+            const uint64 otherRow = other.add(entities[row]);
+            for (uint64 i = 0; i < columnIndices.size(); i++) {
+                if (columnIndices[i] != NO_COLUMN && other.has(i)) {
+                    other.getColumn(i).moveFrom(*columns[columnIndices[i]], row);
+                }
+            }
+            remove(row);
+            return otherRow;
+        }
+
+        void Archetype::reserve(const uint64 capacity) {
+            entities.reserve(capacity);
+            for (auto& column : columns) {
+                column->reserve(capacity);
+            }
+        }
+
+        const bool Archetype::has(const uint64 componentIndex) const noexcept {
+            return componentIndex < columnIndices.size() && columnIndices[componentIndex] != NO_COLUMN;
+        }
+
+        ComponentStorageInterface& Archetype::getColumn(const uint64 componentIndex) noexcept { return *columns[columnIndices[componentIndex]]; }
+
+        Archetype* Archetype::getEdge(const uint64 componentIndex) const noexcept {
+            const auto edge = edges.find(componentIndex);
+            return edge == edges.end() ? nullptr : edge->second;
+        }
+
+        void Archetype::setEdge(const uint64 componentIndex, Archetype* archetype) noexcept { edges[componentIndex] = archetype; }
+
+        const ComponentProperties::Signature& Archetype::getSignature() const noexcept { return signature; }
+
+        const std::pmr::vector<EntityProperties::ID>& Archetype::getEntities() const noexcept { return entities; }
+
+        const uint64 Archetype::getSize() const noexcept { return entities.size(); }
+    }  // namespace core::ecs
+}  // namespace cobalt
@@ -0,0 +1,142 @@
+/**
+ * @file archetype.h
+ * @brief An archetype is a table holding every entity that owns exactly the same set of components.
+ * @author Tomás Marques
+ * @date 02-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/component/storage.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief An archetype is a table holding every entity that owns exactly the same set of components (its signature).
+         * Each component type in the signature gets its own packed column, and row i of every column belongs to the i-th entity of the table.
+         * Adding or removing a component moves an entity to the archetype matching its new signature.
+         */
+        class Archetype {
+            public:
+            /**
+             * @brief Creates a new, empty archetype.
+             * @param signature The component signature of the archetype.
+             * @param columns One empty storage per set bit of the signature, in ascending bit order.
+             * @param resource The memory resource to allocate the entity list from.
+             */
+            Archetype(const ComponentProperties::Signature& signature, Vec<Scope<ComponentStorageInterface>>&& columns,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+            /**
+             * @brief Default destructor.
+             */
+            ~Archetype() noexcept = default;
+            /**
+             * @brief Copy constructor (deleted).
+             * @param other The archetype to copy.
+             */
+            Archetype(const Archetype&) noexcept = delete;
+            /**
+             * @brief Move constructor (deleted).
+             * @param other The archetype to move.
+             */
+            Archetype(Archetype&&) noexcept = delete;
+            /**
+             * @brief Copy assignment operator (deleted).
+             * @param other The archetype to copy.
+             */
+            Archetype& operator=(const Archetype&) noexcept = delete;
+            /**
+             * @brief Move assignment operator (deleted).
+             * @param other The archetype to move.
+             */
+            Archetype& operator=(Archetype&&) noexcept = delete;
+
+            /**
+             * @brief Append an entity to the table. The caller is responsible for pushing one component into every column.
+             * @param entityID The entity to append.
+             * @return The entity's row.
+             */
+            uint64 add(const EntityProperties::ID entityID) noexcept;
+            /**
+             * @brief Remove a row from the table, destroying its components. The last row is moved into its place.
+             * @param row The row to remove.
+             * @return The ID of the entity that now occupies the row, or the removed entity's ID if it was the last row.
+             */
+            EntityProperties::ID remove(const uint64 row) noexcept;
+            /**
+             * @brief Move a row into another archetype. Every component shared by both signatures is moved, the others are destroyed.
+             * Columns in the destination that do not exist in this archetype are left for the caller to fill.
+             * @param row The row to move.
+             * @param other The destination archetype.
+             * @return The entity's row in the destination archetype.
+             */
+            uint64 moveTo(const uint64 row, Archetype& other);
+            /**
+             * @brief Reserve space for a number of rows in every column.
+             * @param capacity The number of rows to reserve space for.
+             */
+            void reserve(const uint64 capacity);
+
+            /**
+             * @brief Check if the archetype has a column for a component.
+             * @param componentIndex The component's index in the signature.
+             * @return True if the column exists, false otherwise.
+             */
+            const bool has(const uint64 componentIndex) const noexcept;
+            /**
+             * @brief Get the column of a component. The component must be part of the signature.
+             * @param componentIndex The component's index in the signature.
+             * @return The type-erased column.
+             */
+            ComponentStorageInterface& getColumn(const uint64 componentIndex) noexcept;
+            /**
+             * @brief Get the column of a component. The component must be part of the signature.
+             * @tparam ComponentType The component type.
+             * @param componentIndex The component's index in the signature.
+             * @return The typed column.
+             */
+            template <typename ComponentType>
+            ComponentStorage<ComponentType>& getColumn(const uint64 componentIndex) noexcept {
+                return static_cast<ComponentStorage<ComponentType>&>(*columns[columnIndices[componentIndex]]);
+            }
+
+            /**
+             * @brief Get the cached destination archetype of adding or removing a component.
+             * @param componentIndex The component's index in the signature.
+             * @return The destination archetype, or nullptr if it has not been resolved yet.
+             */
+            Archetype* getEdge(const uint64 componentIndex) const noexcept;
+            /**
+             * @brief Cache the destination archetype of adding or removing a component.
+             * @param componentIndex The component's index in the signature.
+             * @param archetype The destination archetype.
+             */
+            void setEdge(const uint64 componentIndex, Archetype* archetype) noexcept;
+
+            /**
+             * @brief Get the archetype's component signature.
+             * @return The component signature.
+             */
+            const ComponentProperties::Signature& getSignature() const noexcept;
+            /**
+             * @brief Get the entities in the table, in row order.
+             * @return The entities.
+             */
+            const std::pmr::vector<EntityProperties::ID>& getEntities() const noexcept;
+            /**
+             * @brief Get the number of rows in the table.
+             * @return The number of rows.
+             */
+            const uint64 getSize() const noexcept;
+
+            private:
+            static inline constexpr uint NO_COLUMN = num::MAX_UINT32;  ///< Marks a component that has no column in this archetype.
+
+            ComponentProperties::Signature signature;         ///< The component signature shared by every entity in the table.
+            std::pmr::vector<EntityProperties::ID> entities;  ///< The entity owning each row.
+            Vec<Scope<ComponentStorageInterface>> columns;    ///< One packed storage per component in the signature.
+            Vec<uint> columnIndices;                          ///< Maps component indices to columns, up to the highest set bit.
+            UMap<uint64, Archetype*> edges;                   ///< Archetypes reached by toggling a single component.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
@@ -9,15 +9,19 @@
 
 namespace cobalt {
     namespace core::ecs {
-        const ComponentProperties::Type Component::getType() const noexcept {
-            static const ComponentProperties::Type type = typeid(*this).hash_code();
-            return type;
-        }
+        const ComponentProperties::Type Component::getType() const noexcept { return registerType(typeid(*this)); }
 
         const std::string& Component::getTypeName() const noexcept {
             static const std::string typeName = demangle(typeid(*this).name());
             return typeName;
         }
 
+        const ComponentProperties::Type Component::registerType(const std::type_index type) noexcept {
+            static std::mutex mutex;
+            static UMap<std::type_index, ComponentProperties::Type> types;
+            std::lock_guard<std::mutex> lock(mutex);
+            return types.try_emplace(type, types.size()).first->second;
+        }
+
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
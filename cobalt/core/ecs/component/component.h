@@ -34,18 +34,19 @@ namespace cobalt {
             }
 
             /**
-             * @brief Get the component's type. This is a unique identifier, lazy-generated based on the component class's name.
+             * @brief Get the component's type. This is a unique, dense identifier handed out the first time the component class is seen.
              * @return Component type identifier.
              */
             virtual const ComponentProperties::Type getType() const noexcept;
             /**
-             * @brief Get the component's type. This is a unique identifier, generated at compile time based on the component class's name.
+             * @brief Get the component's type. This is a unique, dense identifier handed out the first time the component class is seen, so
+             * types can index flat arrays. After the first call, it costs a single load.
              * @tparam ComponentType The component type.
              * @return The component's type identifier.
              */
             template <typename ComponentType>
             static const ComponentProperties::Type getType() noexcept {
-                static const ComponentProperties::Type type = typeid(ComponentType).hash_code();
+                static const ComponentProperties::Type type = registerType(typeid(ComponentType));
                 return type;
             }
 
@@ -64,6 +65,14 @@ namespace cobalt {
                 static const std::string typeName = demangle(typeid(ComponentType).name());
                 return typeName;
             }
+
+            private:
+            /**
+             * @brief Hands out the next component type identifier to a class, or returns the one it already has.
+             * @param type The component class.
+             * @return The component type identifier.
+             */
+            static const ComponentProperties::Type registerType(const std::type_index type) noexcept;
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
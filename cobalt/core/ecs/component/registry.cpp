@@ -9,11 +9,106 @@
 
 namespace cobalt {
     namespace core::ecs {
+        ComponentRegistry::ComponentRegistry(const MemoryConfig& memory) noexcept
+            : componentPool(std::pmr::pool_options{0, PAGE_SIZE}, core::memory::MemoryTracker::getResource(core::memory::MemoryTag::ECS)),
+              tableArena(TABLE_ARENA_SIZE, core::memory::MemoryTag::ECS),
+              tableArenaResource(tableArena),
+              componentUpstream(memory.components ? memory.components : &componentPool),
+              tableMemory(memory.tables ? memory.tables : &tableArenaResource),
+              records(&tableMemory),
+              flushedTick(0),
+              changeTick(0) {
+            getArchetype(ComponentProperties::Signature());
+        }
+
+        Pair<Archetype&, ComponentProperties::Signature> ComponentRegistry::extend(const EntityProperties::ID& entityID,
+                                                                                  const ComponentProperties::Signature& added) {
+            if (entityID >= records.size()) {
+                records.resize(entityID + 1, Record{nullptr, 0});
+            }
+            Record& record = records[entityID];
+            if (!record.archetype) {
+                record = Record{archetypes[0].get(), archetypes[0]->add(entityID)};
+            }
+            const ComponentProperties::Signature missing = added.without(record.archetype->getSignature());
+            if (missing.any()) {
+                moveEntity(record, getArchetype(record.archetype->getSignature() | missing));
+            }
+            return {*record.archetype, missing};
+        }
+
         void ComponentRegistry::removeAll(const EntityProperties::ID& entityID) noexcept {
-            for (const auto& [type, storage] : store) {
-                storage->remove(entityID);
+            if (entityID >= records.size() || !records[entityID].archetype) {
+                return;
+            }
+            Record& record = records[entityID];
+            logRemovals(entityID, record.archetype->getSignature());
+            const EntityProperties::ID moved = record.archetype->remove(record.row);
+            if (moved != entityID) {
+                records[moved].row = record.row;
+            }
+            record = Record{nullptr, 0};
+        }
+
+        const core::memory::MemoryUsage& ComponentRegistry::getTableMemoryUsage() const noexcept { return tableMemory.getUsage(); }
+
+        const Vec<Scope<Archetype>>& ComponentRegistry::getArchetypes() const noexcept { return archetypes; }
+
+        ChangeTicks ComponentRegistry::getTicks() const noexcept {
+            return currentTicks ? *currentTicks : ChangeTicks{0, changeTick.load(std::memory_order_relaxed) + 1};
+        }
+
+        const Vec<Pair<EntityProperties::ID, uint64>>& ComponentRegistry::getRemovals(const uint64 index) const noexcept { return removals[index]; }
+
+        void ComponentRegistry::flushRemovals() noexcept {
+            for (Vec<Pair<EntityProperties::ID, uint64>>& removed : removals) {
+                std::erase_if(removed, [this](const Pair<EntityProperties::ID, uint64>& removal) { return removal.second <= flushedTick; });
+            }
+            flushedTick = changeTick.load(std::memory_order_relaxed);
+        }
+
+        Archetype& ComponentRegistry::getArchetype(const ComponentProperties::Signature& signature) {
+            const auto archetype = archetypeIndex.find(signature);
+            if (archetype != archetypeIndex.end()) {
+                return *archetype->second;
+            }
+            Vec<Scope<ComponentStorageInterface>> columns;
+            for (uint64 i = 0; i < prototypes.size(); i++) {
+                if (signature.test(i)) {
+                    columns.push_back(prototypes[i]->makeEmpty());
+                }
+            }
+            archetypes.push_back(CreateScope<Archetype>(signature, Move(columns), &tableMemory));
+            archetypeIndex.emplace(signature, archetypes.back().get());
+            return *archetypes.back();
+        }
+
+        Archetype& ComponentRegistry::getEdge(Archetype& archetype, const uint64 index) {
+            Archetype* edge = archetype.getEdge(index);
+            if (!edge) {
+                edge = &getArchetype(ComponentProperties::Signature(archetype.getSignature()).flip(index));
+                archetype.setEdge(index, edge);
+                edge->setEdge(index, &archetype);
+            }
+            return *edge;
+        }
+
+        void ComponentRegistry::moveEntity(Record& record, Archetype& destination) {
+            const uint64 row = record.archetype->moveTo(record.row, destination);
+            if (record.row < record.archetype->getSize()) {
+                records[record.archetype->getEntities()[record.row]].row = record.row;
+            }
+            record.archetype = &destination;
+            record.row = row;
+        }
+
+        void ComponentRegistry::logRemovals(const EntityProperties::ID& entityID, const ComponentProperties::Signature& removed) {
+            const uint64 tick = getTicks().thisRun;
+            for (uint64 i = 0; i < removals.size(); i++) {
+                if (removed.test(i)) {
+                    removals[i].emplace_back(entityID, tick);
+                }
             }
-            signatures[entityID].reset();
         }
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
@@ -7,22 +7,42 @@
 
 #pragma once
 
-#include "core/ecs/component/storage.h"
+#include "core/ecs/component/archetype.h"
 #include "core/ecs/exception.h"
-
-#define CB_ECS_MAX_COMPONENTS 64
+#include "core/memory/arena.h"
+#include "core/memory/counting.h"
 
 namespace cobalt {
     namespace core::ecs {
+        /**
+         * @brief The ticks bracketing a system run. Components handed out mutably during the run are stamped with thisRun, and change filters
+         * match components stamped after lastRun.
+         */
+        struct ChangeTicks {
+            uint64 lastRun;  ///< The tick at which the system last ran, or 0 if it never did.
+            uint64 thisRun;  ///< The tick at which the system is running.
+        };
+
+        /**
+         * @brief Where the ECS gets its memory from. Resources left null fall back to ones owned by the component registry.
+         * The ECS only allocates from these while no system is running, so they do not need to be thread-safe.
+         */
+        struct MemoryConfig {
+            std::pmr::memory_resource* components = nullptr;  ///< Backs the component columns. Defaults to a pool with page-sized blocks.
+            std::pmr::memory_resource* tables = nullptr;      ///< Backs the entity lists and records of the tables. Defaults to an arena.
+        };
+
         /**
          * @brief Registry class to store all components in a central location.
+         * Components are stored in archetype tables: entities with the same signature share a table with one packed column per component type.
          */
         class ComponentRegistry {
             public:
             /**
-             * @brief Default constructor.
+             * @brief Creates an empty registry.
+             * @param memory Where to allocate components and tables from.
              */
-            ComponentRegistry() noexcept = default;
+            explicit ComponentRegistry(const MemoryConfig& memory = MemoryConfig()) noexcept;
             /**
              * @brief Default destructor.
              */
@@ -56,13 +76,17 @@ namespace cobalt {
             void registerComponent() {
                 Component::template validate<ComponentType>();
                 const ComponentProperties::Type type = Component::template getType<ComponentType>();
-                if (store.find(type) == store.end()) {
-                    if (typeIndices.size() >= CB_ECS_MAX_COMPONENTS) {
+                if (indexOf(type) == NO_INDEX) {
+                    if (prototypes.size() >= CB_ECS_MAX_COMPONENTS) {
                         throw ComponentOverflowException<ComponentType, ComponentRegistry>(CB_ECS_MAX_COMPONENTS);
                     }
-                    store[type] = Move(CreateScope<ComponentStorage<ComponentType>>());
-                    const uint64 index = typeIndices.size();
-                    typeIndices[type] = index;
+                    if (type >= typeIndices.size()) {
+                        typeIndices.resize(type + 1, NO_INDEX);
+                    }
+                    typeIndices[type] = prototypes.size();
+                    componentMemory.push_back(CreateScope<core::memory::CountingResource>(componentUpstream));
+                    prototypes.push_back(Move(CreateScope<ComponentStorage<ComponentType>>(componentMemory.back().get())));
+                    removals.emplace_back();
                 }
             }
 
@@ -73,14 +97,7 @@ namespace cobalt {
              */
             template <typename ComponentType>
             void add(const EntityProperties::ID& entityID) noexcept {
-                Component::template validate<ComponentType>();
-                const ComponentProperties::Type type = Component::template getType<ComponentType>();
-                if (store.find(type) == store.end()) {
-                    CB_CORE_WARN("Component \"{0}\" not registered", Component::template getTypeName<ComponentType>());
-                    return;
-                }
-                store[type]->add(entityID, ComponentType());
-                signatures[entityID].set(typeIndices[type]);
+                add<ComponentType>(entityID, ComponentType());
             }
             /**
              * @brief Add a component to an entity.
@@ -92,13 +109,69 @@ namespace cobalt {
             void add(const EntityProperties::ID& entityID, Args&&... args) noexcept {
                 Component::template validate<ComponentType>();
                 static_assert(std::is_constructible<ComponentType, Args...>::value, "T must be constructible with Args.");
-                const ComponentProperties::Type type = Component::template getType<ComponentType>();
-                if (store.find(type) == store.end()) {
+                const uint64 index = indexOf(Component::template getType<ComponentType>());
+                if (index == NO_INDEX) {
                     CB_CORE_WARN("Component \"{0}\" not registered", Component::template getTypeName<ComponentType>());
                     return;
                 }
-                store[type]->add(entityID, ComponentType(std::forward<Args>(args)...));
-                signatures[entityID].set(typeIndices[type]);
+                if (entityID >= records.size()) {
+                    records.resize(entityID + 1, Record{nullptr, 0});
+                }
+                Record& record = records[entityID];
+                if (!record.archetype) {
+                    record = Record{archetypes[0].get(), archetypes[0]->add(entityID)};
+                } else if (record.archetype->has(index)) {
+                    return;
+                }
+                Archetype& destination = getEdge(*record.archetype, index);
+                moveEntity(record, destination);
+                destination.template getColumn<ComponentType>(index).emplace(getTicks().thisRun, std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Add a component to a batch of entities, moving one value into each. Entities coming from the same table are moved together:
+             * the destination table is looked up and reserved once, and the components are written to it contiguously.
+             * @tparam ComponentType The component type.
+             * @param entityIDs The entities to add the component to. Those that already have it are skipped.
+             * @param components The component of each entity, in the same order. Moved from.
+             */
+            template <typename ComponentType>
+            void addBatch(std::span<const EntityProperties::ID> entityIDs, std::span<ComponentType> components) {
+                Component::template validate<ComponentType>();
+                const Opt<ComponentProperties::Signature> added = getSignature<ComponentType>();
+                if (!added) {
+                    CB_CORE_WARN("Component \"{0}\" not registered", Component::template getTypeName<ComponentType>());
+                    return;
+                }
+                const uint64 index = indexOf(Component::template getType<ComponentType>());
+                const uint64 tick = getTicks().thisRun;
+                insertBatch(entityIDs, *added, [&](Archetype& destination, const ComponentProperties::Signature& missing, const uint64 i) {
+                    destination.template getColumn<ComponentType>(index).emplace(tick, Move(components[i]));
+                });
+            }
+            /**
+             * @brief Add a copy of the same set of components to a batch of entities. Entities coming from the same table are moved together:
+             * the destination table is looked up and reserved once, and the components are written to it contiguously.
+             * @tparam ComponentTypes... The component types.
+             * @param entityIDs The entities to add the components to. Components an entity already has are skipped.
+             * @param components The components to copy into each entity.
+             */
+            template <typename... ComponentTypes>
+            void fillBatch(std::span<const EntityProperties::ID> entityIDs, const ComponentTypes&... components) {
+                Component::template validate<ComponentTypes...>();
+                const Opt<ComponentProperties::Signature> added = getSignature<ComponentTypes...>();
+                if (!added) {
+                    CB_CORE_WARN("Component not registered");
+                    return;
+                }
+                const std::array<uint64, sizeof...(ComponentTypes)> indices = {indexOf(Component::template getType<ComponentTypes>())...};
+                const uint64 tick = getTicks().thisRun;
+                insertBatch(entityIDs, *added, [&](Archetype& destination, const ComponentProperties::Signature& missing, const uint64 i) {
+                    [&]<size_t... Is>(std::index_sequence<Is...>) {
+                        ((missing.test(indices[Is]) ? destination.template getColumn<ComponentTypes>(indices[Is]).emplace(tick, components) : void()),
+                         ...);
+                    }(std::index_sequence_for<ComponentTypes...>{});
+                });
             }
 
             /**
@@ -109,14 +182,35 @@ namespace cobalt {
             template <typename... ComponentTypes>
             void remove(const EntityProperties::ID& entityID) noexcept {
                 Component::template validate<ComponentTypes...>();
-                try {
-                    (store.at(Component::getType<ComponentTypes>())->remove(entityID), ...);
-                } catch (const std::out_of_range& e) {
-                    CB_CORE_WARN("Component not registered", e.what());
+                if (entityID >= records.size() || !records[entityID].archetype) {
                     return;
                 }
-                (signatures[entityID].reset(typeIndices.at(Component::template getType<ComponentTypes>())), ...);
+                Record& record = records[entityID];
+                Archetype* destination = record.archetype;
+                for (const ComponentProperties::Type type : {Component::template getType<ComponentTypes>()...}) {
+                    const uint64 index = indexOf(type);
+                    if (index == NO_INDEX) {
+                        CB_CORE_WARN("Component not registered");
+                        return;
+                    }
+                    if (destination->has(index)) {
+                        destination = &getEdge(*destination, index);
+                    }
+                }
+                if (destination != record.archetype) {
+                    logRemovals(entityID, record.archetype->getSignature().without(destination->getSignature()));
+                    moveEntity(record, *destination);
+                }
             }
+            /**
+             * @brief Move an entity straight to the table holding its current components plus a set of new ones, no matter how many are added.
+             * The new components' columns are left for the caller to fill, once each.
+             * @param entityID The entity to add the components to.
+             * @param added The components to add. Those the entity already has are ignored.
+             * @return The entity's new table and the components whose columns must be filled.
+             */
+            Pair<Archetype&, ComponentProperties::Signature> extend(const EntityProperties::ID& entityID,
+                                                                    const ComponentProperties::Signature& added);
             /**
              * @brief Remove all the components from an entity.
              * @param entityID The entity to remove the components from.
@@ -131,35 +225,38 @@ namespace cobalt {
              */
             template <typename ComponentRef>
             ComponentRef get(const EntityProperties::ID& entityID) {
-                try {
-                    return dynamic_cast<ComponentRef>(store.at(Component::template getType<RemoveConstRef<ComponentRef>>())->get(entityID));
-                } catch (const std::out_of_range& e) {
-                    throw ComponentNotFoundException<RemoveConstRef<ComponentRef>, ComponentRegistry>(entityID);
+                using ComponentType = RemoveConstRef<ComponentRef>;
+                const auto [archetype, row, index] = locate<ComponentType>(entityID);
+                ComponentStorage<ComponentType>& column = archetype->template getColumn<ComponentType>(index);
+                if constexpr (!std::is_const_v<std::remove_reference_t<ComponentRef>>) {
+                    column.getChangedTicks()[row] = getTicks().thisRun;
                 }
+                return column.at(row);
             }
             /**
              * @brief Get a component from an entity.
-             * @tparam ComponentRef The component type reference.
+             * @tparam ComponentRef The component type reference. Must be a const reference, as writes through a const registry would not be
+             * stamped for change detection.
              * @param entityID The entity to get the component from.
              * @return Const reference to the component.
              */
             template <typename ComponentRef>
             ComponentRef get(const EntityProperties::ID& entityID) const {
-                try {
-                    return dynamic_cast<ComponentRef>(store.at(Component::template getType<RemoveConstRef<ComponentRef>>())->get(entityID));
-                } catch (const std::out_of_range& e) {
-                    throw ComponentNotFoundException<RemoveConstRef<ComponentRef>, ComponentRegistry>(entityID);
-                }
+                static_assert(std::is_const<std::remove_reference_t<ComponentRef>>::value,
+                              "Component type must be a const reference on a const registry.");
+                using ComponentType = RemoveConstRef<ComponentRef>;
+                const auto [archetype, row, index] = locate<ComponentType>(entityID);
+                return archetype->template getColumn<ComponentType>(index).at(row);
             }
 
             /**
-             * @brief Get a set of components from an entity.
+             * @brief Get a set of components from an entity. Mutable references stamp their components as changed, like get().
              * @tparam ComponentRefs... The component types references.
              * @param entityID The entity to get the components from.
              * @return References to the components.
              */
             template <typename... ComponentRefs>
-            Tuple<ComponentRefs...> getMany(const EntityProperties::ID& entityID) const {
+            Tuple<ComponentRefs...> getMany(const EntityProperties::ID& entityID) {
                 Component::template validate<RemoveConstRef<ComponentRefs>...>();
                 return (std::make_tuple(std::ref(get<ComponentRefs>(entityID))...));
             }
@@ -173,15 +270,245 @@ namespace cobalt {
             template <typename... ComponentTypes>
             const bool has(const EntityProperties::ID& entityID) const {
                 Component::template validate<ComponentTypes...>();
-                return signatures.find(entityID) != signatures.end() &&
-                       (signatures.at(entityID).test(typeIndices.at(Component::template getType<ComponentTypes>())) && ...);
+                if (entityID >= records.size() || !records[entityID].archetype) {
+                    return false;
+                }
+                const ComponentProperties::Signature& signature = records[entityID].archetype->getSignature();
+                return (hasBit<ComponentTypes>(signature) && ...);
+            }
+
+            /**
+             * @brief Get the signature matching a set of component types.
+             * @tparam ComponentTypes... The component types.
+             * @return The signature, or None if any of the component types is not registered.
+             */
+            template <typename... ComponentTypes>
+            Opt<ComponentProperties::Signature> getSignature() const noexcept {
+                ComponentProperties::Signature signature;
+                for (const ComponentProperties::Type type : {Component::template getType<ComponentTypes>()...}) {
+                    const uint64 index = indexOf(type);
+                    if (index == NO_INDEX) {
+                        return None;
+                    }
+                    signature.set(index);
+                }
+                return signature;
+            }
+
+            /**
+             * @brief Get a component type's index into the signature mask. The component must be registered.
+             * @tparam ComponentType The component type.
+             * @return The component's index.
+             */
+            template <typename ComponentType>
+            const uint64 getIndex() const {
+                const uint64 index = indexOf(Component::template getType<ComponentType>());
+                if (index == NO_INDEX) {
+                    throw std::out_of_range("Component not registered");
+                }
+                return index;
+            }
+            /**
+             * @brief Get a component type's index into the signature mask.
+             * @tparam ComponentType The component type.
+             * @return The component's index, or None if it is not registered.
+             */
+            template <typename ComponentType>
+            Opt<uint64> findIndex() const noexcept {
+                const uint64 index = indexOf(Component::template getType<ComponentType>());
+                return index == NO_INDEX ? Opt<uint64>(None) : Opt<uint64>(index);
+            }
+
+            /**
+             * @brief Get the memory used by a component type's columns, over every table. The component must be registered.
+             * @tparam ComponentType The component type.
+             * @return The memory usage.
+             */
+            template <typename ComponentType>
+            const core::memory::MemoryUsage& getMemoryUsage() const {
+                return componentMemory[getIndex<ComponentType>()]->getUsage();
+            }
+            /**
+             * @brief Get the memory used by the tables' bookkeeping: every table's entity list and the entity records.
+             * @return The memory usage.
+             */
+            const core::memory::MemoryUsage& getTableMemoryUsage() const noexcept;
+
+            /**
+             * @brief Get every archetype table. Tables are never destroyed, so pointers to them stay valid for the registry's lifetime.
+             * @return The archetypes.
+             */
+            const Vec<Scope<Archetype>>& getArchetypes() const noexcept;
+
+            /**
+             * @brief Run a function as a system run. Every component handed out mutably on the calling thread while it runs is stamped with
+             * the run's tick.
+             * @tparam Func The function type.
+             * @param lastRun The tick returned by the system's previous run, or 0 if it never ran.
+             * @param func The function.
+             * @return The run's tick, to pass as lastRun next time.
+             */
+            template <typename Func>
+            uint64 track(const uint64 lastRun, Func&& func) {
+                const ChangeTicks ticks{lastRun, changeTick.fetch_add(1, std::memory_order_relaxed) + 1};
+                struct Restore {
+                    const ChangeTicks* previous;
+                    ~Restore() { currentTicks = previous; }
+                } restore{currentTicks};
+                currentTicks = &ticks;
+                func();
+                return ticks.thisRun;
             }
+            /**
+             * @brief Get the ticks of the system running on the calling thread. Outside of a system, nothing counts as seen and changes are
+             * stamped with the next tick.
+             * @return The ticks.
+             */
+            ChangeTicks getTicks() const noexcept;
+
+            /**
+             * @brief Get the components of a type removed recently, along with the tick at which they were removed. Removals are kept until the
+             * second call to flushRemovals() after they happened, so every system gets to see them.
+             * @param index The component type's index into the signature mask.
+             * @return The removed entities and their removal ticks.
+             */
+            const Vec<Pair<EntityProperties::ID, uint64>>& getRemovals(const uint64 index) const noexcept;
+            /**
+             * @brief Forget the removals that happened before the previous flush. Meant to be called once per frame.
+             */
+            void flushRemovals() noexcept;
 
             private:
-            UMap<ComponentProperties::Type, Scope<ComponentStorageInterface>> store;  ///< Component store. Maps component types to their storage.
-            UMap<EntityProperties::ID, Mask<CB_ECS_MAX_COMPONENTS>>
-                signatures;                                       ///< Entity signatures. Maps entity IDs to their component signatures.
-            UMap<ComponentProperties::Type, uint64> typeIndices;  ///< Maps component types to indices into their signature mask.
+            /**
+             * @brief The location of an entity's components.
+             */
+            struct Record {
+                Archetype* archetype;  ///< The table holding the entity, or nullptr if it has no components.
+                uint64 row;            ///< The entity's row in the table.
+            };
+
+            static inline constexpr size_t PAGE_SIZE = 4096;          ///< The largest block the default component pool hands out itself.
+            static inline constexpr size_t TABLE_ARENA_SIZE = 65536;  ///< The initial size of the default table arena.
+
+            std::pmr::unsynchronized_pool_resource componentPool;             ///< The default backing for component columns.
+            core::memory::ArenaAllocator tableArena;                          ///< The default backing for the tables.
+            core::memory::ArenaResource tableArenaResource;                   ///< Adapts the table arena for the tables' containers.
+            std::pmr::memory_resource* componentUpstream;                     ///< Backs the component columns.
+            core::memory::CountingResource tableMemory;                       ///< Counts the memory used by the tables.
+            Vec<Scope<core::memory::CountingResource>> componentMemory;       ///< Counts the memory used by each component index's columns.
+            Vec<Scope<Archetype>> archetypes;                                 ///< Every archetype table. The first one has no components.
+            UMap<ComponentProperties::Signature, Archetype*> archetypeIndex;  ///< Maps signatures to their archetype table.
+            std::pmr::vector<Record> records;                                 ///< The location of each entity's components, indexed by entity ID.
+            Vec<uint64> typeIndices;                                          ///< Each component type's index into the signature mask, or NO_INDEX.
+            Vec<Scope<ComponentStorageInterface>> prototypes;                 ///< An empty storage per component index, used to create columns.
+            Vec<Vec<Pair<EntityProperties::ID, uint64>>> removals;            ///< The recently removed entities per component index.
+            uint64 flushedTick;                                               ///< The tick at which removals were last flushed.
+            std::atomic<uint64> changeTick;                                   ///< The tick of the latest system run.
+
+            static inline thread_local const ChangeTicks* currentTicks = nullptr;  ///< The ticks of the system running on this thread.
+
+            static constexpr uint64 NO_INDEX = num::MAX_UINT64;  ///< Marks component types that are not registered.
+
+            /**
+             * @brief Get a component type's index into the signature mask.
+             * @param type The component type.
+             * @return The component's index, or NO_INDEX if it is not registered.
+             */
+            const uint64 indexOf(const ComponentProperties::Type type) const noexcept {
+                return type < typeIndices.size() ? typeIndices[type] : NO_INDEX;
+            }
+
+            /**
+             * @brief Find the table, row and column index of one of an entity's components.
+             * @tparam ComponentType The component type.
+             * @param entityID The entity.
+             * @return The archetype, the entity's row and the component's index.
+             */
+            template <typename ComponentType>
+            Tuple<Archetype*, uint64, uint64> locate(const EntityProperties::ID& entityID) const {
+                const uint64 index = indexOf(Component::template getType<ComponentType>());
+                if (index == NO_INDEX || entityID >= records.size() || !records[entityID].archetype || !records[entityID].archetype->has(index)) {
+                    throw ComponentNotFoundException<ComponentType, ComponentRegistry>(entityID);
+                }
+                return {records[entityID].archetype, records[entityID].row, index};
+            }
+
+            /**
+             * @brief Test a component type's bit in a signature.
+             * @tparam ComponentType The component type.
+             * @param signature The signature to test.
+             * @return True if the bit is set, false if it is not or the component type is not registered.
+             */
+            template <typename ComponentType>
+            const bool hasBit(const ComponentProperties::Signature& signature) const noexcept {
+                const uint64 index = indexOf(Component::template getType<ComponentType>());
+                return index != NO_INDEX && signature.test(index);
+            }
+
+            /**
+             * @brief Get the archetype with a given signature, creating it if needed.
+             * @param signature The signature.
+             * @return The archetype.
+             */
+            Archetype& getArchetype(const ComponentProperties::Signature& signature);
+            /**
+             * @brief Get the archetype reached by adding or removing a component from another, following (and caching) the archetype graph edge.
+             * @param archetype The source archetype.
+             * @param index The index of the component to toggle.
+             * @return The destination archetype.
+             */
+            Archetype& getEdge(Archetype& archetype, const uint64 index);
+            /**
+             * @brief Move an entity to another archetype, keeping the record of the entity swapped into its old row up to date.
+             * @param record The entity's record.
+             * @param destination The destination archetype.
+             */
+            void moveEntity(Record& record, Archetype& destination);
+            /**
+             * @brief Move a batch of entities to the tables holding their current components plus a set of new ones. Consecutive entities
+             * coming from the same table share a single destination lookup and reservation.
+             * @tparam Emplace The function type.
+             * @param entityIDs The entities.
+             * @param added The components to add.
+             * @param emplace Fills the new columns of the entity at a position in the batch, given its table and the components it was missing.
+             */
+            template <typename Emplace>
+            void insertBatch(std::span<const EntityProperties::ID> entityIDs, const ComponentProperties::Signature& added, Emplace&& emplace) {
+                if (entityIDs.empty()) {
+                    return;
+                }
+                const EntityProperties::ID last = *std::max_element(entityIDs.begin(), entityIDs.end());
+                if (last >= records.size()) {
+                    records.resize(last + 1, Record{nullptr, 0});
+                }
+                Archetype* source = nullptr;
+                Archetype* destination = nullptr;
+                ComponentProperties::Signature missing;
+                for (uint64 i = 0; i < entityIDs.size(); i++) {
+                    Record& record = records[entityIDs[i]];
+                    Archetype* current = record.archetype ? record.archetype : archetypes[0].get();
+                    if (current != source) {
+                        source = current;
+                        missing = added.without(source->getSignature());
+                        destination = &getArchetype(source->getSignature() | missing);
+                        destination->reserve(destination->getSize() + entityIDs.size() - i);
+                    }
+                    if (!record.archetype) {
+                        record = Record{destination, destination->add(entityIDs[i])};
+                    } else if (missing.any()) {
+                        moveEntity(record, *destination);
+                    } else {
+                        continue;
+                    }
+                    emplace(*destination, missing, i);
+                }
+            }
+            /**
+             * @brief Log the removal of a set of an entity's components.
+             * @param entityID The entity.
+             * @param removed The removed components.
+             */
+            void logRemovals(const EntityProperties::ID& entityID, const ComponentProperties::Signature& removed);
         };
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
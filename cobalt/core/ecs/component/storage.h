@@ -1,6 +1,6 @@
 /**
  * @file storage.h
- * @brief Storage for a single type of components in the ECS.
+ * @brief Storage for a single type of components in the ECS. Used as a column of an archetype table.
  * @author Tomás Marques
  * @date 21-01-2024
  */
@@ -12,112 +12,223 @@
 namespace cobalt {
     namespace core::ecs {
         /**
-         * @brief Interface for component storage. Exposes an API to add, remove and get components.
-         * TODO: This uses virtual functions, which might not be ideal for this performance-critical code.
+         * @brief Type-erased interface for component storage. Exposes the structural operations an archetype needs to move rows between tables.
+         * Typed access goes through ComponentStorage directly, so none of these virtual functions are called when reading components.
          */
         class ComponentStorageInterface {
             public:
+            /**
+             * @brief Creates the storage's tick arrays.
+             * @param resource The memory resource the storage allocates from.
+             */
+            explicit ComponentStorageInterface(std::pmr::memory_resource* resource) noexcept : addedTicks(resource), changedTicks(resource) {}
             /**
              * @brief Default destructor.
              */
             virtual ~ComponentStorageInterface() = default;
 
             /**
-             * @brief Adds a component to the storage.
-             * @param entityID The ID of its entity.
-             * @param component Component to add.
+             * @brief Creates a new, empty storage for the same component type, allocating from the same memory resource.
+             * @return The new storage.
+             */
+            virtual Scope<ComponentStorageInterface> makeEmpty() const = 0;
+
+            /**
+             * @brief Moves a component from another storage of the same type into the back of this one.
+             * The source row is left in a moved-from state and must be removed by the caller.
+             * @param other The storage to move the component from.
+             * @param row The row of the component in the other storage.
+             */
+            virtual void moveFrom(ComponentStorageInterface& other, const uint64 row) = 0;
+
+            /**
+             * @brief Removes a component from the storage by swapping it with the last one.
+             * @param row The row of the component to remove.
              */
-            virtual void add(const EntityProperties::ID& entityID, const Component& component) noexcept = 0;
+            virtual void remove(const uint64 row) noexcept = 0;
 
             /**
-             * @brief Removes a component from the storage.
-             * @param entityID The ID of its entity.
+             * @brief Reserves space for a number of components.
+             * @param capacity The number of components to reserve space for.
              */
-            virtual void remove(const EntityProperties::ID& entityID) noexcept = 0;
+            virtual void reserve(const uint64 capacity) = 0;
 
             /**
              * @brief Gets a component from the storage.
-             * @param entityID The ID of its entity.
+             * @param row The row of the component.
              * @return A mutable reference to the component.
              */
-            virtual Component& get(const EntityProperties::ID& entityID) = 0;
+            virtual Component& get(const uint64 row) = 0;
 
             /**
              * @brief Gets a component from the storage.
-             * @param entityID The ID of its entity.
+             * @param row The row of the component.
              * @return A const reference to the component.
              */
-            virtual const Component& get(const EntityProperties::ID& entityID) const = 0;
+            virtual const Component& get(const uint64 row) const = 0;
+
+            /**
+             * @brief Gets the number of components in the storage.
+             * @return The number of components.
+             */
+            virtual uint64 getSize() const noexcept = 0;
+
+            /**
+             * @brief Gets the tick at which each component was added.
+             * @return A pointer to the first component's tick.
+             */
+            const uint64* getAddedTicks() const noexcept { return addedTicks.data(); }
+            /**
+             * @brief Gets the tick at which each component was last handed out mutably.
+             * @return A pointer to the first component's tick.
+             */
+            uint64* getChangedTicks() noexcept { return changedTicks.data(); }
+            /**
+             * @brief Gets the tick at which each component was last handed out mutably.
+             * @return A pointer to the first component's tick.
+             */
+            const uint64* getChangedTicks() const noexcept { return changedTicks.data(); }
+
+            protected:
+            std::pmr::vector<uint64> addedTicks;    ///< The tick at which each component was added, row by row.
+            std::pmr::vector<uint64> changedTicks;  ///< The tick at which each component was last handed out mutably, row by row.
+
+            /**
+             * @brief Removes a row's ticks by swapping them with the last ones.
+             * @param row The row to remove.
+             */
+            void removeTicks(const uint64 row) noexcept {
+                addedTicks[row] = addedTicks.back();
+                addedTicks.pop_back();
+                changedTicks[row] = changedTicks.back();
+                changedTicks.pop_back();
+            }
         };
 
         /**
-         * @brief Packed array of components. Maps entity IDs to components.
+         * @brief Packed array of components of a single type. Rows are kept in sync with the entity list of the archetype that owns the storage.
          * @tparam ComponentType: The component type.
          */
         template <typename ComponentType>
         class ComponentStorage : public ComponentStorageInterface {
-            friend class ComponentStorageInterface;
-
             static_assert(std::is_base_of<Component, ComponentType>::value, "ComponentType must be a component.");
-            static_assert(std::is_copy_constructible<ComponentType>::value, "ComponentType must be copy constructible.");
+            static_assert(std::is_move_constructible<ComponentType>::value, "ComponentType must be move constructible.");
 
             public:
             /**
-             * @brief Default constructor.
+             * @brief Creates an empty storage.
+             * @param resource The memory resource to allocate the components and their ticks from.
              */
-            ComponentStorage() = default;
+            explicit ComponentStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : ComponentStorageInterface(resource), components(resource) {}
             /**
              * @brief Default destructor.
              */
             ~ComponentStorage() = default;
 
-            private:
             /**
-             * @brief Adds a component to the storage.
-             * @param entity The entity to which the component belongs.
-             * @param component The component to add.
+             * @brief Constructs a component in place at the back of the storage.
+             * @tparam Args... The component's constructor argument types.
+             * @param tick The tick at which the component is added.
+             * @param args The component's constructor arguments.
              */
-            void add(const EntityProperties::ID& entityID, const Component& component) noexcept override {
-                if (entityToIndex.find(entityID) != entityToIndex.end()) {
-                    return;
-                }
-                entityToIndex[entityID] = components.size();
-                components.push_back(dynamic_cast<const ComponentType&>(component));
+            template <typename... Args>
+            void emplace(const uint64 tick, Args&&... args) {
+                components.emplace_back(std::forward<Args>(args)...);
+                addedTicks.push_back(tick);
+                changedTicks.push_back(tick);
+            }
+
+            /**
+             * @brief Gets a component from the storage without going through the type-erased interface.
+             * @param row The row of the component.
+             * @return A mutable reference to the component.
+             */
+            ComponentType& at(const uint64 row) noexcept { return components[row]; }
+            /**
+             * @brief Gets a component from the storage without going through the type-erased interface.
+             * @param row The row of the component.
+             * @return A const reference to the component.
+             */
+            const ComponentType& at(const uint64 row) const noexcept { return components[row]; }
+
+            /**
+             * @brief Gets the raw, contiguous component array.
+             * @return A pointer to the first component.
+             */
+            ComponentType* data() noexcept { return components.data(); }
+            /**
+             * @brief Gets the raw, contiguous component array.
+             * @return A pointer to the first component.
+             */
+            const ComponentType* data() const noexcept { return components.data(); }
+
+            /**
+             * @brief Creates a new, empty storage for the same component type, allocating from the same memory resource.
+             * @return The new storage.
+             */
+            Scope<ComponentStorageInterface> makeEmpty() const override {
+                return CreateScope<ComponentStorage<ComponentType>>(components.get_allocator().resource());
             }
 
             /**
-             * @brief Removes a component from the storage.
-             * @param entity The entity to which the component belongs.
+             * @brief Moves a component from another storage of the same type into the back of this one.
+             * @param other The storage to move the component from.
+             * @param row The row of the component in the other storage.
              */
-            void remove(const EntityProperties::ID& entityID) noexcept override {
-                if (entityToIndex.find(entityID) == entityToIndex.end()) {
-                    return;
-                }
-                const uint64 index = entityToIndex[entityID];
-                entityToIndex.erase(entityID);
-                if (index != components.size() - 1) {
-                    components.insert(components.begin() + index, components.back());
+            void moveFrom(ComponentStorageInterface& other, const uint64 row) override {
+                ComponentStorage<ComponentType>& source = static_cast<ComponentStorage<ComponentType>&>(other);
+                components.emplace_back(Move(source.components[row]));
+                addedTicks.push_back(source.addedTicks[row]);
+                changedTicks.push_back(source.changedTicks[row]);
+            }
+
+            /**
+             * @brief Removes a component from the storage by swapping it with the last one.
+             * @param row The row of the component to remove.
+             */
+            void remove(const uint64 row) noexcept override {
+                if (row != components.size() - 1) {
+                    // Components only need to be move constructible, so the last one is moved into the hole instead of assigned.
+                    std::destroy_at(&components[row]);
+                    std::construct_at(&components[row], Move(components.back()));
                 }
                 components.pop_back();
+                removeTicks(row);
+            }
+
+            /**
+             * @brief Reserves space for a number of components.
+             * @param capacity The number of components to reserve space for.
+             */
+            void reserve(const uint64 capacity) override {
+                components.reserve(capacity);
+                addedTicks.reserve(capacity);
+                changedTicks.reserve(capacity);
             }
 
             /**
              * @brief Gets a component from the storage.
-             * @param entity The entity to which the component belongs.
+             * @param row The row of the component.
              * @return A mutable reference to the component.
              */
-            Component& get(const EntityProperties::ID& entityID) override { return components.at(entityToIndex.at(entityID)); }
+            Component& get(const uint64 row) override { return components.at(row); }
 
             /**
              * @brief Gets a component from the storage.
-             * @param entity The entity to which the component belongs.
+             * @param row The row of the component.
              * @return A const reference to the component.
              */
-            const Component& get(const EntityProperties::ID& entityID) const override { return components.at(entityToIndex.at(entityID)); }
+            const Component& get(const uint64 row) const override { return components.at(row); }
+
+            /**
+             * @brief Gets the number of components in the storage.
+             * @return The number of components.
+             */
+            uint64 getSize() const noexcept override { return components.size(); }
 
             private:
-            UMap<EntityProperties::ID, uint64> entityToIndex;  ///< Maps entity IDs to component indices.
-            Vec<ComponentType> components;                     ///< Packed array of components.
+            std::pmr::vector<ComponentType> components;  ///< Packed array of components.
         };
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
@@ -19,7 +19,7 @@ namespace cobalt {
             other.version = 0;
         }
 
-        void Entity::kill() const noexcept {
+        void Entity::kill() noexcept {
             componentRegistry.removeAll(id);
             entityRegistry.remove(*this);
         }
@@ -34,5 +34,7 @@ namespace cobalt {
         const EntityProperties::ID Entity::getID() const { return id; }
 
         const EntityProperties::Version Entity::getVersion() const { return version; }
+
+        const EntityProperties::Handle Entity::getHandle() const { return EntityProperties::toHandle(id, version); }
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -102,8 +102,21 @@ namespace cobalt {
              * @return The references to the components.
              */
             template <typename... ComponentRefs>
+            Tuple<ComponentRefs...> getMany() {
+                static_assert((std::is_reference<ComponentRefs>::value && ...), "All component types must be reference types.");
+                return componentRegistry.getMany<ComponentRefs...>(id);
+            }
+            /**
+             * @brief Get a set of components from the entity.
+             * @tparam ComponentRefs... The component types. Must be const references, as a const entity (e.g. a query row) has not
+             * declared write access to them.
+             * @return The const references to the components.
+             */
+            template <typename... ComponentRefs>
             Tuple<ComponentRefs...> getMany() const {
                 static_assert((std::is_reference<ComponentRefs>::value && ...), "All component types must be reference types.");
+                static_assert((std::is_const<std::remove_reference_t<ComponentRefs>>::value && ...),
+                              "All component types must be const references on a const entity.");
                 return componentRegistry.getMany<ComponentRefs...>(id);
             }
             /**
@@ -119,19 +132,23 @@ namespace cobalt {
             }
             /**
              * @brief Get a component from the entity.
-             * @tparam ComponentRef The component type reference.
+             * @tparam ComponentRef The component type reference. Must be a const reference, as a const entity (e.g. a query row) has not
+             * declared write access to it.
              * @return A const reference to the component.
              */
             template <typename ComponentRef>
             ComponentRef get() const {
                 static_assert(std::is_reference<ComponentRef>::value, "Component type must be a reference type.");
+                static_assert(std::is_const<std::remove_reference_t<ComponentRef>>::value,
+                              "Component type must be a const reference on a const entity.");
                 return componentRegistry.get<ComponentRef>(id);
             }
 
             /**
-             * @brief Kill the entity. This will remove all of its components and invalidate it.
+             * @brief Kill the entity. This will remove all of its components and invalidate it. Systems holding a const entity (e.g. a
+             * query row) must kill it through Commands instead.
              */
-            void kill() const noexcept;
+            void kill() noexcept;
 
             /**
              * @brief Check if the entity is alive.
@@ -158,6 +175,12 @@ namespace cobalt {
              */
             const EntityProperties::Version getVersion() const;
 
+            /**
+             * @brief Get a generational handle to this entity. Unlike a reference, a handle can be checked for liveness once its slot is reused.
+             * @return This entity's handle.
+             */
+            const EntityProperties::Handle getHandle() const;
+
             private:
             const EntityProperties::ID id;         ///< This entity's ID.
             EntityProperties::Version version;     ///< This entity's version.
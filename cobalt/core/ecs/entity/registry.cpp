@@ -7,52 +7,111 @@
 
 #include "core/ecs/entity/registry.h"
 
-#include <iostream>
-
 #include "core/ecs/component/registry.h"
 #include "core/ecs/entity/entity.h"
 #include "core/pch.h"
 
 namespace cobalt {
     namespace core::ecs {
-        EntityRegistry::EntityRegistry(ComponentRegistry& componentRegistry) noexcept : componentRegistry(componentRegistry) {}
+        EntityRegistry::EntityRegistry(ComponentRegistry& componentRegistry) noexcept
+            : reserved(0), reserveMutex(), componentRegistry(componentRegistry) {}
 
         Entity& EntityRegistry::add() noexcept {
-            EntityProperties::ID id;
+            flush();
             if (freeIDs.empty()) {
-                id = EntityProperties::ID(entities.size());
+                const EntityProperties::ID id = EntityProperties::ID(entities.size());
+                versions.emplace_back(1);
+                return entities.emplace_back(id, versions[id], *this, componentRegistry);
+            }
+            const EntityProperties::ID id = freeIDs.back();
+            freeIDs.pop_back();
+            entities[id].version = versions[id];
+            return entities[id];
+        }
+
+        Vec<EntityProperties::ID> EntityRegistry::addBatch(const uint64 count) {
+            flush();
+            Vec<EntityProperties::ID> ids;
+            ids.reserve(count);
+            while (ids.size() < count && !freeIDs.empty()) {
+                const EntityProperties::ID id = freeIDs.back();
+                freeIDs.pop_back();
+                entities[id].version = versions[id];
+                ids.push_back(id);
+            }
+            versions.resize(entities.size() + count - ids.size(), 1);
+            while (ids.size() < count) {
+                const EntityProperties::ID id = EntityProperties::ID(entities.size());
+                entities.emplace_back(id, versions[id], *this, componentRegistry);
+                ids.push_back(id);
+            }
+            return ids;
+        }
+
+        EntityProperties::Handle EntityRegistry::reserve() noexcept {
+            std::lock_guard<std::mutex> lock(reserveMutex);
+            if (!freeIDs.empty()) {
+                const EntityProperties::ID id = freeIDs.back();
+                freeIDs.pop_back();
+                return EntityProperties::toHandle(id, versions[id]);
+            }
+            return EntityProperties::toHandle(EntityProperties::ID(entities.size() + reserved++), 1);
+        }
+
+        Entity& EntityRegistry::spawn(const EntityProperties::Handle handle) noexcept {
+            flush();
+            const EntityProperties::ID id = EntityProperties::getID(handle);
+            entities[id].version = EntityProperties::getVersion(handle);
+            return entities[id];
+        }
+
+        void EntityRegistry::flush() noexcept {
+            for (; reserved > 0; reserved--) {
+                const EntityProperties::ID id = EntityProperties::ID(entities.size());
                 versions.emplace_back(1);
-            } else {
-                id = freeIDs.front();
-                versions.at(id) = versions.at(id) == num::MAX_UINT64 ? 1 : versions.at(id) + 1;
-                freeIDs.pop();
+                entities.emplace_back(id, 0, *this, componentRegistry);
             }
-            entities.erase(id);
-            entities.emplace(std::piecewise_construct, std::forward_as_tuple(id),
-                             std::forward_as_tuple(id, versions.at(id), *this, componentRegistry));
-            return entities.at(id);
         }
 
         void EntityRegistry::remove(const Entity& entity) noexcept {
             if (!isAlive(entity)) {
                 return;
             }
-            entities.at(entity.getID()).version = 0;  // Easiest way to invalidate an entity.
-            freeIDs.push(entity.getID());
+            remove(entity.getID());
         }
 
         void EntityRegistry::remove(const EntityProperties::ID& entityID) noexcept {
-            if (entities.find(entityID) == entities.end()) {
+            if (entityID >= entities.size() || entities[entityID].version == 0) {
                 return;
             }
-            entities.at(entityID).version = 0;  // Easiest way to invalidate an entity.
-            freeIDs.push(entityID);
+            entities[entityID].version = 0;  // Easiest way to invalidate an entity.
+            versions[entityID] = versions[entityID] == num::MAX_UINT32 ? 1 : versions[entityID] + 1;
+            freeIDs.push_back(entityID);
         }
 
         const bool EntityRegistry::isAlive(const Entity& entity) const noexcept {
-            return entity.getVersion() != 0 && entities.find(entity.getID()) != entities.end() && entities.at(entity.getID()) == entity;
+            return entity.getVersion() != 0 && entity.getID() < entities.size() && entities[entity.getID()] == entity;
+        }
+
+        const bool EntityRegistry::isAlive(const EntityProperties::Handle handle) const noexcept {
+            const EntityProperties::ID id = EntityProperties::getID(handle);
+            const EntityProperties::Version version = EntityProperties::getVersion(handle);
+            return version != 0 && id < entities.size() && entities[id].version == version;
         }
 
         const uint64 EntityRegistry::getSize() const noexcept { return entities.size(); }
+
+        const Entity& EntityRegistry::get(const EntityProperties::ID& entityID) const noexcept { return entities[entityID]; }
+
+        Opt<Wrap<Entity>> EntityRegistry::get(const EntityProperties::Handle handle) noexcept {
+            if (!isAlive(handle)) {
+                return None;
+            }
+            return CreateWrap(entities[EntityProperties::getID(handle)]);
+        }
+
+        ComponentRegistry& EntityRegistry::getComponentRegistry() noexcept { return componentRegistry; }
+
+        const ComponentRegistry& EntityRegistry::getComponentRegistry() const noexcept { return componentRegistry; }
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
@@ -15,6 +15,8 @@ namespace cobalt {
 
         /**
          * @brief Stores all entities and exposes an interface to interact with them.
+         * Entities live in slots indexed by their ID, so lookups and liveness checks are plain array accesses. Freed slots are reused in LIFO order
+         * with a bumped version, which invalidates every handle to the previous occupant.
          */
         class EntityRegistry {
             friend class Entity;
@@ -57,6 +59,25 @@ namespace cobalt {
              * @return The new entity.
              */
             Entity& add() noexcept;
+            /**
+             * @brief Create a batch of new entities. Freed slots are reused first and the rest are appended in one go.
+             * @param count The number of entities to create.
+             * @return The new entities' IDs.
+             */
+            Vec<EntityProperties::ID> addBatch(const uint64 count);
+            /**
+             * @brief Reserve the slot of an entity to be spawned later, through spawn(handle), so its handle is known right away. Reserving
+             * is thread-safe, so systems running in parallel may reserve at the same time, but it must not overlap with any other change to
+             * the registry.
+             * @return The handle the entity will have. It is not alive until it is spawned.
+             */
+            EntityProperties::Handle reserve() noexcept;
+            /**
+             * @brief Spawn an entity into a slot reserved by reserve().
+             * @param handle The reserved handle.
+             * @return The new entity.
+             */
+            Entity& spawn(const EntityProperties::Handle handle) noexcept;
             /**
              * @brief Destroy an entity.
              * @param entity Entity to destroy.
@@ -69,49 +90,54 @@ namespace cobalt {
             void remove(const EntityProperties::ID& entityID) noexcept;
 
             /**
-             * @brief The number entities in the registry.
-             * @return The number of entities.
+             * @brief The number of entity slots in the registry, living or free.
+             * @return The number of entity slots.
              */
             const uint64 getSize() const noexcept;
 
             /**
-             * @brief Get a subset of all entities' components.
-             * @tparam ComponentRefs... The components to select.
-             * @return A vector of tuples of references to components.
-             */
-            template <typename... ComponentRefs>
-            const Vec<Tuple<ComponentRefs...>> getMany() const noexcept {
-                static_assert((std::is_reference<ComponentRefs>::value && ...), "All component types must be reference types.");
-                Vec<Tuple<ComponentRefs...>> components;
-                for (auto& entity : entities) {
-                    if (entity.second.has<RemoveConstRef<ComponentRefs>...>()) {
-                        components.push_back(entity.second.getMany<ComponentRefs...>());
-                    }
-                }
-                return components;
-            }
-            /**
-             * @brief Get a subset of all entities' components.
-             * @tparam ComponentTypes... The components to select for.
-             * @return A vector of tuples of references to components.
-             */
-            template <typename... ComponentTypes>
-            const Vec<Tuple<const Entity&, ComponentTypes...>> getWithEntity() const noexcept {
-                static_assert((std::is_reference<ComponentTypes>::value && ...), "All component types must be reference types.");
-                Vec<Tuple<const Entity&, ComponentTypes...>> components;
-                for (auto& entity : entities) {
-                    if (entity.second.has<RemoveConstRef<ComponentTypes>...>()) {
-                        components.push_back(std::tuple_cat(std::make_tuple(std::cref(entity.second)), entity.second.getMany<ComponentTypes...>()));
-                    }
-                }
-                return components;
-            }
+             * @brief Check if the entity a handle refers to is still alive.
+             * @param handle The entity handle.
+             * @return True if the entity is alive, false otherwise.
+             */
+            const bool isAlive(const EntityProperties::Handle handle) const noexcept;
+
+            /**
+             * @brief Get an entity by its ID. The entity's slot must exist.
+             * @param entityID The entity's ID.
+             * @return The entity.
+             */
+            const Entity& get(const EntityProperties::ID& entityID) const noexcept;
+            /**
+             * @brief Get the entity a handle refers to.
+             * @param handle The entity handle.
+             * @return The entity, or None if it has been destroyed since the handle was created.
+             */
+            Opt<Wrap<Entity>> get(const EntityProperties::Handle handle) noexcept;
+
+            /**
+             * @brief Get the component registry for this instance's entities.
+             * @return The component registry.
+             */
+            ComponentRegistry& getComponentRegistry() noexcept;
+            /**
+             * @brief Get the component registry for this instance's entities.
+             * @return The component registry.
+             */
+            const ComponentRegistry& getComponentRegistry() const noexcept;
 
             private:
-            UMap<EntityProperties::ID, Entity> entities;  ///< All living entities.
-            Vec<uint64> versions;                         ///< Entity versions.
-            Queue<EntityProperties::ID> freeIDs;          ///< Recently-freed IDs.
-            ComponentRegistry& componentRegistry;         ///< Component registry for this instance's entities.
+            Deque<Entity> entities;                   ///< Entity slots, indexed by ID. A deque keeps references stable as it grows.
+            Vec<EntityProperties::Version> versions;  ///< The version the next occupant of each slot will get.
+            Vec<EntityProperties::ID> freeIDs;        ///< Freed slots, reused last-in first-out.
+            uint64 reserved;                          ///< The number of slots reserved past the end that have not been created yet.
+            std::mutex reserveMutex;                  ///< Guards reservations.
+            ComponentRegistry& componentRegistry;     ///< Component registry for this instance's entities.
+
+            /**
+             * @brief Create the slots reserved past the end, empty until their entity is spawned, so no other entity can take them.
+             */
+            void flush() noexcept;
 
             /**
              * @brief Check if an entity is alive.
@@ -0,0 +1,183 @@
+/**
+ * @file channel.h
+ * @brief A typed event channel: a double-buffered, contiguous list of events of one type, sent by some systems and read by others.
+ * @author Tomás Marques
+ * @date 10-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/resource/resource.h"
+#include "core/memory/tracker.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief Walks the unread events of a channel: first the ones left from the previous frame, then the ones sent this frame.
+         * @tparam EventType The event type.
+         */
+        template <typename EventType>
+        class EventIterator {
+            public:
+            /**
+             * @brief Creates a new EventIterator.
+             * @param event The first event of the older range.
+             * @param end The end of the older range.
+             * @param next The first event of the newer range.
+             * @param nextEnd The end of the newer range.
+             */
+            EventIterator(const EventType* event, const EventType* end, const EventType* next, const EventType* nextEnd) noexcept
+                : event(event), end(end), next(next), nextEnd(nextEnd) {
+                seek();
+            }
+
+            /**
+             * @brief Gets the current event.
+             * @return The event.
+             */
+            const EventType& operator*() const noexcept { return *event; }
+            /**
+             * @brief Gets the current event.
+             * @return The event.
+             */
+            const EventType* operator->() const noexcept { return event; }
+            /**
+             * @brief Advances to the next event.
+             * @return Reference to this.
+             */
+            EventIterator& operator++() noexcept {
+                ++event;
+                seek();
+                return *this;
+            }
+            friend bool operator==(const EventIterator& a, const EventIterator& b) { return a.event == b.event; }
+            friend bool operator!=(const EventIterator& a, const EventIterator& b) { return !(a == b); }
+
+            private:
+            const EventType* event;    ///< The current event.
+            const EventType* end;      ///< The end of the current range.
+            const EventType* next;     ///< The first event of the newer range.
+            const EventType* nextEnd;  ///< The end of the newer range.
+
+            /**
+             * @brief Moves on to the newer range once the older one runs out.
+             */
+            void seek() noexcept {
+                if (event == end) {
+                    event = next;
+                    end = nextEnd;
+                    next = nextEnd;
+                }
+            }
+        };
+
+        /**
+         * @brief Events is the channel for one event type. Events are stored contiguously in two buffers: the one being filled this frame and
+         * the one filled last frame. The buffers are swapped every frame and the oldest one is cleared, so each event lives for two frames,
+         * long enough for every system that runs once a frame to see it no matter the order in which they run.
+         * Each event is stamped with the change tick of the system that sent it, so a reader only needs the tick at which it last ran to find
+         * the events it has not seen yet: any number of systems can read the same channel, each with its own cursor.
+         * Channels are registered with World::registerEvent and used through the EventWriter and EventReader system parameters.
+         * @tparam EventType The event type. Any movable type.
+         */
+        template <typename EventType>
+        class Events : public Resource {
+            public:
+            /**
+             * @brief Creates a new, empty channel.
+             */
+            Events() noexcept : buffers(), current(0) {}
+            /**
+             * @brief Default destructor.
+             */
+            ~Events() noexcept = default;
+
+            /**
+             * @brief Sends an event, constructing it in place.
+             * @tparam Args... The event constructor argument types.
+             * @param tick The change tick of the sender.
+             * @param args The event constructor arguments.
+             * @return The new event.
+             */
+            template <typename... Args>
+            EventType& emplace(uint64 tick, Args&&... args) {
+                Buffer& buffer = buffers[current];
+                if (!buffer.ticks.empty()) {
+                    tick = std::max(tick, buffer.ticks.back());
+                }
+                buffer.ticks.push_back(tick);
+                return buffer.events.emplace_back(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Gets the first event sent after a tick.
+             * @param lastRun The tick. Events stamped at or before it are skipped.
+             * @return Iterator to the first newer event.
+             */
+            EventIterator<EventType> begin(const uint64 lastRun) const noexcept {
+                const Buffer& older = buffers[current ^ 1];
+                const Buffer& newer = buffers[current];
+                const EventType* olderData = older.events.data();
+                const EventType* newerData = newer.events.data();
+                return EventIterator<EventType>(olderData + older.after(lastRun), olderData + older.events.size(), newerData + newer.after(lastRun),
+                                                newerData + newer.events.size());
+            }
+            /**
+             * @brief Gets the end of the channel.
+             * @return Iterator past the last event.
+             */
+            EventIterator<EventType> end() const noexcept {
+                const EventType* newerEnd = buffers[current].events.data() + buffers[current].events.size();
+                return EventIterator<EventType>(newerEnd, newerEnd, newerEnd, newerEnd);
+            }
+            /**
+             * @brief Counts the events sent after a tick.
+             * @param lastRun The tick. Events stamped at or before it are not counted.
+             * @return The number of newer events.
+             */
+            const uint64 count(const uint64 lastRun) const noexcept {
+                const Buffer& older = buffers[current ^ 1];
+                const Buffer& newer = buffers[current];
+                return older.events.size() - older.after(lastRun) + newer.events.size() - newer.after(lastRun);
+            }
+
+            /**
+             * @brief Swaps the buffers, dropping the events sent two frames ago. Called once a frame by the EventManager.
+             */
+            void update() noexcept {
+                current ^= 1;
+                buffers[current].events.clear();
+                buffers[current].ticks.clear();
+            }
+
+            private:
+            /**
+             * @brief One frame's events, with the tick each was sent at. Ticks never decrease along the buffer. Its memory is charged to
+             * the Events tag.
+             */
+            struct Buffer {
+                std::pmr::vector<EventType> events;  ///< The events, in the order they were sent.
+                std::pmr::vector<uint64> ticks;      ///< The change tick of each event's sender.
+
+                /**
+                 * @brief Creates an empty buffer.
+                 */
+                Buffer() noexcept
+                    : events(core::memory::MemoryTracker::getResource(core::memory::MemoryTag::Events)),
+                      ticks(core::memory::MemoryTracker::getResource(core::memory::MemoryTag::Events)) {}
+
+                /**
+                 * @brief Finds the first event sent after a tick.
+                 * @param lastRun The tick.
+                 * @return The index of the first event stamped after it.
+                 */
+                const uint64 after(const uint64 lastRun) const noexcept {
+                    return std::upper_bound(ticks.begin(), ticks.end(), lastRun) - ticks.begin();
+                }
+            };
+
+            Buffer buffers[2];  ///< The event buffers. One is filled this frame, the other holds last frame's events.
+            uint current;       ///< The buffer being filled this frame.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
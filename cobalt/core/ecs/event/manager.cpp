@@ -11,29 +11,49 @@
 namespace cobalt {
     namespace core::ecs {
         EventManager::EventManager(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager) noexcept
-            : entityRegistry(entityRegistry), resourceRegistry(resourceRegistry), systemManager(systemManager) {}
+            : eventQueue(CB_EVENT_QUEUE_CAPACITY), entityRegistry(entityRegistry), resourceRegistry(resourceRegistry), systemManager(systemManager) {}
 
         const Event& EventManager::registerEvent(const std::string& name, const std::string& description) noexcept {
             events.emplace(name, Event(name, description));
             return events.at(name);
         }
 
-        void EventManager::triggerEvent(const std::string& name) noexcept {
-            if (events.find(name) == events.end()) {
+        bool EventManager::triggerEvent(const std::string& name) noexcept {
+            const auto event = events.find(name);
+            if (event == events.end()) {
                 CB_CORE_WARN("Event {0} does not exist", name);
-                return;
+                return false;
             }
-            eventQueue.push(events.at(name));
+            return triggerEvent(event->second);
         }
 
+        bool EventManager::triggerEvent(const Event& event) noexcept { return eventQueue.push(&event); }
+
         void EventManager::clearQueue() noexcept {
-            while (!eventQueue.empty()) {
-                Event event = eventQueue.front();
-                if (hooks.find(event.getName()) != hooks.end()) {
-                    hooks.at(event.getName())->run();
+            eventQueue.drain([this](const Event* event) {
+                const auto eventHooks = hooks.find(event->getName());
+                if (eventHooks != hooks.end()) {
+                    for (Scope<SystemInterface>& hook : eventHooks->second) {
+                        CB_PROFILE_SCOPE(hook->getName(), "Hooks");
+                        hook->run();
+                    }
                 }
-                eventQueue.pop();
+            });
+        }
+
+        const EventQueueStats EventManager::getQueueStats() const noexcept {
+            return {eventQueue.getCapacity(), eventQueue.getDrops(), eventQueue.getHighWaterMark()};
+        }
+
+        void EventManager::updateChannels() noexcept {
+            for (const auto& [type, update] : channels) {
+                update(resourceRegistry);
             }
         }
+
+        void EventManager::nameHook(const std::string& eventName, const std::string& name) noexcept {
+            Vec<Scope<SystemInterface>>& eventHooks = hooks[eventName];
+            eventHooks.back()->setName(name.empty() ? eventName + " hook #" + std::to_string(eventHooks.size() - 1) : name);
+        }
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
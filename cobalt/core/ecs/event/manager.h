@@ -8,13 +8,29 @@
 
 #pragma once
 
+#include "core/ecs/event/channel.h"
 #include "core/ecs/event/event.h"
 #include "core/ecs/system/manager.h"
+#include "core/thread/queue.h"
+
+#ifndef CB_EVENT_QUEUE_CAPACITY
+#define CB_EVENT_QUEUE_CAPACITY 4096
+#endif
 
 namespace cobalt {
     namespace core::ecs {
+        /**
+         * @brief Backpressure statistics of the event queue.
+         */
+        struct EventQueueStats {
+            uint64 capacity;       ///< The maximum number of events waiting to be processed.
+            uint64 drops;          ///< The number of events dropped because the queue was full.
+            uint64 highWaterMark;  ///< The most events ever waiting at the start of a frame.
+        };
+
         /**
          * @brief The event manager is responsible for managing events and their associated systems.
+         * With CB_PROFILING defined, every hook's runs are recorded with the profiler under the hook's name, in the "Hooks" category.
          */
         class EventManager {
             public:
@@ -38,24 +54,59 @@ namespace cobalt {
              */
             const Event& registerEvent(const std::string& name, const std::string& description) noexcept;
             /**
-             * @brief Trigger an Event.
+             * @brief Register a typed event channel. Registering the same type twice has no effect.
+             * @tparam EventType The event type.
+             * @see EventWriter, EventReader
+             */
+            template <typename EventType>
+            void registerEvent() noexcept {
+                const ResourceProperties::Type type = Resource::getType<Events<EventType>>();
+                for (const auto& [registered, update] : channels) {
+                    if (registered == type) {
+                        return;
+                    }
+                }
+                resourceRegistry.add<Events<EventType>>();
+                channels.emplace_back(type, [](ResourceRegistry& registry) { registry.get<Events<EventType>&>().update(); });
+            }
+            /**
+             * @brief Trigger an Event. Safe to call from any thread, as long as no event is being registered at the same time.
              * @param name The event's name.
+             * @return True if the event was queued, false if it does not exist or the queue was full.
              */
-            void triggerEvent(const std::string& name) noexcept;
+            bool triggerEvent(const std::string& name) noexcept;
             /**
-             * @brief Process the Event queue.
+             * @brief Trigger an Event without looking it up by name. Safe to call from any thread.
+             * @param event The Event handle, as returned by registerEvent.
+             * @return True if the event was queued, false if the queue was full.
+             */
+            bool triggerEvent(const Event& event) noexcept;
+            /**
+             * @brief Process the events triggered before the call, running their hooks. Events triggered while processing are left for the
+             * next call. Only the thread that updates the world may call this.
              */
             void clearQueue() noexcept;
+            /**
+             * @brief Get the event queue's backpressure statistics.
+             * @return The statistics.
+             */
+            const EventQueueStats getQueueStats() const noexcept;
+            /**
+             * @brief Swap the buffers of every typed event channel, dropping the events sent two frames ago.
+             */
+            void updateChannels() noexcept;
 
             /**
              * @brief Hook a system to an Event.
              * @tparam SystemType The system type.
              * @param eventName The Event to hook into.
+             * @param name The name to profile the hook under, or empty to name it after the Event and its position among its hooks.
              */
             template <typename SystemType>
-            void addHook(const std::string& eventName) noexcept {
+            void addHook(const std::string& eventName, const std::string& name = "") noexcept {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
-                hooks.emplace(eventName, Move(CreateScope<SystemType>(entityRegistry, resourceRegistry, systemManager, *this)));
+                hooks[eventName].push_back(CreateScope<SystemType>(entityRegistry, resourceRegistry, systemManager, *this));
+                nameHook(eventName, name);
             }
             /**
              * @brief Hook a system to an event.
@@ -63,23 +114,33 @@ namespace cobalt {
              * @tparam Func The lambda function type.
              * @param eventName The Event to hook into.
              * @param func The lambda function.
+             * @param name The name to profile the hook under, or empty to name it after the Event and its position among its hooks.
              * @see SystemParameter
              * @see Query, ReadRequest, WriteRequest, Commands
              */
             template <typename... Params, typename Func>
-            void addHook(const std::string& eventName, Func func) noexcept {
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addHook(const std::string& eventName, Func func, const std::string& name = "") noexcept {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
-                hooks.emplace(eventName,
-                              Move(CreateScope<LambdaSystem<Func, Params...>>(func, entityRegistry, resourceRegistry, systemManager, *this)));
+                hooks[eventName].push_back(CreateScope<LambdaSystem<Func, Params...>>(func, entityRegistry, resourceRegistry, systemManager, *this));
+                nameHook(eventName, name);
             }
 
             private:
-            UMap<std::string, Scope<SystemInterface>> hooks;  ///< All event hooks.
-            UMap<std::string, Event> events;                  ///< All registered events.
-            Queue<Event> eventQueue;                          ///< The event queue.
-            EntityRegistry& entityRegistry;                   ///< The entity registry to operate on.
-            ResourceRegistry& resourceRegistry;               ///< The resource registry to operate on.
-            SystemManager& systemManager;                     ///< The system manager to operate on.
+            UMap<std::string, Vec<Scope<SystemInterface>>> hooks;                       ///< All event hooks, by event name.
+            UMap<std::string, Event> events;                                            ///< All registered events.
+            core::thread::MPSCQueue<const Event*> eventQueue;                           ///< The triggered events, pushed from any thread.
+            Vec<Pair<ResourceProperties::Type, void (*)(ResourceRegistry&)>> channels;  ///< The typed channels and how to update each.
+            EntityRegistry& entityRegistry;                                             ///< The entity registry to operate on.
+            ResourceRegistry& resourceRegistry;                                         ///< The resource registry to operate on.
+            SystemManager& systemManager;                                               ///< The system manager to operate on.
+
+            /**
+             * @brief Names the last hook added to an Event.
+             * @param eventName The Event.
+             * @param name The name of the hook, or empty to name it after the Event and its position among its hooks.
+             */
+            void nameHook(const std::string& eventName, const std::string& name) noexcept;
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
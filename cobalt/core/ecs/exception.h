@@ -40,6 +40,32 @@ namespace cobalt {
             ResourceNotFoundException() : CoreException<ThrowerType>("Resource not found: " + Resource::getTypeName<ComponentType>()) {}
         };
 
+        /**
+         * @brief Exception thrown when a custom schedule is requested but not found.
+         */
+        template <typename ThrowerType>
+        class ScheduleNotFoundException : public CoreException<ThrowerType> {
+            public:
+            /**
+             * @brief Create a ScheduleNotFoundException.
+             * @param scheduleName The name of the schedule that was not found.
+             */
+            ScheduleNotFoundException(const std::string& scheduleName) : CoreException<ThrowerType>("Schedule not found: " + scheduleName) {}
+        };
+
+        /**
+         * @brief Exception thrown when a custom schedule is added under a name that is already taken.
+         */
+        template <typename ThrowerType>
+        class DuplicateScheduleException : public CoreException<ThrowerType> {
+            public:
+            /**
+             * @brief Create a DuplicateScheduleException.
+             * @param scheduleName The name of the schedule.
+             */
+            DuplicateScheduleException(const std::string& scheduleName) : CoreException<ThrowerType>("Schedule already exists: " + scheduleName) {}
+        };
+
         /**
          * @brief Exception thrown when a plugin is requested but not found.
          */
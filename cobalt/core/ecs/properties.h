@@ -7,7 +7,11 @@
 
 #pragma once
 
-#include "core/pch.h"
+#include "core/ecs/signature.h"
+
+#ifndef CB_ECS_MAX_COMPONENTS
+#define CB_ECS_MAX_COMPONENTS 4096
+#endif
 
 namespace cobalt {
     namespace core::ecs {
@@ -15,22 +19,44 @@ namespace cobalt {
          * @brief Properties of an entity.
          */
         namespace EntityProperties {
-            using ID = uint64;       ///< Entity ID - unique between all entities.
-            using Version = uint64;  ///< Entity version - incremented every time an entity with this ID is destroyed.
+            using ID = uint;        ///< Entity ID - unique between all living entities. Doubles as the entity's slot index.
+            using Version = uint;   ///< Entity version - incremented every time an entity with this ID is destroyed.
+            using Handle = uint64;  ///< Entity handle - the ID in the low 32 bits and the version in the high 32 bits.
+
+            /**
+             * @brief Pack an entity ID and version into a handle.
+             * @param id The entity's ID.
+             * @param version The entity's version.
+             * @return The handle.
+             */
+            static inline constexpr Handle toHandle(const ID id, const Version version) noexcept { return (Handle(version) << 32) | Handle(id); }
+            /**
+             * @brief Get the entity ID out of a handle.
+             * @param handle The handle.
+             * @return The entity's ID.
+             */
+            static inline constexpr ID getID(const Handle handle) noexcept { return ID(handle & num::MAX_UINT32); }
+            /**
+             * @brief Get the entity version out of a handle.
+             * @param handle The handle.
+             * @return The entity's version.
+             */
+            static inline constexpr Version getVersion(const Handle handle) noexcept { return Version(handle >> 32); }
         };  // namespace EntityProperties
 
         /**
          * @brief Properties of a component.
          */
         namespace ComponentProperties {
-            using Type = uint64;  ///< Component type - unique between different component types.
+            using Type = uint64;               ///< Component type - unique between different component types, dense from 0.
+            using Signature = ecs::Signature;  ///< Component signature - the set of component types an entity owns.
         };  // namespace ComponentProperties
 
         /**
          * @brief Properties of a resource.
          */
         namespace ResourceProperties {
-            using Type = uint64;  ///< Resource type - unique between different resource types.
+            using Type = uint64;  ///< Resource type - unique between different resource types, dense from 0.
         };  // namespace ResourceProperties
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+ * @file arena.cpp
+ * @brief A frame arena resource for transient allocations that only need to live until the end of the frame.
+ * @author Tomás Marques
+ * @date 12-09-2024
+ */
+
+#include "core/ecs/resource/arena.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        FrameArena::FrameArena(const size_t blockSize) noexcept
+            : id(nextID.fetch_add(1, std::memory_order_relaxed)), blockSize(blockSize), mutex(), arenas() {}
+
+        void FrameArena::reset() noexcept {
+            for (auto& [owner, subArena] : arenas) {
+                subArena->arena.reset();
+            }
+        }
+
+        const size_t FrameArena::getSize() const noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t size = 0;
+            for (const auto& [owner, subArena] : arenas) {
+                size += subArena->arena.getSize();
+            }
+            return size;
+        }
+
+        FrameArena::SubArena& FrameArena::getLocal() const {
+            static thread_local Pair<uint64, SubArena*> cached = {num::MAX_UINT64, nullptr};
+            if (cached.first == id) {
+                return *cached.second;
+            }
+            const std::thread::id thread = std::this_thread::get_id();
+            std::lock_guard<std::mutex> lock(mutex);
+            SubArena* local = nullptr;
+            for (auto& [owner, subArena] : arenas) {
+                if (owner == thread) {
+                    local = subArena.get();
+                    break;
+                }
+            }
+            if (!local) {
+                arenas.emplace_back(thread, CreateScope<SubArena>(blockSize));
+                local = arenas.back().second.get();
+            }
+            cached = {id, local};
+            return *local;
+        }
+    }  // namespace core::ecs
+}  // namespace cobalt
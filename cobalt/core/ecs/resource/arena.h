@@ -0,0 +1,117 @@
+/**
+ * @file arena.h
+ * @brief A frame arena resource for transient allocations that only need to live until the end of the frame.
+ * @author Tomás Marques
+ * @date 12-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/resource/resource.h"
+#include "core/memory/arena.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief The FrameArena hands out memory that lives until the end of the frame, at the cost of a pointer bump. Nothing is freed
+         * individually: the application resets the whole arena once the frame is done, keeping its memory for the next one.
+         * Each thread allocates from its own sub-arena, so systems running in parallel can all share the arena through a ReadRequest
+         * without contending on it. Every world owns one.
+         * Example:
+         *
+         *          std::pmr::vector<Entity*> visible(&arena->getMemoryResource());
+         *
+         */
+        class FrameArena : public Resource {
+            public:
+            static inline constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;  ///< The initial size of each thread's sub-arena.
+
+            /**
+             * @brief Creates a new FrameArena.
+             * @param blockSize The initial size of each thread's sub-arena, in bytes.
+             */
+            explicit FrameArena(const size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+            /**
+             * @brief Default destructor.
+             */
+            ~FrameArena() noexcept = default;
+
+            /**
+             * @brief Grabs memory from the calling thread's sub-arena. Safe to call from any thread.
+             * @param size The number of bytes to grab.
+             * @param alignment The alignment of the memory. Must be a power of two.
+             * @return The memory. Valid until the arena is reset.
+             */
+            void* grab(const size_t size, const size_t alignment = alignof(std::max_align_t)) const { return getLocal().arena.grab(size, alignment); }
+            /**
+             * @brief Creates an object in the calling thread's sub-arena. Safe to call from any thread.
+             * @tparam Type The object type. Must be trivially destructible, since the arena never destroys it.
+             * @tparam Args... The object's constructor argument types.
+             * @param args The object's constructor arguments.
+             * @return The object. Valid until the arena is reset.
+             */
+            template <typename Type, typename... Args>
+            Type& create(Args&&... args) const {
+                static_assert(std::is_trivially_destructible<Type>::value, "Type must be trivially destructible.");
+                return *new (grab(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...);
+            }
+            /**
+             * @brief Creates an array in the calling thread's sub-arena. Safe to call from any thread.
+             * @tparam Type The element type. Must be trivially destructible, since the arena never destroys it.
+             * @param count The number of elements.
+             * @return The array, with every element value-initialized. Valid until the arena is reset.
+             */
+            template <typename Type>
+            std::span<Type> createArray(const size_t count) const {
+                static_assert(std::is_trivially_destructible<Type>::value, "Type must be trivially destructible.");
+                Type* data = static_cast<Type*>(grab(sizeof(Type) * count, alignof(Type)));
+                std::uninitialized_value_construct_n(data, count);
+                return std::span<Type>(data, count);
+            }
+            /**
+             * @brief Gets a memory resource over the calling thread's sub-arena, for std::pmr containers. Only use it on the calling thread.
+             * @return The memory resource.
+             */
+            std::pmr::memory_resource& getMemoryResource() const { return getLocal().resource; }
+
+            /**
+             * @brief Releases everything allocated this frame, keeping the memory around for the next one. Must not run alongside any system.
+             */
+            void reset() noexcept;
+            /**
+             * @brief Get the number of bytes allocated since the last reset, over every thread.
+             * @return The number of bytes.
+             */
+            const size_t getSize() const noexcept;
+
+            private:
+            /**
+             * @brief One thread's share of the arena.
+             */
+            struct SubArena {
+                /**
+                 * @brief Creates a new SubArena.
+                 * @param blockSize The initial size of the arena.
+                 */
+                explicit SubArena(const size_t blockSize) : arena(blockSize, core::memory::MemoryTag::ECS), resource(arena) {}
+
+                core::memory::ArenaAllocator arena;    ///< The thread's arena.
+                core::memory::ArenaResource resource;  ///< Adapts the arena for std::pmr containers.
+            };
+
+            static inline std::atomic<uint64> nextID = 0;  ///< Tells arenas apart in the per-thread cache, even if one reuses another's address.
+
+            uint64 id;                                                   ///< This arena's unique ID.
+            size_t blockSize;                                            ///< The initial size of each thread's sub-arena.
+            mutable std::mutex mutex;                                    ///< Guards the list of sub-arenas.
+            mutable Vec<Pair<std::thread::id, Scope<SubArena>>> arenas;  ///< Each thread's sub-arena.
+
+            /**
+             * @brief Gets the calling thread's sub-arena, creating it if needed. Each thread caches the last sub-arena it used, so this
+             * only locks when a thread moves on to another FrameArena.
+             * @return The sub-arena.
+             */
+            SubArena& getLocal() const;
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
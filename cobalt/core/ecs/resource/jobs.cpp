@@ -0,0 +1,24 @@
+/**
+ * @file jobs.cpp
+ * @brief A job system resource for splitting work across the world's worker threads.
+ * @author Tomás Marques
+ * @date 04-09-2024
+ */
+
+#include "core/ecs/resource/jobs.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        JobSystem::JobSystem(core::thread::ThreadPool& threadPool) noexcept : threadPool(threadPool) {}
+
+        void JobSystem::wait(const Counter& counter) {
+            while (counter.load(std::memory_order_acquire) > 0) {
+                if (!threadPool.help()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        const uint JobSystem::getConcurrency() const noexcept { return threadPool.getThreadCount() + 1; }
+    }  // namespace core::ecs
+}  // namespace cobalt
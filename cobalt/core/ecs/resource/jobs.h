@@ -0,0 +1,83 @@
+/**
+ * @file jobs.h
+ * @brief A job system resource for splitting work across the world's worker threads.
+ * @author Tomás Marques
+ * @date 04-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/resource/resource.h"
+#include "core/thread/pool.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief The JobSystem lets systems and other subsystems break heavy work into jobs that run on the world's worker threads. Jobs are
+         * tracked by a counter, and waiting on it runs pending jobs on the waiting thread, so it is safe to wait from inside another job.
+         * Every world owns one, sharing its workers with the system scheduler.
+         */
+        class JobSystem : public Resource {
+            public:
+            using Counter = std::atomic<uint64>;  ///< Tracks the number of unfinished jobs in a group.
+
+            /**
+             * @brief Creates a new JobSystem.
+             * @param threadPool The worker threads to run jobs on.
+             */
+            explicit JobSystem(core::thread::ThreadPool& threadPool) noexcept;
+            /**
+             * @brief Default destructor.
+             */
+            ~JobSystem() noexcept = default;
+
+            /**
+             * @brief Queues a job.
+             * @tparam Job The job type. Must be copyable and invocable with no arguments.
+             * @param counter The counter of the job's group. Incremented now, decremented once the job finishes.
+             * @param job The job.
+             */
+            template <typename Job>
+            void submit(Counter& counter, Job&& job) {
+                counter.fetch_add(1, std::memory_order_relaxed);
+                threadPool.submit([&counter, job = std::forward<Job>(job)]() mutable {
+                    job();
+                    counter.fetch_sub(1, std::memory_order_release);
+                });
+            }
+            /**
+             * @brief Blocks until every job in a group has finished, running pending jobs in the meantime.
+             * @param counter The counter of the group.
+             */
+            void wait(const Counter& counter);
+
+            /**
+             * @brief Splits a range into chunks and runs them in parallel. Returns once every chunk has finished.
+             * @tparam Func The chunk function type. Must be invocable with the first and one past the last index of a chunk.
+             * @param count The size of the range.
+             * @param grainSize The maximum size of a chunk.
+             * @param func The chunk function.
+             */
+            template <typename Func>
+            void parallelFor(const uint64 count, const uint64 grainSize, Func&& func) {
+                static_assert(std::is_invocable<Func, uint64, uint64>::value, "Func must be invocable with the bounds of a chunk.");
+                Counter counter = 0;
+                const uint64 grain = std::max<uint64>(grainSize, 1);
+                for (uint64 begin = 0; begin < count; begin += grain) {
+                    const uint64 end = std::min(begin + grain, count);
+                    submit(counter, [&func, begin, end]() { func(begin, end); });
+                }
+                wait(counter);
+            }
+
+            /**
+             * @brief Get the number of threads that can run jobs at the same time, counting the one that waits on them.
+             * @return The number of threads.
+             */
+            const uint getConcurrency() const noexcept;
+
+            private:
+            core::thread::ThreadPool& threadPool;  ///< The worker threads to run jobs on.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
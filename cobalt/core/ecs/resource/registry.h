@@ -12,16 +12,28 @@
 
 namespace cobalt {
     namespace core::ecs {
+        /**
+         * @brief A resource lookup cached by whoever gets the same resource over and over, like a system parameter. It is only looked up
+         * again once a resource has been added to the registry since, which may have replaced the cached one.
+         * @tparam ResourceType The resource type.
+         */
+        template <typename ResourceType>
+        struct ResourceSlot {
+            ResourceType* resource = nullptr;  ///< The cached resource.
+            uint64 generation = 0;             ///< The registry generation the resource was cached at, or 0 if it never was.
+        };
+
         /**
          * @brief Stores and manages all the resources in the ECS.
-         * Resources are globally unique and accessible by systems.
+         * Resources are globally unique and accessible by systems. They live in a flat table indexed by resource type, so getting one is a
+         * bounds check and a load. Each resource also keeps the tick at which it was last changed, for run conditions to check.
          */
         class ResourceRegistry {
             public:
             /**
              * @brief Default constructor.
              */
-            ResourceRegistry() noexcept = default;
+            ResourceRegistry() noexcept : resources(), changeTicks(), generation(1) {}
             /**
              * @brief Default destructor.
              */
@@ -35,9 +47,8 @@ namespace cobalt {
             void add() noexcept {
                 Resource::validate<ResourceType>();
                 static_assert(std::is_default_constructible<ResourceType>::value, "Resource must be default constructible.");
-                const auto type = Resource::getType<ResourceType>();
-                resources.erase(type);
-                resources.emplace(type, Move(CreateScope<ResourceType>()));
+                slot(Resource::getType<ResourceType>()) = CreateScope<ResourceType>();
+                generation++;
             }
             /**
              * @brief Adds a resource to the registry.
@@ -49,9 +60,8 @@ namespace cobalt {
             void add(Args&&... args) noexcept {
                 Resource::validate<ResourceType>();
                 static_assert(std::is_constructible<ResourceType, Args...>::value, "Resource must be constructible with the given arguments.");
-                const auto type = Resource::getType<ResourceType>();
-                resources.erase(type);
-                resources.emplace(type, Move(CreateScope<ResourceType>(std::forward<Args>(args)...)));
+                slot(Resource::getType<ResourceType>()) = CreateScope<ResourceType>(std::forward<Args>(args)...);
+                generation++;
             }
 
             /**
@@ -61,11 +71,12 @@ namespace cobalt {
              */
             template <typename ResourceRef>
             ResourceRef get() {
-                try {
-                    return *dynamic_cast<RemoveConstRef<ResourceRef>*>(resources.at(Resource::getType<RemoveConstRef<ResourceRef>>()).get());
-                } catch (const std::out_of_range& e) {
-                    throw ResourceNotFoundException<RemoveConstRef<ResourceRef>, ResourceRegistry>();
+                using ResourceType = RemoveConstRef<ResourceRef>;
+                const ResourceProperties::Type type = Resource::getType<ResourceType>();
+                if (type >= resources.size() || !resources[type]) {
+                    throw ResourceNotFoundException<ResourceType, ResourceRegistry>();
                 }
+                return *static_cast<ResourceType*>(resources[type].get());
             }
             /**
              * @brief Gets a resource from the registry.
@@ -74,15 +85,70 @@ namespace cobalt {
              */
             template <typename ResourceRef>
             ResourceRef get() const {
-                try {
-                    return *dynamic_cast<RemoveConstRef<ResourceRef>*>(resources.at(Resource::getType<RemoveConstRef<ResourceRef>>()).get());
-                } catch (const std::out_of_range& e) {
-                    throw ResourceNotFoundException<RemoveConstRef<ResourceRef>, ResourceRegistry>();
+                using ResourceType = RemoveConstRef<ResourceRef>;
+                const ResourceProperties::Type type = Resource::getType<ResourceType>();
+                if (type >= resources.size() || !resources[type]) {
+                    throw ResourceNotFoundException<ResourceType, ResourceRegistry>();
                 }
+                return *static_cast<ResourceType*>(resources[type].get());
+            }
+
+            /**
+             * @brief Gets a resource through a cached slot, only looking it up if a resource was added since the slot was filled.
+             * @tparam ResourceType The resource type, const-qualified for read-only access.
+             * @param cached The slot.
+             * @return A reference to the resource.
+             */
+            template <typename ResourceType>
+            ResourceType& get(ResourceSlot<ResourceType>& cached) {
+                if (cached.generation != generation) {
+                    cached.resource = &get<ResourceType&>();
+                    cached.generation = generation;
+                }
+                return *cached.resource;
+            }
+
+            /**
+             * @brief Checks if a resource is in the registry.
+             * @tparam ResourceType The resource type.
+             * @return True if the resource is in the registry, false otherwise.
+             */
+            template <typename ResourceType>
+            bool contains() const noexcept {
+                const ResourceProperties::Type type = Resource::getType<ResourceType>();
+                return type < resources.size() && resources[type];
             }
 
+            /**
+             * @brief Gets the tick at which a resource was last changed, to stamp a change on.
+             * @param type The resource type. Must be in the registry.
+             * @return The tick, or 0 if the resource never changed.
+             */
+            uint64& getChangeTick(const ResourceProperties::Type type) noexcept { return changeTicks[type]; }
+            /**
+             * @brief Gets the tick at which a resource was last changed.
+             * @param type The resource type.
+             * @return The tick, or 0 if the resource never changed or is not in the registry.
+             */
+            uint64 getChangeTick(const ResourceProperties::Type type) const noexcept { return type < changeTicks.size() ? changeTicks[type] : 0; }
+
             private:
-            UMap<ResourceProperties::Type, Scope<Resource>> resources;  ///< The resources in the registry.
+            Vec<Scope<Resource>> resources;  ///< The resources in the registry, indexed by resource type. Empty slots hold null.
+            Vec<uint64> changeTicks;         ///< The tick at which each resource was last changed, indexed by resource type.
+            uint64 generation;               ///< Counts the resources added, so cached slots know when to look again.
+
+            /**
+             * @brief Gets the slot of a resource type, growing the registry if needed.
+             * @param type The resource type.
+             * @return The slot.
+             */
+            Scope<Resource>& slot(const ResourceProperties::Type type) {
+                if (type >= resources.size()) {
+                    resources.resize(type + 1);
+                    changeTicks.resize(type + 1, 0);
+                }
+                return resources[type];
+            }
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -9,14 +9,18 @@
 
 namespace cobalt {
     namespace core::ecs {
-        const ResourceProperties::Type Resource::getType() const noexcept {
-            static const ResourceProperties::Type type = typeid(*this).hash_code();
-            return type;
-        }
+        const ResourceProperties::Type Resource::getType() const noexcept { return registerType(typeid(*this)); }
 
         const std::string& Resource::getTypeName() const noexcept {
             static const std::string typeName = demangle(typeid(*this).name());
             return typeName;
         }
+
+        const ResourceProperties::Type Resource::registerType(const std::type_index type) noexcept {
+            static std::mutex mutex;
+            static UMap<std::type_index, ResourceProperties::Type> types;
+            std::lock_guard<std::mutex> lock(mutex);
+            return types.try_emplace(type, types.size()).first->second;
+        }
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -66,18 +66,19 @@ namespace cobalt {
             Resource& operator=(Resource&& other) = default;
 
             /**
-             * @brief Gets the resource's type. This is a unique identifier, lazy-generated based on the resource class's name.
+             * @brief Gets the resource's type. This is a unique, dense identifier handed out the first time the resource class is seen.
              * @return The resource type identifier.
              */
             virtual const ResourceProperties::Type getType() const noexcept;
             /**
-             * @brief Gets the resource's type. This is a unique identifier, generated at compile time based on the resource class's name.
+             * @brief Gets the resource's type. This is a unique, dense identifier handed out the first time the resource class is seen, so
+             * types can index flat arrays. After the first call, it costs a single load.
              * @tparam ResourceType The resource type.
              * @return The resource type identifier.
              */
             template <typename ResourceType>
             static const ResourceProperties::Type getType() noexcept {
-                static const ResourceProperties::Type type = typeid(ResourceType).hash_code();
+                static const ResourceProperties::Type type = registerType(typeid(ResourceType));
                 return type;
             }
 
@@ -96,6 +97,14 @@ namespace cobalt {
                 static const std::string typeName = demangle(typeid(ResourceType).name());
                 return typeName;
             }
+
+            private:
+            /**
+             * @brief Hands out the next resource type identifier to a class, or returns the one it already has.
+             * @param type The resource class.
+             * @return The resource type identifier.
+             */
+            static const ResourceProperties::Type registerType(const std::type_index type) noexcept;
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
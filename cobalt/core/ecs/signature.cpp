@@ -0,0 +1,97 @@
+/**
+ * @file signature.cpp
+ * @brief A growable bit mask describing the set of component types an entity owns.
+ * @author Tomás Marques
+ * @date 08-09-2024
+ */
+
+#include "core/ecs/signature.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        Signature& Signature::set(const uint64 index) {
+            if (index < WORD_BITS) {
+                low |= uint64(1) << index;
+                return *this;
+            }
+            const uint64 word = index / WORD_BITS - 1;
+            if (word >= high.size()) {
+                high.resize(word + 1, 0);
+            }
+            high[word] |= uint64(1) << (index % WORD_BITS);
+            return *this;
+        }
+
+        Signature& Signature::reset(const uint64 index) noexcept {
+            if (index < WORD_BITS) {
+                low &= ~(uint64(1) << index);
+                return *this;
+            }
+            const uint64 word = index / WORD_BITS - 1;
+            if (word < high.size()) {
+                high[word] &= ~(uint64(1) << (index % WORD_BITS));
+                trim();
+            }
+            return *this;
+        }
+
+        Signature& Signature::flip(const uint64 index) { return test(index) ? reset(index) : set(index); }
+
+        Signature Signature::without(const Signature& other) const {
+            Signature result(*this);
+            result.low &= ~other.low;
+            for (uint64 i = 0; i < std::min(result.high.size(), other.high.size()); i++) {
+                result.high[i] &= ~other.high[i];
+            }
+            result.trim();
+            return result;
+        }
+
+        Signature Signature::operator&(const Signature& other) const {
+            Signature result;
+            result.low = low & other.low;
+            result.high.resize(std::min(high.size(), other.high.size()));
+            for (uint64 i = 0; i < result.high.size(); i++) {
+                result.high[i] = high[i] & other.high[i];
+            }
+            result.trim();
+            return result;
+        }
+
+        Signature Signature::operator|(const Signature& other) const {
+            Signature result(high.size() >= other.high.size() ? *this : other);
+            const Signature& smaller = high.size() >= other.high.size() ? other : *this;
+            result.low = low | other.low;
+            for (uint64 i = 0; i < smaller.high.size(); i++) {
+                result.high[i] |= smaller.high[i];
+            }
+            return result;
+        }
+
+        const uint64 Signature::hash() const noexcept {
+            uint64 hash = low;
+            for (const uint64 word : high) {
+                hash = (hash ^ (hash >> 32)) * 0x9E3779B97F4A7C15ull ^ word;
+            }
+            return (hash ^ (hash >> 32)) * 0x9E3779B97F4A7C15ull;
+        }
+
+        const bool Signature::containsHigh(const Signature& other) const noexcept {
+            if (other.high.size() > high.size()) {
+                return false;
+            }
+            for (uint64 i = 0; i < other.high.size(); i++) {
+                if ((high[i] & other.high[i]) != other.high[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void Signature::trim() noexcept {
+            while (!high.empty() && high.back() == 0) {
+                high.pop_back();
+            }
+        }
+    }  // namespace core::ecs
+}  // namespace cobalt
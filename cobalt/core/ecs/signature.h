@@ -0,0 +1,133 @@
+/**
+ * @file signature.h
+ * @brief A growable bit mask describing the set of component types an entity owns.
+ * @author Tomás Marques
+ * @date 08-09-2024
+ */
+
+#pragma once
+
+#include "core/pch.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief A growable bit mask. The first 64 bits live inline and any bits beyond them live in a vector of words, so signatures of up to
+         * 64 component types never allocate and compare with a single word operation.
+         * Trailing zero words are always trimmed, so equal masks are stored identically.
+         */
+        class Signature {
+            public:
+            /**
+             * @brief Creates an empty signature.
+             */
+            Signature() noexcept : low(0), high() {}
+            /**
+             * @brief Default destructor.
+             */
+            ~Signature() noexcept = default;
+
+            /**
+             * @brief Set a bit.
+             * @param index The bit.
+             * @return Reference to this.
+             */
+            Signature& set(const uint64 index);
+            /**
+             * @brief Clear a bit.
+             * @param index The bit.
+             * @return Reference to this.
+             */
+            Signature& reset(const uint64 index) noexcept;
+            /**
+             * @brief Toggle a bit.
+             * @param index The bit.
+             * @return Reference to this.
+             */
+            Signature& flip(const uint64 index);
+
+            /**
+             * @brief Test a bit.
+             * @param index The bit.
+             * @return True if the bit is set, false otherwise.
+             */
+            const bool test(const uint64 index) const noexcept {
+                if (index < WORD_BITS) {
+                    return (low >> index) & 1;
+                }
+                const uint64 word = index / WORD_BITS - 1;
+                return word < high.size() && ((high[word] >> (index % WORD_BITS)) & 1);
+            }
+            /**
+             * @brief Check if every bit set in another signature is also set in this one.
+             * @param other The other signature.
+             * @return True if this signature contains the other, false otherwise.
+             */
+            const bool contains(const Signature& other) const noexcept {
+                return (low & other.low) == other.low && (other.high.empty() || containsHigh(other));
+            }
+            /**
+             * @brief Check if any bit is set.
+             * @return True if any bit is set, false otherwise.
+             */
+            const bool any() const noexcept { return low != 0 || !high.empty(); }
+            /**
+             * @brief Get the number of bits the signature currently covers. Bits at or past this are all clear.
+             * @return The number of bits.
+             */
+            const uint64 size() const noexcept { return WORD_BITS * (1 + high.size()); }
+
+            /**
+             * @brief Get the bits set in this signature but not in another.
+             * @param other The other signature.
+             * @return The difference.
+             */
+            Signature without(const Signature& other) const;
+            /**
+             * @brief Get the bits set in both signatures.
+             * @param other The other signature.
+             * @return The intersection.
+             */
+            Signature operator&(const Signature& other) const;
+            /**
+             * @brief Get the bits set in either signature.
+             * @param other The other signature.
+             * @return The union.
+             */
+            Signature operator|(const Signature& other) const;
+            friend bool operator==(const Signature& a, const Signature& b) noexcept { return a.low == b.low && a.high == b.high; }
+            friend bool operator!=(const Signature& a, const Signature& b) noexcept { return !(a == b); }
+
+            /**
+             * @brief Hash the signature.
+             * @return The hash.
+             */
+            const uint64 hash() const noexcept;
+
+            private:
+            static inline constexpr uint64 WORD_BITS = 64;  ///< The number of bits per word.
+
+            uint64 low;        ///< The first 64 bits.
+            Vec<uint64> high;  ///< The bits past the first 64, one word at a time. Never ends in a zero word.
+
+            /**
+             * @brief Check if every bit past the first 64 set in another signature is also set in this one.
+             * @param other The other signature.
+             * @return True if this signature contains the other's high bits, false otherwise.
+             */
+            const bool containsHigh(const Signature& other) const noexcept;
+            /**
+             * @brief Drop the trailing zero words.
+             */
+            void trim() noexcept;
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
+
+/**
+ * @brief Hashes a signature, so it can key unordered containers.
+ */
+template <>
+struct std::hash<cobalt::core::ecs::Signature> {
+    size_t operator()(const cobalt::core::ecs::Signature& signature) const noexcept { return signature.hash(); }
+};
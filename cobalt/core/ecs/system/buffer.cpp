@@ -0,0 +1,121 @@
+/**
+ * @file buffer.cpp
+ * @brief Command buffers record structural changes to the world so they can be applied later, in a batch, when no system is running.
+ * @author Tomás Marques
+ * @date 05-09-2024
+ */
+
+#include "core/ecs/system/buffer.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        InsertCommand::InsertCommand(const EntityProperties::Handle target, const bool spawn) noexcept
+            : target(target), spawn(spawn), first(nullptr), last(nullptr) {}
+
+        InsertCommand::~InsertCommand() noexcept {
+            for (ComponentCommand* component = first; component;) {
+                ComponentCommand* next = component->next;
+                component->~ComponentCommand();
+                component = next;
+            }
+        }
+
+        void InsertCommand::apply(EntityRegistry& entityRegistry) {
+            if (spawn) {
+                entityRegistry.spawn(target);
+            } else if (!entityRegistry.isAlive(target)) {
+                return;
+            }
+            const EntityProperties::ID entityID = EntityProperties::getID(target);
+            ComponentRegistry& componentRegistry = entityRegistry.getComponentRegistry();
+            ComponentProperties::Signature added;
+            for (ComponentCommand* component = first; component; component = component->next) {
+                const Opt<uint64> index = component->getIndex(componentRegistry);
+                if (index) {
+                    added.set(*index);
+                } else {
+                    CB_CORE_WARN("Component not registered");
+                }
+            }
+            auto [archetype, missing] = componentRegistry.extend(entityID, added);
+            const uint64 tick = componentRegistry.getTicks().thisRun;
+            for (ComponentCommand* component = first; component && missing.any(); component = component->next) {
+                const Opt<uint64> index = component->getIndex(componentRegistry);
+                if (index && missing.test(*index)) {
+                    component->emplace(archetype, *index, tick);
+                    missing.reset(*index);
+                }
+            }
+        }
+
+        void InsertCommand::push(ComponentCommand& component) noexcept {
+            if (last) {
+                last->next = &component;
+            } else {
+                first = &component;
+            }
+            last = &component;
+        }
+
+        KillCommand::KillCommand(const EntityProperties::Handle target) noexcept : target(target) {}
+
+        void KillCommand::apply(EntityRegistry& entityRegistry) {
+            const Opt<Wrap<Entity>> entity = entityRegistry.get(target);
+            if (entity) {
+                entity->get().kill();
+            }
+        }
+
+        CommandBuffer::CommandBuffer() noexcept : arena(4096), first(nullptr), last(nullptr) {}
+
+        CommandBuffer::~CommandBuffer() noexcept { clear(); }
+
+        void CommandBuffer::apply(EntityRegistry& entityRegistry) {
+            for (Command* command = first; command; command = command->next) {
+                command->apply(entityRegistry);
+            }
+            clear();
+        }
+
+        const bool CommandBuffer::isEmpty() const noexcept { return first == nullptr; }
+
+        void* CommandBuffer::grab(const size_t size, const size_t alignment) {
+            return arena.grab(size, alignment);
+        }
+
+        void CommandBuffer::clear() noexcept {
+            for (Command* command = first; command;) {
+                Command* next = command->next;
+                command->~Command();
+                command = next;
+            }
+            first = nullptr;
+            last = nullptr;
+            arena.reset();
+        }
+
+        uint64 CommandSlot::next() noexcept {
+            static std::atomic<uint64> count = 0;
+            return count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        CommandQueue::CommandQueue(EntityRegistry& entityRegistry) noexcept : entityRegistry(entityRegistry), mutex(), buffers() {}
+
+        CommandBuffer& CommandQueue::getBuffer(CommandSlot& slot) {
+            // A system only ever runs on one thread at a time, so its own slot needs no lock.
+            if (!slot.buffer) {
+                std::lock_guard<std::mutex> lock(mutex);
+                const auto position = std::upper_bound(buffers.begin(), buffers.end(), slot.order,
+                                                       [](const uint64 order, const auto& buffer) { return order < buffer.first; });
+                slot.buffer = buffers.emplace(position, slot.order, CreateScope<CommandBuffer>())->second.get();
+            }
+            return *slot.buffer;
+        }
+
+        void CommandQueue::apply() {
+            for (auto& [order, buffer] : buffers) {
+                buffer->apply(entityRegistry);
+            }
+        }
+    }  // namespace core::ecs
+}  // namespace cobalt
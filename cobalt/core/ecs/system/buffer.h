@@ -0,0 +1,348 @@
+/**
+ * @file buffer.h
+ * @brief Command buffers record structural changes to the world so they can be applied later, in a batch, when no system is running.
+ * @author Tomás Marques
+ * @date 05-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/entity/registry.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief A deferred change to the world. Commands live in a CommandBuffer's arena and are chained in the order they were recorded.
+         */
+        class Command {
+            public:
+            /**
+             * @brief Default destructor.
+             */
+            virtual ~Command() noexcept = default;
+
+            /**
+             * @brief Applies the change to the world.
+             * @param entityRegistry The EntityRegistry to apply the change to.
+             */
+            virtual void apply(EntityRegistry& entityRegistry) = 0;
+
+            Command* next = nullptr;  ///< The next recorded command.
+        };
+
+        /**
+         * @brief A component waiting to be added to an entity by an InsertCommand.
+         */
+        class ComponentCommand {
+            public:
+            /**
+             * @brief Default destructor.
+             */
+            virtual ~ComponentCommand() noexcept = default;
+
+            /**
+             * @brief Gets the component's index into the signature mask.
+             * @param componentRegistry The ComponentRegistry the component is registered in.
+             * @return The component's index, or None if it is not registered.
+             */
+            virtual Opt<uint64> getIndex(const ComponentRegistry& componentRegistry) const noexcept = 0;
+            /**
+             * @brief Moves the component into the back of its column.
+             * @param archetype The table the entity was moved to.
+             * @param index The component's index into the signature mask.
+             * @param tick The tick at which the component is added.
+             */
+            virtual void emplace(Archetype& archetype, const uint64 index, const uint64 tick) = 0;
+
+            ComponentCommand* next = nullptr;  ///< The next component to add to the same entity.
+        };
+
+        /**
+         * @brief A component of a specific type waiting to be added to an entity.
+         * @tparam ComponentType The component type.
+         */
+        template <typename ComponentType>
+        class ComponentValue : public ComponentCommand {
+            public:
+            /**
+             * @brief Creates the component to be added.
+             * @tparam Args... The component's constructor argument types.
+             * @param args The component's constructor arguments.
+             */
+            template <typename... Args>
+            explicit ComponentValue(Args&&... args) : component(std::forward<Args>(args)...) {}
+
+            /**
+             * @brief Gets the component's index into the signature mask.
+             * @param componentRegistry The ComponentRegistry the component is registered in.
+             * @return The component's index, or None if it is not registered.
+             */
+            Opt<uint64> getIndex(const ComponentRegistry& componentRegistry) const noexcept override {
+                return componentRegistry.findIndex<ComponentType>();
+            }
+            /**
+             * @brief Moves the component into the back of its column.
+             * @param archetype The table the entity was moved to.
+             * @param index The component's index into the signature mask.
+             * @param tick The tick at which the component is added.
+             */
+            void emplace(Archetype& archetype, const uint64 index, const uint64 tick) override {
+                archetype.template getColumn<ComponentType>(index).emplace(tick, Move(component));
+            }
+
+            private:
+            ComponentType component;  ///< The component to add.
+        };
+
+        /**
+         * @brief Adds a set of components to an entity, spawning it first if needed. Every component is added with a single move between tables.
+         */
+        class InsertCommand : public Command {
+            public:
+            /**
+             * @brief Creates a new InsertCommand.
+             * @param target The entity to add the components to.
+             * @param spawn Whether to spawn the entity first, into the slot the target was reserved with.
+             */
+            InsertCommand(const EntityProperties::Handle target, const bool spawn) noexcept;
+            /**
+             * @brief Destroys the components that are still waiting to be added.
+             */
+            ~InsertCommand() noexcept;
+
+            /**
+             * @brief Adds the components to the target entity. Components the entity already has are ignored, as are repeated ones.
+             * @param entityRegistry The EntityRegistry to apply the change to.
+             */
+            void apply(EntityRegistry& entityRegistry) override;
+
+            /**
+             * @brief Queues a component to be added.
+             * @param component The component.
+             */
+            void push(ComponentCommand& component) noexcept;
+
+            private:
+            EntityProperties::Handle target;  ///< The entity to add the components to.
+            bool spawn;                       ///< Whether to spawn the entity first, into the slot the target was reserved with.
+            ComponentCommand* first;          ///< The first component to add.
+            ComponentCommand* last;           ///< The last component to add.
+        };
+
+        /**
+         * @brief Removes components from an entity.
+         * @tparam ComponentTypes... The component types to remove.
+         */
+        template <typename... ComponentTypes>
+        class RemoveCommand : public Command {
+            public:
+            /**
+             * @brief Creates a new RemoveCommand.
+             * @param target The entity to remove the components from.
+             */
+            explicit RemoveCommand(const EntityProperties::Handle target) noexcept : target(target) {}
+
+            /**
+             * @brief Removes the components, if the entity is still alive.
+             * @param entityRegistry The EntityRegistry to apply the change to.
+             */
+            void apply(EntityRegistry& entityRegistry) override {
+                if (entityRegistry.isAlive(target)) {
+                    entityRegistry.getComponentRegistry().remove<ComponentTypes...>(EntityProperties::getID(target));
+                }
+            }
+
+            private:
+            EntityProperties::Handle target;  ///< The entity to remove the components from.
+        };
+
+        /**
+         * @brief Kills an entity.
+         */
+        class KillCommand : public Command {
+            public:
+            /**
+             * @brief Creates a new KillCommand.
+             * @param target The entity to kill.
+             */
+            explicit KillCommand(const EntityProperties::Handle target) noexcept;
+
+            /**
+             * @brief Kills the entity, if it is still alive.
+             * @param entityRegistry The EntityRegistry to apply the change to.
+             */
+            void apply(EntityRegistry& entityRegistry) override;
+
+            private:
+            EntityProperties::Handle target;  ///< The entity to kill.
+        };
+
+        /**
+         * @brief Runs an arbitrary function, for changes that go beyond entities (e.g. adding systems).
+         * @tparam Func The function type.
+         */
+        template <typename Func>
+        class FunctionCommand : public Command {
+            public:
+            /**
+             * @brief Creates a new FunctionCommand.
+             * @param func The function to run.
+             */
+            explicit FunctionCommand(Func&& func) : func(Move(func)) {}
+
+            /**
+             * @brief Runs the function.
+             * @param entityRegistry The EntityRegistry to apply the change to. Unused.
+             */
+            void apply(EntityRegistry& entityRegistry) override { func(); }
+
+            private:
+            Func func;  ///< The function to run.
+        };
+
+        /**
+         * @brief Records commands into an arena, so recording one costs a pointer bump. Applying the buffer runs every command in the order it
+         * was recorded and recycles the arena for the next batch.
+         * A buffer must only be recorded into by one thread at a time.
+         */
+        class CommandBuffer {
+            public:
+            /**
+             * @brief Creates a new, empty CommandBuffer.
+             */
+            CommandBuffer() noexcept;
+            /**
+             * @brief Destroys the commands that were never applied.
+             */
+            ~CommandBuffer() noexcept;
+            /**
+             * @brief Copy constructor (deleted).
+             * @param other The buffer to copy.
+             */
+            CommandBuffer(const CommandBuffer&) noexcept = delete;
+            /**
+             * @brief Move constructor (deleted).
+             * @param other The buffer to move.
+             */
+            CommandBuffer(CommandBuffer&&) noexcept = delete;
+            /**
+             * @brief Copy assignment operator (deleted).
+             * @param other The buffer to copy.
+             */
+            CommandBuffer& operator=(const CommandBuffer&) noexcept = delete;
+            /**
+             * @brief Move assignment operator (deleted).
+             * @param other The buffer to move.
+             */
+            CommandBuffer& operator=(CommandBuffer&&) noexcept = delete;
+
+            /**
+             * @brief Records a command.
+             * @tparam CommandType The command type.
+             * @tparam Args... The command's constructor argument types.
+             * @param args The command's constructor arguments.
+             * @return The recorded command.
+             */
+            template <typename CommandType, typename... Args>
+            CommandType& push(Args&&... args) {
+                static_assert(std::is_base_of<Command, CommandType>::value, "CommandType must be a command.");
+                CommandType& command = create<CommandType>(std::forward<Args>(args)...);
+                if (last) {
+                    last->next = &command;
+                } else {
+                    first = &command;
+                }
+                last = &command;
+                return command;
+            }
+            /**
+             * @brief Creates an object in the buffer's arena. It is never destroyed by the buffer.
+             * @tparam Type The object type.
+             * @tparam Args... The object's constructor argument types.
+             * @param args The object's constructor arguments.
+             * @return The created object.
+             */
+            template <typename Type, typename... Args>
+            Type& create(Args&&... args) {
+                return *new (grab(sizeof(Type), alignof(Type))) Type(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Applies every recorded command, in order, then empties the buffer.
+             * @param entityRegistry The EntityRegistry to apply the commands to.
+             */
+            void apply(EntityRegistry& entityRegistry);
+            /**
+             * @brief Check if the buffer has no recorded commands.
+             * @return True if the buffer is empty, false otherwise.
+             */
+            const bool isEmpty() const noexcept;
+
+            private:
+            core::memory::ArenaAllocator arena;  ///< Holds the recorded commands.
+            Command* first;                      ///< The first recorded command.
+            Command* last;                       ///< The last recorded command.
+
+            /**
+             * @brief Grabs aligned memory from the arena.
+             * @param size The number of bytes to grab.
+             * @param alignment The alignment of the memory.
+             * @return The grabbed memory.
+             */
+            void* grab(const size_t size, const size_t alignment);
+            /**
+             * @brief Destroys every recorded command and recycles the arena.
+             */
+            void clear() noexcept;
+        };
+
+        /**
+         * @brief What a system keeps to record commands: its own buffer, and its place in the order buffers are applied in.
+         */
+        struct CommandSlot {
+            CommandBuffer* buffer = nullptr;  ///< The system's buffer, or null until it first records a command.
+            uint64 order = next();            ///< When the system was registered, relative to every other system.
+
+            /**
+             * @brief Gets the next place in the order buffers are applied in. Systems are registered on the main thread, so their slots
+             * are numbered in registration order.
+             * @return The next place.
+             */
+            static uint64 next() noexcept;
+        };
+
+        /**
+         * @brief Holds one CommandBuffer per system that records commands, so systems running in parallel never share one. The buffers are
+         * applied together at the end of each stage, in the order their systems were registered, so the result never depends on which
+         * thread ran which system, or when.
+         */
+        class CommandQueue {
+            public:
+            /**
+             * @brief Creates a new CommandQueue.
+             * @param entityRegistry The EntityRegistry the commands are applied to.
+             */
+            explicit CommandQueue(EntityRegistry& entityRegistry) noexcept;
+            /**
+             * @brief Default destructor.
+             */
+            ~CommandQueue() noexcept = default;
+
+            /**
+             * @brief Gets a system's buffer, creating it if needed.
+             * @param slot The system's slot.
+             * @return The system's buffer.
+             */
+            CommandBuffer& getBuffer(CommandSlot& slot);
+            /**
+             * @brief Applies every buffer. Must not be called while systems are running.
+             */
+            void apply();
+
+            private:
+            EntityRegistry& entityRegistry;                   ///< The EntityRegistry the commands are applied to.
+            std::mutex mutex;                                 ///< Guards the buffers.
+            Vec<Pair<uint64, Scope<CommandBuffer>>> buffers;  ///< The buffer of each system that has recorded commands, by slot order.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
@@ -9,10 +9,27 @@
 
 namespace cobalt {
     namespace core::ecs {
-        Commands::Commands(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
-                           EventManager& eventManager) noexcept
-            : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager) {}
+        EntityCommands::EntityCommands(CommandBuffer& buffer, InsertCommand& command, const EntityProperties::Handle handle) noexcept
+            : buffer(buffer), command(command), handle(handle) {}
 
-        Entity& Commands::spawn() noexcept { return entityRegistry.add(); }
+        const EntityProperties::Handle EntityCommands::getHandle() const noexcept { return handle; }
+
+        Commands::Commands(State& state, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                           EventManager& eventManager)
+            : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+              buffer(systemManager.getCommandQueue().getBuffer(state)) {}
+
+        EntityCommands Commands::spawn() {
+            const EntityProperties::Handle handle = entityRegistry.reserve();
+            return EntityCommands(buffer, buffer.push<InsertCommand>(handle, true), handle);
+        }
+
+        EntityCommands Commands::entity(const EntityProperties::Handle handle) {
+            return EntityCommands(buffer, buffer.push<InsertCommand>(handle, false), handle);
+        }
+
+        void Commands::kill(const EntityProperties::Handle handle) { buffer.push<KillCommand>(handle); }
+
+        const bool Commands::isAlive(const EntityProperties::Handle handle) const noexcept { return entityRegistry.isAlive(handle); }
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
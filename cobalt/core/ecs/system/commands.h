@@ -11,30 +11,124 @@
 
 namespace cobalt {
     namespace core::ecs {
+        /**
+         * @brief Records the components to add to a single entity. Every component added through it ends up in the entity with a single move
+         * between tables, when the commands are applied.
+         */
+        class EntityCommands {
+            public:
+            /**
+             * @brief Creates a new EntityCommands.
+             * @param buffer The buffer the components are recorded into.
+             * @param command The command that adds the components.
+             * @param handle The entity's handle.
+             */
+            EntityCommands(CommandBuffer& buffer, InsertCommand& command, const EntityProperties::Handle handle) noexcept;
+            /**
+             * @brief Default destructor.
+             */
+            ~EntityCommands() noexcept = default;
+
+            /**
+             * @brief Add a component to the entity. Ignored if the entity already has it by the time the commands are applied.
+             * @tparam ComponentType The component type.
+             * @tparam Args... The component's constructor argument types.
+             * @param args The component's constructor arguments.
+             * @return Reference to this, to chain more components.
+             */
+            template <typename ComponentType, typename... Args>
+            EntityCommands& add(Args&&... args) {
+                Component::validate<ComponentType>();
+                static_assert(std::is_constructible<ComponentType, Args...>::value, "ComponentType must be constructible with Args.");
+                command.push(buffer.create<ComponentValue<ComponentType>>(std::forward<Args>(args)...));
+                return *this;
+            }
+
+            /**
+             * @brief Get the entity's handle. A spawned entity's slot is reserved right away, so its handle can be recorded into other
+             * commands or stored, though it is only alive once the commands are applied.
+             * @return The entity handle.
+             */
+            const EntityProperties::Handle getHandle() const noexcept;
+
+            private:
+            CommandBuffer& buffer;            ///< The buffer the components are recorded into.
+            InsertCommand& command;           ///< The command that adds the components.
+            EntityProperties::Handle handle;  ///< The entity's handle.
+        };
+
         /**
          * @brief Commands allow for easy entity creation / destruction and system / resource management from a system.
+         * Nothing happens right away: every command is recorded into the system's own buffer and applied once the current schedule
+         * finishes, system by system in the order they were registered. Running queries are never invalidated, and systems using Commands
+         * can run in parallel without their order of execution changing the result.
          */
         class Commands : SystemParameter {
             public:
+            using State = CommandSlot;  ///< The system's command buffer, kept between runs.
+
             /**
              * @brief Create a new Commands.
+             * @param state The system's command buffer.
              * @param entityRegistry The EntityRegistry where the commands will be executed.
              * @param resourceRegistry The ResourceRegistry where the commands will be executed.
              * @param systemManager The SystemManager where the commands will be executed.
              * @param eventManager The EventManager where the commands will be executed.
              */
-            Commands(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
-                     EventManager& eventManager) noexcept;
+            Commands(State& state, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                     EventManager& eventManager);
             /**
              * @brief Default destructor.
              */
             ~Commands() noexcept = default;
 
             /**
-             * @brief Spawn a new Entity.
-             * @return An entity handle.
+             * @brief Commands are only applied between schedules, so they don't touch anything while systems run.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess&) noexcept {}
+
+            /**
+             * @brief Spawn a new Entity. Its slot is reserved right away, so EntityCommands::getHandle() is valid as soon as this returns.
+             * The entity itself only exists once the commands are applied, so there is no Entity& to hand out: keep its handle instead, and
+             * change it later through entity(handle).
+             * Example:
+             *
+             *          const EntityProperties::Handle handle = commands.spawn().add<Position>(0, 0).getHandle();
+             *          // ... later, from this or another system:
+             *          commands.entity(handle).add<Velocity>(1, 0);
+             *
+             * @return The commands to add components to the new entity.
+             */
+            EntityCommands spawn();
+            /**
+             * @brief Add components to an existing Entity.
+             * @param handle The entity handle, as returned by Entity::getHandle(). Ignored if it has been killed by the time the commands
+             * are applied.
+             * @return The commands to add components to the entity.
+             */
+            EntityCommands entity(const EntityProperties::Handle handle);
+            /**
+             * @brief Remove components from an Entity.
+             * @tparam ComponentTypes... The component types to remove.
+             * @param handle The entity handle. Ignored if it has been killed by the time the commands are applied.
+             */
+            template <typename... ComponentTypes>
+            void remove(const EntityProperties::Handle handle) {
+                Component::validate<ComponentTypes...>();
+                buffer.push<RemoveCommand<ComponentTypes...>>(handle);
+            }
+            /**
+             * @brief Kill an Entity.
+             * @param handle The entity handle. Ignored if it has been killed by the time the commands are applied.
              */
-            Entity& spawn() noexcept;
+            void kill(const EntityProperties::Handle handle);
+            /**
+             * @brief Check if an entity handle is still valid. Commands that have not been applied yet are not taken into account.
+             * @param handle The entity handle.
+             * @return True if the entity is alive, false otherwise.
+             */
+            const bool isAlive(const EntityProperties::Handle handle) const noexcept;
 
             /**
              * @brief Add a System to the world.
@@ -42,9 +136,9 @@ namespace cobalt {
              * @param schedule The schedule to add the system to.
              */
             template <typename SystemType>
-            void addSystem(DefaultSchedules schedule) noexcept {
+            void addSystem(DefaultSchedules schedule) {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "SystemType must be a subclass of SystemInterface.");
-                systemManager.addSystem<SystemType>(schedule);
+                defer([&manager = systemManager, schedule]() { manager.addSystem<SystemType>(schedule); });
             }
             /**
              * @brief Add a System to the world.
@@ -56,9 +150,9 @@ namespace cobalt {
              * @see Query, ReadRequest, WriteRequest, Commands
              */
             template <typename... Params, typename Func>
-            void addSystem(DefaultSchedules schedule, Func func) noexcept {
+            void addSystem(DefaultSchedules schedule, Func func) {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
-                systemManager.addSystem<Params...>(schedule, func);
+                defer([&manager = systemManager, schedule, func]() { manager.addSystem<Params...>(schedule, func); });
             }
 
             /**
@@ -67,9 +161,9 @@ namespace cobalt {
              * @param eventName The event to hook into.
              */
             template <typename SystemType>
-            void addHook(const std::string& eventName) noexcept {
+            void addHook(const std::string& eventName) {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "SystemType must be a subclass of SystemInterface.");
-                eventManager.addHook<SystemType>(eventName);
+                defer([&manager = eventManager, eventName]() { manager.addHook<SystemType>(eventName); });
             }
             /**
              * @brief Hook a System to an event.
@@ -81,10 +175,23 @@ namespace cobalt {
              * @see Query, ReadRequest, WriteRequest, Commands
              */
             template <typename... Params, typename Func>
-            void addHook(const std::string& eventName, Func func) noexcept {
+            void addHook(const std::string& eventName, Func func) {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
-                eventManager.addHook<Params...>(eventName, func);
+                defer([&manager = eventManager, eventName, func]() { manager.addHook<Params...>(eventName, func); });
+            }
+
+            private:
+            CommandBuffer& buffer;  ///< The system's command buffer.
+
+            /**
+             * @brief Record a function to run when the commands are applied.
+             * @tparam Func The function type.
+             * @param func The function.
+             */
+            template <typename Func>
+            void defer(Func&& func) {
+                buffer.push<FunctionCommand<std::decay_t<Func>>>(std::forward<Func>(func));
             }
         };
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
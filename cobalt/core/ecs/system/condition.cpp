@@ -0,0 +1,29 @@
+/**
+ * @file condition.cpp
+ * @brief A run condition decides whether a system runs at all, before any of its parameters are created.
+ * @author Tomás Marques
+ * @date 18-09-2024
+ */
+
+#include "core/ecs/system/condition.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        RunCondition RunCondition::everyTicks(const uint64 ticks) noexcept {
+            // 0 would divide by zero, and holding every 0 checks means the same as holding every check.
+            return RunCondition([ticks = std::max(ticks, (uint64)1), count = (uint64)0](const ResourceRegistry&, const uint64) mutable {
+                return count++ % ticks == 0;
+            });
+        }
+
+        RunCondition RunCondition::operator&&(const RunCondition& other) const {
+            SystemAccess combined = access;
+            combined.merge(other.access);
+            return RunCondition(
+                [first = *this, second = other](const ResourceRegistry& resourceRegistry, const uint64 lastRun) mutable {
+                    return first(resourceRegistry, lastRun) && second(resourceRegistry, lastRun);
+                },
+                Move(combined));
+        }
+    }  // namespace core::ecs
+}  // namespace cobalt
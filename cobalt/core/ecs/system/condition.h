@@ -0,0 +1,124 @@
+/**
+ * @file condition.h
+ * @brief A run condition decides whether a system runs at all, before any of its parameters are created.
+ * @author Tomás Marques
+ * @date 18-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/event/channel.h"
+#include "core/ecs/resource/registry.h"
+#include "core/ecs/system/parameter.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        /**
+         * @brief A run condition is checked every time its system is about to run. If it doesn't hold, the system is skipped: none of its
+         * parameters are created, and change filters and event readers keep counting from its last actual run.
+         * Conditions declare the resources they read like system parameters do, so their systems are ordered after whatever writes them.
+         * Example:
+         *
+         *          world.addSystem<WriteRequest<Navigation>>(DefaultSchedules::Update, func, "pathfinding",
+         *                                                    RunCondition::resourceChanged<Level>() && RunCondition::everyTicks(4));
+         *
+         */
+        class RunCondition {
+            public:
+            /**
+             * @brief The check itself: given the resources and the tick of the system's last run (0 if it never ran), whether it should run.
+             */
+            using Check = Func<bool(const ResourceRegistry& resourceRegistry, const uint64 lastRun)>;
+
+            /**
+             * @brief Creates a condition that always holds.
+             */
+            RunCondition() noexcept = default;
+            /**
+             * @brief Creates a custom condition.
+             * @param check The check.
+             * @param access The world data the check reads.
+             */
+            RunCondition(Check check, SystemAccess&& access = SystemAccess()) noexcept : check(Move(check)), access(Move(access)) {}
+            /**
+             * @brief Default destructor.
+             */
+            ~RunCondition() noexcept = default;
+
+            /**
+             * @brief Holds when a resource was changed since the system last ran: written through a WriteRequest or added to the world.
+             * @tparam ResourceType The resource type.
+             * @return The condition.
+             */
+            template <typename ResourceType>
+            static RunCondition resourceChanged() noexcept {
+                const ResourceProperties::Type type = Resource::getType<ResourceType>();
+                SystemAccess access;
+                access.readResource(type);
+                return RunCondition(
+                    [type](const ResourceRegistry& resourceRegistry, const uint64 lastRun) { return resourceRegistry.getChangeTick(type) > lastRun; },
+                    Move(access));
+            }
+            /**
+             * @brief Holds when a resource is in the world.
+             * @tparam ResourceType The resource type.
+             * @return The condition.
+             */
+            template <typename ResourceType>
+            static RunCondition resourceExists() noexcept {
+                return RunCondition(
+                    [](const ResourceRegistry& resourceRegistry, const uint64) { return resourceRegistry.contains<ResourceType>(); });
+            }
+            /**
+             * @brief Holds when events of a type were sent since the system last ran, so an EventReader would have something to read.
+             * @tparam EventType The event type. Its channel must have been registered with World::registerEvent.
+             * @return The condition.
+             */
+            template <typename EventType>
+            static RunCondition eventPresent() noexcept {
+                SystemAccess access;
+                access.readResource(Resource::getType<Events<EventType>>());
+                return RunCondition(
+                    [](const ResourceRegistry& resourceRegistry, const uint64 lastRun) {
+                        return resourceRegistry.get<const Events<EventType>&>().count(lastRun) > 0;
+                    },
+                    Move(access));
+            }
+            /**
+             * @brief Holds once every few checks, starting with the first one. A system in an update schedule checks once per tick.
+             * The count is kept inside the condition, and every copy keeps counting on its own from wherever it was copied, so combine it
+             * with && before it is first checked.
+             * @param ticks The number of checks between holds. 0 is treated as 1, holding on every check.
+             * @return The condition.
+             */
+            static RunCondition everyTicks(const uint64 ticks) noexcept;
+
+            /**
+             * @brief Combines two conditions into one that holds when both do. The second one is only checked if the first one holds.
+             * Both are copied, along with any state they keep (e.g. everyTicks' count), so conditions must be combined before their first
+             * use.
+             * @param other The other condition.
+             * @return The combined condition.
+             */
+            RunCondition operator&&(const RunCondition& other) const;
+
+            /**
+             * @brief Checks the condition.
+             * @param resourceRegistry The resources of the world the system runs in.
+             * @param lastRun The tick of the system's last run, or 0 if it never ran.
+             * @return True if the system should run, false otherwise.
+             */
+            bool operator()(const ResourceRegistry& resourceRegistry, const uint64 lastRun) { return !check || check(resourceRegistry, lastRun); }
+
+            /**
+             * @brief Get the world data the condition reads.
+             * @return The condition's access.
+             */
+            const SystemAccess& getAccess() const noexcept { return access; }
+
+            private:
+            Check check;          ///< The check, or empty if the condition always holds.
+            SystemAccess access;  ///< The world data the check reads.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
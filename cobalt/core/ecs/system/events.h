@@ -0,0 +1,169 @@
+/**
+ * @file events.h
+ * @brief EventWriter and EventReader are SystemParameters that send and receive typed events through an event channel.
+ * @author Tomás Marques
+ * @date 10-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/entity/registry.h"
+#include "core/ecs/event/channel.h"
+#include "core/ecs/resource/registry.h"
+#include "core/ecs/system/parameter.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        class SystemManager;
+
+        /**
+         * @brief An EventWriter sends events into a channel. The channel must have been registered with World::registerEvent.
+         * Example:
+         *
+         *          writer.send(CollisionEvent{a, b});
+         *
+         * @tparam EventType The event type.
+         */
+        template <typename EventType>
+        class EventWriter : SystemParameter {
+            public:
+            using State = ResourceSlot<Events<EventType>>;  ///< The channel, cached by the system between runs.
+
+            /**
+             * @brief Creates a new EventWriter.
+             * @param entityRegistry The EntityRegistry whose change tick stamps the events.
+             * @param resourceRegistry The ResourceRegistry that holds the channel.
+             * @param systemManager The SystemManager that the writer will run on. Unused.
+             * @param eventManager The EventManager that the writer will run on. Unused.
+             */
+            explicit EventWriter(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                                 EventManager& eventManager)
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  events(resourceRegistry.get<Events<EventType>&>()),
+                  tick(entityRegistry.getComponentRegistry().getTicks().thisRun) {}
+            /**
+             * @brief Creates a new EventWriter through a cached slot, only looking the channel up if the registry changed since.
+             * @param state The cached slot.
+             * @param entityRegistry The EntityRegistry whose change tick stamps the events.
+             * @param resourceRegistry The ResourceRegistry that holds the channel.
+             * @param systemManager The SystemManager that the writer will run on. Unused.
+             * @param eventManager The EventManager that the writer will run on. Unused.
+             */
+            EventWriter(State& state, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                        EventManager& eventManager)
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  events(resourceRegistry.get(state)),
+                  tick(entityRegistry.getComponentRegistry().getTicks().thisRun) {}
+            /**
+             * @brief Default destructor.
+             */
+            ~EventWriter() noexcept = default;
+
+            /**
+             * @brief Declares write access to the channel, so writers never run alongside each other or the channel's readers.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess& access) noexcept { access.writeResource(Resource::getType<Events<EventType>>()); }
+
+            /**
+             * @brief Sends an event.
+             * @param event The event.
+             */
+            void send(const EventType& event) { events.emplace(tick, event); }
+            /**
+             * @brief Sends an event.
+             * @param event The event. Moved from.
+             */
+            void send(EventType&& event) { events.emplace(tick, Move(event)); }
+            /**
+             * @brief Sends an event, constructing it in place.
+             * @tparam Args... The event constructor argument types.
+             * @param args The event constructor arguments.
+             * @return The new event.
+             */
+            template <typename... Args>
+            EventType& emplace(Args&&... args) {
+                return events.emplace(tick, std::forward<Args>(args)...);
+            }
+
+            private:
+            Events<EventType>& events;  ///< The channel.
+            uint64 tick;                ///< The change tick of the running system.
+        };
+
+        /**
+         * @brief An EventReader walks the events sent into a channel since the system last ran, oldest first. Every reader keeps its own
+         * cursor, so any number of systems can read the same events. Events are kept for two frames, so a system that runs less often than
+         * that misses some. The channel must have been registered with World::registerEvent.
+         * Example:
+         *
+         *          for (const CollisionEvent& collision : reader) {
+         *              // React to the collision.
+         *          }
+         *
+         * @tparam EventType The event type.
+         */
+        template <typename EventType>
+        class EventReader : SystemParameter {
+            public:
+            using State = ResourceSlot<const Events<EventType>>;  ///< The channel, cached by the system between runs.
+
+            /**
+             * @brief Creates a new EventReader.
+             * @param entityRegistry The EntityRegistry whose change ticks place the reader's cursor.
+             * @param resourceRegistry The ResourceRegistry that holds the channel.
+             * @param systemManager The SystemManager that the reader will run on. Unused.
+             * @param eventManager The EventManager that the reader will run on. Unused.
+             */
+            explicit EventReader(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                                 EventManager& eventManager)
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  events(resourceRegistry.get<const Events<EventType>&>()),
+                  lastRun(entityRegistry.getComponentRegistry().getTicks().lastRun) {}
+            /**
+             * @brief Creates a new EventReader through a cached slot, only looking the channel up if the registry changed since.
+             * @param state The cached slot.
+             * @param entityRegistry The EntityRegistry whose change ticks place the reader's cursor.
+             * @param resourceRegistry The ResourceRegistry that holds the channel.
+             * @param systemManager The SystemManager that the reader will run on. Unused.
+             * @param eventManager The EventManager that the reader will run on. Unused.
+             */
+            EventReader(State& state, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                        EventManager& eventManager)
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  events(resourceRegistry.get(state)),
+                  lastRun(entityRegistry.getComponentRegistry().getTicks().lastRun) {}
+            /**
+             * @brief Default destructor.
+             */
+            ~EventReader() noexcept = default;
+
+            /**
+             * @brief Declares read access to the channel, so readers run after the writers scheduled before them.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess& access) noexcept { access.readResource(Resource::getType<Events<EventType>>()); }
+
+            /**
+             * @brief Counts the unread events.
+             * @return The number of events sent since the system last ran.
+             */
+            const uint64 size() const noexcept { return events.count(lastRun); }
+            /**
+             * @brief Checks if there are unread events.
+             * @return True if no event was sent since the system last ran, false otherwise.
+             */
+            const bool isEmpty() const noexcept { return size() == 0; }
+
+            /**
+             * @brief Iterator over the events sent since the system last ran.
+             */
+            EventIterator<EventType> begin() const noexcept { return events.begin(lastRun); }
+            EventIterator<EventType> end() const noexcept { return events.end(); }
+
+            private:
+            const Events<EventType>& events;  ///< The channel.
+            uint64 lastRun;                   ///< The tick at which the system last ran. Events stamped after it are unread.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
@@ -9,28 +9,127 @@
 
 namespace cobalt {
     namespace core::ecs {
-        SystemManager::SystemManager(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, EventManager& eventManager) noexcept
-            : systems() {
-            for (auto schedule : {DefaultSchedules::Startup, DefaultSchedules::PreUpdate, DefaultSchedules::Update, DefaultSchedules::PostUpdate,
-                                  DefaultSchedules::PreRender, DefaultSchedules::Render, DefaultSchedules::PostRender, DefaultSchedules::Shutdown}) {
-                systems.emplace(schedule, Move(CreateScope<SystemRegistry>(entityRegistry, resourceRegistry, *this, eventManager)));
+        const char* getScheduleName(const DefaultSchedules schedule) noexcept {
+            switch (schedule) {
+                case DefaultSchedules::Startup:
+                    return "Startup";
+                case DefaultSchedules::PreUpdate:
+                    return "PreUpdate";
+                case DefaultSchedules::Update:
+                    return "Update";
+                case DefaultSchedules::PostUpdate:
+                    return "PostUpdate";
+                case DefaultSchedules::PreRender:
+                    return "PreRender";
+                case DefaultSchedules::Render:
+                    return "Render";
+                case DefaultSchedules::PostRender:
+                    return "PostRender";
+                case DefaultSchedules::Shutdown:
+                    return "Shutdown";
+                default:
+                    return "Unknown";
             }
         }
 
-        void SystemManager::startup() noexcept { systems[DefaultSchedules::Startup]->run(); }
+        SystemManager::SystemManager(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, EventManager& eventManager,
+                                     const uint threadCount) noexcept
+            : threadPool(threadCount),
+              commandQueue(entityRegistry),
+              systems(),
+              customSchedules(),
+              children(),
+              timestep(1.0 / 60.0),
+              entityRegistry(entityRegistry),
+              resourceRegistry(resourceRegistry),
+              eventManager(eventManager) {
+            for (auto schedule : {DefaultSchedules::Startup, DefaultSchedules::PreRender, DefaultSchedules::Render, DefaultSchedules::PostRender,
+                                  DefaultSchedules::Shutdown}) {
+                systems.emplace(schedule,
+                                Move(CreateScope<SystemRegistry>(getScheduleName(schedule), entityRegistry, resourceRegistry, *this, eventManager)));
+            }
+            for (auto schedule : {DefaultSchedules::PreUpdate, DefaultSchedules::Update, DefaultSchedules::PostUpdate}) {
+                systems.emplace(schedule, Move(CreateScope<SystemRegistry>(getScheduleName(schedule), entityRegistry, resourceRegistry, *this,
+                                                                          eventManager, &threadPool)));
+            }
+        }
+
+        void SystemManager::addSchedule(const std::string& name, const DefaultSchedules parent, const double rate) {
+            if (customSchedules.contains(name)) {
+                throw DuplicateScheduleException<SystemManager>(name);
+            }
+            // Custom schedules run on the same threads as their parent.
+            const bool parallel =
+                parent == DefaultSchedules::PreUpdate || parent == DefaultSchedules::Update || parent == DefaultSchedules::PostUpdate;
+            CustomSchedule& schedule = customSchedules[name];
+            schedule.name = name;
+            schedule.systems =
+                CreateScope<SystemRegistry>(name, entityRegistry, resourceRegistry, *this, eventManager, parallel ? &threadPool : nullptr);
+            schedule.step = rate > 0.0 ? 1.0 / rate : 0.0;
+            schedule.accumulator = 0.0;
+            children[parent].push_back(&schedule);
+        }
+
+        void SystemManager::setTimestep(const double seconds) noexcept { timestep = seconds; }
+
+        core::thread::ThreadPool& SystemManager::getThreadPool() noexcept { return threadPool; }
+
+        CommandQueue& SystemManager::getCommandQueue() noexcept { return commandQueue; }
+
+        void SystemManager::startup() noexcept { run(DefaultSchedules::Startup); }
 
         void SystemManager::update() noexcept {
+            // Commands recorded outside of a schedule (e.g. by event hooks) are applied before the first one runs.
+            commandQueue.apply();
             for (DefaultSchedules schedule : {DefaultSchedules::PreUpdate, DefaultSchedules::Update, DefaultSchedules::PostUpdate}) {
-                systems[schedule]->run();
+                run(schedule);
             }
         }
 
         void SystemManager::render() noexcept {
             for (DefaultSchedules schedule : {DefaultSchedules::PreRender, DefaultSchedules::Render, DefaultSchedules::PostRender}) {
+                run(schedule);
+            }
+        }
+
+        void SystemManager::shutdown() noexcept { run(DefaultSchedules::Shutdown); }
+
+        void SystemManager::run(const DefaultSchedules schedule) noexcept {
+            {
+                CB_PROFILE_SCOPE(getScheduleName(schedule), "Schedules");
                 systems[schedule]->run();
+                commandQueue.apply();
+            }
+            const auto scheduleChildren = children.find(schedule);
+            if (scheduleChildren != children.end()) {
+                for (CustomSchedule* child : scheduleChildren->second) {
+                    run(*child);
+                }
             }
         }
 
-        void SystemManager::shutdown() noexcept { systems[DefaultSchedules::Shutdown]->run(); }
+        SystemManager::CustomSchedule& SystemManager::getSchedule(const std::string& name) {
+            const auto schedule = customSchedules.find(name);
+            if (schedule == customSchedules.end()) {
+                throw ScheduleNotFoundException<SystemManager>(name);
+            }
+            return schedule->second;
+        }
+
+        void SystemManager::run(CustomSchedule& schedule) noexcept {
+            uint runs = 1;
+            if (schedule.step > 0.0) {
+                schedule.accumulator += timestep;
+                // The epsilon keeps rates that divide the timestep evenly from losing a run to rounding.
+                runs = (uint)std::min<double>(schedule.accumulator / schedule.step + 1e-9, MAX_STEPS);
+                // Time that can't be caught up on is dropped, so a slow frame doesn't make every frame after it slower.
+                schedule.accumulator = runs == MAX_STEPS ? 0.0 : schedule.accumulator - runs * schedule.step;
+            }
+            for (uint i = 0; i < runs; i++) {
+                CB_PROFILE_SCOPE(schedule.name, "Schedules");
+                schedule.systems->run();
+                commandQueue.apply();
+            }
+        }
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
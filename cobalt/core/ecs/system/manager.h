@@ -7,12 +7,21 @@
 
 #pragma once
 
+#include "core/ecs/exception.h"
+#include "core/ecs/system/buffer.h"
 #include "core/ecs/system/registry.h"
 
 namespace cobalt {
     namespace core::ecs {
         enum class DefaultSchedules { Startup, PreUpdate, Update, PostUpdate, PreRender, Render, PostRender, Shutdown };
 
+        /**
+         * @brief Gets the name of a schedule.
+         * @param schedule The schedule.
+         * @return The name of the schedule.
+         */
+        const char* getScheduleName(const DefaultSchedules schedule) noexcept;
+
         class EntityRegistry;
         class ResourceRegistry;
         class EventManager;
@@ -29,7 +38,13 @@ namespace cobalt {
          * 7. PostRender
          * 8. Shutdown
          *
-         * TODO: Add a way to add custom schedules.
+         * The update schedules run their systems on a shared thread pool, in parallel wherever their parameters don't conflict. The startup,
+         * render and shutdown schedules may touch the graphics context, which belongs to the main thread, so they always run there in order.
+         * Structural changes recorded through Commands are applied in a batch after each schedule finishes.
+         * Custom schedules hang off one of these, and run right after it each time it runs, in the order they were added. A custom schedule
+         * can also run at a fixed rate, as many times as its rate fits in each timestep of its parent.
+         * With CB_PROFILING defined, each schedule's runs are recorded with the profiler under the schedule's name, and each system's under
+         * its own name in the schedule's category.
          * @see DefaultSchedules
          */
         class SystemManager {
@@ -39,18 +54,22 @@ namespace cobalt {
              * @param entityRegistry The EntityRegistry where the systems will execute.
              * @param resourceRegistry The ResourceRegistry where the systems will execute.
              * @param eventManager The EventManager where the systems will execute.
+             * @param threadCount The number of worker threads the update schedules run on.
              */
-            SystemManager(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, EventManager& eventManager) noexcept;
+            SystemManager(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, EventManager& eventManager,
+                          const uint threadCount = core::thread::ThreadPool::getDefaultThreadCount()) noexcept;
 
             /**
              * @brief Add a system to a schedule.
              * @tparam SystemType The system type.
              * @param schedule The schedule to add the system to.
+             * @param name The name to profile the system under, or empty to name it after the schedule and its position in it.
+             * @param condition The condition the system only runs under.
              */
             template <typename SystemType>
-            void addSystem(DefaultSchedules schedule) noexcept {
+            void addSystem(DefaultSchedules schedule, const std::string& name = "", const RunCondition& condition = RunCondition()) noexcept {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
-                systems[schedule]->addSystem<SystemType>();
+                systems[schedule]->addSystem<SystemType>(name, condition);
             }
             /**
              * @brief Add a system to a schedule.
@@ -58,15 +77,74 @@ namespace cobalt {
              * @tparam Func The lambda function type.
              * @param schedule The schedule to add the system to.
              * @param func The lambda function.
+             * @param name The name to profile the system under, or empty to name it after the schedule and its position in it.
+             * @param condition The condition the system only runs under.
              * @see SystemParameter
              * @see Query, ReadRequest, WriteRequest, Commands
              */
             template <typename... Params, typename Func>
-            void addSystem(DefaultSchedules schedule, Func func) noexcept {
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addSystem(DefaultSchedules schedule, Func func, const std::string& name = "",
+                           const RunCondition& condition = RunCondition()) noexcept {
+                static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
+                systems[schedule]->addSystem<Params...>(func, name, condition);
+            }
+            /**
+             * @brief Add a system to a custom schedule.
+             * @tparam SystemType The system type.
+             * @param schedule The name of the schedule to add the system to.
+             * @param name The name to profile the system under, or empty to name it after the schedule and its position in it.
+             * @param condition The condition the system only runs under.
+             * @throws ScheduleNotFoundException If the schedule was never added.
+             */
+            template <typename SystemType>
+            void addSystem(const std::string& schedule, const std::string& name = "", const RunCondition& condition = RunCondition()) {
+                static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
+                getSchedule(schedule).systems->addSystem<SystemType>(name, condition);
+            }
+            /**
+             * @brief Add a system to a custom schedule.
+             * @tparam Params... The lambda function parameters.
+             * @tparam Func The lambda function type.
+             * @param schedule The name of the schedule to add the system to.
+             * @param func The lambda function.
+             * @param name The name to profile the system under, or empty to name it after the schedule and its position in it.
+             * @param condition The condition the system only runs under.
+             * @throws ScheduleNotFoundException If the schedule was never added.
+             */
+            template <typename... Params, typename Func>
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addSystem(const std::string& schedule, Func func, const std::string& name = "", const RunCondition& condition = RunCondition()) {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
-                systems[schedule]->addSystem<Params...>(func);
+                getSchedule(schedule).systems->addSystem<Params...>(func, name, condition);
             }
 
+            /**
+             * @brief Add a custom schedule.
+             * @param name The name of the schedule.
+             * @param parent The schedule it runs after.
+             * @param rate How many times per second it runs, or 0 to run once every time its parent does.
+             * @throws DuplicateScheduleException If a schedule with the same name was already added.
+             */
+            void addSchedule(const std::string& name, const DefaultSchedules parent, const double rate = 0.0);
+            /**
+             * @brief Set how much time each run of a parent schedule stands for, which fixed-rate schedules advance by. The application sets
+             * it to its fixed update step, so fixed-rate schedules should hang off the update schedules.
+             * @param seconds The timestep in seconds.
+             */
+            void setTimestep(const double seconds) noexcept;
+
+            /**
+             * @brief Get the thread pool the update schedules run on.
+             * @return The thread pool.
+             */
+            core::thread::ThreadPool& getThreadPool() noexcept;
+            /**
+             * @brief Get the queue that systems record their commands into.
+             * @return The command queue.
+             */
+            CommandQueue& getCommandQueue() noexcept;
+
             /**
              * @brief Run the startup schedule.
              */
@@ -84,8 +162,48 @@ namespace cobalt {
              */
             void shutdown() noexcept;
 
+            static inline constexpr uint MAX_STEPS = 8;  ///< The most times a fixed-rate schedule catches up in one run of its parent.
+
             private:
+            /**
+             * @brief A schedule added at runtime.
+             */
+            struct CustomSchedule {
+                std::string name;               ///< The name of the schedule.
+                Scope<SystemRegistry> systems;  ///< The systems in the schedule.
+                double step;                    ///< The time between runs in seconds, or 0 to run every time the parent does.
+                double accumulator;             ///< The time not run yet.
+            };
+
+            core::thread::ThreadPool threadPool;                    ///< The workers the update schedules run on.
+            CommandQueue commandQueue;                              ///< The commands recorded by systems, applied after each schedule.
             UMap<DefaultSchedules, Scope<SystemRegistry>> systems;  ///< The systems in the manager.
+            UMap<std::string, CustomSchedule> customSchedules;      ///< The custom schedules, by name.
+            UMap<DefaultSchedules, Vec<CustomSchedule*>> children;  ///< The custom schedules that run after each schedule, in order.
+            double timestep;                                        ///< The time each run of a parent schedule stands for.
+            EntityRegistry& entityRegistry;                         ///< The EntityRegistry where the systems will execute.
+            ResourceRegistry& resourceRegistry;                     ///< The ResourceRegistry where the systems will execute.
+            EventManager& eventManager;                             ///< The EventManager where the systems will execute.
+
+            /**
+             * @brief Get a custom schedule.
+             * @param name The name of the schedule.
+             * @return The schedule.
+             * @throws ScheduleNotFoundException If the schedule was never added.
+             */
+            CustomSchedule& getSchedule(const std::string& name);
+            /**
+             * @brief Run a custom schedule as many times as its rate fits in the time it has accumulated, applying the commands its
+             * systems recorded after each run.
+             * @param schedule The schedule.
+             */
+            void run(CustomSchedule& schedule) noexcept;
+
+            /**
+             * @brief Run a schedule, then apply the commands its systems recorded.
+             * @param schedule The schedule to run.
+             */
+            void run(const DefaultSchedules schedule) noexcept;
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
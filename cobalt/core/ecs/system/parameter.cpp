@@ -1,5 +1,5 @@
 /**
- * @file parameter.h
+ * @file parameter.cpp
  * @brief A system parameter is any object that can be passed to a System's argument list.
  * @author Tomás Marques
  * @date 13-02-2024
@@ -12,5 +12,44 @@ namespace cobalt {
         SystemParameter::SystemParameter(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
                                          EventManager& eventManager) noexcept
             : entityRegistry(entityRegistry), resourceRegistry(resourceRegistry), systemManager(systemManager), eventManager(eventManager) {}
+
+        void SystemAccess::readComponent(const ComponentProperties::Type type) noexcept { componentReads.push_back(type); }
+
+        void SystemAccess::writeComponent(const ComponentProperties::Type type) noexcept { componentWrites.push_back(type); }
+
+        void SystemAccess::readResource(const ResourceProperties::Type type) noexcept { resourceReads.push_back(type); }
+
+        void SystemAccess::writeResource(const ResourceProperties::Type type) noexcept { resourceWrites.push_back(type); }
+
+        void SystemAccess::setExclusive() noexcept { exclusive = true; }
+
+        void SystemAccess::merge(const SystemAccess& other) noexcept {
+            componentReads.insert(componentReads.end(), other.componentReads.begin(), other.componentReads.end());
+            componentWrites.insert(componentWrites.end(), other.componentWrites.begin(), other.componentWrites.end());
+            resourceReads.insert(resourceReads.end(), other.resourceReads.begin(), other.resourceReads.end());
+            resourceWrites.insert(resourceWrites.end(), other.resourceWrites.begin(), other.resourceWrites.end());
+            exclusive = exclusive || other.exclusive;
+        }
+
+        /**
+         * @brief Check if any element of a list of types is also in another.
+         * @tparam Type The type identifier.
+         * @param a The first list.
+         * @param b The second list.
+         * @return True if the lists share a type, false otherwise.
+         */
+        template <typename Type>
+        static const bool overlaps(const Vec<Type>& a, const Vec<Type>& b) noexcept {
+            return std::any_of(a.begin(), a.end(), [&b](const Type type) { return std::find(b.begin(), b.end(), type) != b.end(); });
+        }
+
+        const bool SystemAccess::conflicts(const SystemAccess& other) const noexcept {
+            return exclusive || other.exclusive || overlaps(componentWrites, other.componentWrites) ||
+                   overlaps(componentWrites, other.componentReads) || overlaps(componentReads, other.componentWrites) ||
+                   overlaps(resourceWrites, other.resourceWrites) || overlaps(resourceWrites, other.resourceReads) ||
+                   overlaps(resourceReads, other.resourceWrites);
+        }
+
+        const bool SystemAccess::isExclusive() const noexcept { return exclusive; }
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "core/ecs/properties.h"
+
 namespace cobalt {
     namespace core::ecs {
         class EntityRegistry;
@@ -14,6 +16,99 @@ namespace cobalt {
         class SystemManager;
         class EventManager;
 
+        /**
+         * @brief Describes the world data a system touches through its parameters. Two systems whose accesses do not conflict can safely run at
+         * the same time.
+         */
+        class SystemAccess {
+            public:
+            /**
+             * @brief Creates an empty access: a system with no parameters touches nothing.
+             */
+            SystemAccess() noexcept = default;
+            /**
+             * @brief Default destructor.
+             */
+            ~SystemAccess() noexcept = default;
+
+            /**
+             * @brief Collects the access declared by a set of system parameters.
+             * Parameters declare their access through a static `declare(SystemAccess&)` function. Those that do not are assumed to touch
+             * anything, and make the system exclusive.
+             * @tparam Params... The system parameters.
+             * @return The combined access.
+             */
+            template <typename... Params>
+            static SystemAccess from() noexcept {
+                SystemAccess access;
+                (declare<Params>(access), ...);
+                return access;
+            }
+
+            /**
+             * @brief Declare read-only access to a component type.
+             * @param type The component type.
+             */
+            void readComponent(const ComponentProperties::Type type) noexcept;
+            /**
+             * @brief Declare read-write access to a component type.
+             * @param type The component type.
+             */
+            void writeComponent(const ComponentProperties::Type type) noexcept;
+            /**
+             * @brief Declare read-only access to a resource type.
+             * @param type The resource type.
+             */
+            void readResource(const ResourceProperties::Type type) noexcept;
+            /**
+             * @brief Declare read-write access to a resource type.
+             * @param type The resource type.
+             */
+            void writeResource(const ResourceProperties::Type type) noexcept;
+            /**
+             * @brief Declare that the system may touch anything in the world (e.g. change its structure), so it can't run alongside any other.
+             */
+            void setExclusive() noexcept;
+            /**
+             * @brief Declare everything another access declares.
+             * @param other The other access.
+             */
+            void merge(const SystemAccess& other) noexcept;
+
+            /**
+             * @brief Check if two accesses conflict, i.e. one of them writes something the other one reads or writes.
+             * @param other The other access.
+             * @return True if the accesses conflict, false otherwise.
+             */
+            const bool conflicts(const SystemAccess& other) const noexcept;
+            /**
+             * @brief Check if the access is exclusive.
+             * @return True if the access is exclusive, false otherwise.
+             */
+            const bool isExclusive() const noexcept;
+
+            private:
+            Vec<ComponentProperties::Type> componentReads;   ///< Component types read.
+            Vec<ComponentProperties::Type> componentWrites;  ///< Component types written.
+            Vec<ResourceProperties::Type> resourceReads;     ///< Resource types read.
+            Vec<ResourceProperties::Type> resourceWrites;    ///< Resource types written.
+            bool exclusive = false;                          ///< Whether the system may touch anything.
+
+            /**
+             * @brief Declare a single parameter's access.
+             * @tparam Param The system parameter.
+             * @param access The access to declare into.
+             */
+            template <typename Param>
+            static void declare(SystemAccess& access) noexcept {
+                if constexpr (requires { Param::declare(access); }) {
+                    Param::declare(access);
+                } else {
+                    access.setExclusive();
+                }
+            }
+        };
+
         /**
          * @brief A SystemParameter is passed to a System's constructor and allows the System to interact with the World.
          */
@@ -40,5 +135,25 @@ namespace cobalt {
             SystemManager& systemManager;        ///< The SystemManager where the system will execute.
             EventManager& eventManager;          ///< The EventManager where the system will execute.
         };
+
+        /**
+         * @brief What a system keeps for one of its parameters between runs. A parameter that looks something up in the world every run
+         * can declare a nested `State` type: the system keeps one for it and passes it to the parameter's constructor, ahead of the
+         * usual arguments, so the lookup is only done once. Parameters without one get an empty state and the usual constructor.
+         * @tparam Param The system parameter.
+         */
+        template <typename Param>
+        struct SystemParameterState {
+            using Type = Tuple<>;  ///< No state.
+        };
+        /**
+         * @brief What a system keeps for one of its parameters between runs, for parameters that declare a `State` type.
+         * @tparam Param The system parameter.
+         */
+        template <typename Param>
+            requires requires { typename Param::State; }
+        struct SystemParameterState<Param> {
+            using Type = typename Param::State;  ///< The parameter's state.
+        };
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "core/ecs/entity/registry.h"
+#include "core/ecs/resource/jobs.h"
+#include "core/ecs/resource/registry.h"
 #include "core/ecs/system/parameter.h"
 
 namespace cobalt {
@@ -16,95 +18,262 @@ namespace cobalt {
         class SystemManager;
 
         /**
-         * @brief A Query iterates over entities with specific components in a given World.
-         * @tparam Components... The components to query for. Must be reference types and be registered in the world.
+         * @brief Query filter matching the entities whose component was added since the querying system last ran. The component itself is not
+         * handed out.
+         * Example:
+         *
+         *          Query<Transform&, Added<Velocity>> query;
+         *
+         * @tparam ComponentType The component type.
          */
-        template <typename... Components>
-        class Query : SystemParameter {
-            static_assert((std::is_reference<Components>::value && ...), "All component types must be reference types.");
+        template <typename ComponentType>
+        struct Added {
+            using Type = ComponentType;  ///< The filtered component type.
+
+            /**
+             * @brief Gets the ticks the filter compares against.
+             * @param column The filtered component's column.
+             * @return A pointer to the first row's tick.
+             */
+            static const uint64* getTicks(const ComponentStorageInterface& column) noexcept { return column.getAddedTicks(); }
+        };
+
+        /**
+         * @brief Query filter matching the entities whose component was added or handed out mutably since the querying system last ran. The
+         * component itself is not handed out.
+         * Example:
+         *
+         *          Query<Transform&, Changed<Velocity>> query;
+         *
+         * @tparam ComponentType The component type.
+         */
+        template <typename ComponentType>
+        struct Changed {
+            using Type = ComponentType;  ///< The filtered component type.
+
+            /**
+             * @brief Gets the ticks the filter compares against.
+             * @param column The filtered component's column.
+             * @return A pointer to the first row's tick.
+             */
+            static const uint64* getTicks(const ComponentStorageInterface& column) noexcept { return column.getChangedTicks(); }
+        };
+
+        /**
+         * @brief Checks if a query parameter is a filter rather than a component.
+         * @tparam T The query parameter.
+         */
+        template <typename T>
+        struct IsQueryFilter : std::false_type {};
+        template <typename ComponentType>
+        struct IsQueryFilter<Added<ComponentType>> : std::true_type {};
+        template <typename ComponentType>
+        struct IsQueryFilter<Changed<ComponentType>> : std::true_type {};
+
+        /**
+         * @brief A compile-time list of types.
+         * @tparam Types... The types.
+         */
+        template <typename... Types>
+        struct TypeList {};
 
+        /**
+         * @brief Lazily walks the archetype tables matching a query, one row at a time. Tables that do not match the query's signature are skipped
+         * as a whole, rows that do not pass its filters are skipped by their ticks alone, and no intermediate storage is allocated.
+         * Dereferencing the iterator stamps every mutable component with the running system's tick.
+         * @tparam WithEntity Whether each row is prefixed with a reference to the entity that owns it.
+         * @tparam ComponentList The TypeList of components to query for. Must be reference types and be registered in the world.
+         * @tparam FilterList The TypeList of filters each row must pass.
+         */
+        template <bool WithEntity, typename ComponentList, typename FilterList>
+        class QueryIterator;
+
+        template <bool WithEntity, typename... Components, typename... Filters>
+        class QueryIterator<WithEntity, TypeList<Components...>, TypeList<Filters...>> {
             public:
+            using Row = std::conditional_t<WithEntity, Tuple<const Entity&, Components...>, Tuple<Components...>>;  ///< A row of the query.
+            using ArchetypeIterator = Vec<Scope<Archetype>>::const_iterator;                                        ///< Iterator over the tables.
+
             /**
-             * @brief Creates a new Query.
-             * @param entityRegistry The entity registry that the query will run on.
-             * @param resourceRegistry The resource registry that the query will run on. Unused.
-             * @param systemManager The system manager that the query will run on. Unused.
-             * @param eventManager The event manager that the query will run on. Unused.
+             * @brief Creates a new QueryIterator, positioned on the first matching row at or after the given table.
+             * @param entityRegistry The entity registry that owns the queried entities.
+             * @param archetype The first table to look at.
+             * @param end The end of the tables.
+             * @param signature The signature every matching table must contain. May be null for the end iterator.
+             * @param indices The index of each queried component.
+             * @param filterIndices The index of each filtered component.
+             * @param ticks The ticks of the system running the query.
              */
-            explicit Query(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
-                           EventManager& eventManager) noexcept
-                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
-                  componentTuples(entityRegistry.getMany<Components...>()) {
-                Component::validate<RemoveConstRef<Components>...>();
+            QueryIterator(const EntityRegistry& entityRegistry, const ArchetypeIterator archetype, const ArchetypeIterator end,
+                          const ComponentProperties::Signature* signature, const uint64* indices, const uint64* filterIndices,
+                          const ChangeTicks ticks) noexcept
+                : entityRegistry(&entityRegistry),
+                  archetype(archetype),
+                  end(end),
+                  signature(signature),
+                  indices(indices),
+                  filterIndices(filterIndices),
+                  ticks(ticks),
+                  row(0),
+                  columns(),
+                  changed(),
+                  filters() {
+                seek();
             }
+
             /**
-             * @brief Default destructor.
+             * @brief Gets the current row, stamping its mutable components as changed.
+             * @return The references to the current entity's components.
              */
-            ~Query() noexcept = default;
-
+            Row operator*() const {
+                stamp(std::make_index_sequence<sizeof...(Components)>{});
+                if constexpr (WithEntity) {
+                    return Row(entityRegistry->get((*archetype)->getEntities()[row]), std::get<RemoveConstRef<Components>*>(columns)[row]...);
+                } else {
+                    return Row(std::get<RemoveConstRef<Components>*>(columns)[row]...);
+                }
+            }
             /**
-             * @brief Iterator for easy access to the queried entities.
-             * Example:
-             *
-             *          for (auto [position, velocity] : myQuery) {
-             *              position.x += velocity.x;
-             *              position.y += velocity.y;
-             *          }
-             *          // Do something with the updated components.
+             * @brief Advances to the next matching row, moving on to the next matching table when the current one runs out.
+             * @return Reference to this.
              */
-            class Iterator {
-                public:
-                explicit Iterator(Tuple<Components...>* ptr) : ptr(ptr) {}
+            QueryIterator& operator++() {
+                ++row;
+                seek();
+                return *this;
+            }
+            /**
+             * @brief Advances to the next matching row, moving on to the next matching table when the current one runs out.
+             * @return A copy of this before advancing.
+             */
+            QueryIterator operator++(int) {
+                QueryIterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+            friend bool operator==(const QueryIterator& a, const QueryIterator& b) { return a.archetype == b.archetype && a.row == b.row; }
+            friend bool operator!=(const QueryIterator& a, const QueryIterator& b) { return !(a == b); }
 
-                Tuple<Components...>& operator*() const { return *ptr; }
-                Tuple<Components...>* operator->() { return ptr; }
-                Iterator& operator++() {
-                    ptr++;
-                    return *this;
+            private:
+            const EntityRegistry* entityRegistry;                   ///< The entity registry that owns the queried entities.
+            ArchetypeIterator archetype;                            ///< The current table.
+            ArchetypeIterator end;                                  ///< The end of the tables.
+            const ComponentProperties::Signature* signature;        ///< The signature every matching table must contain.
+            const uint64* indices;                                  ///< The index of each queried component.
+            const uint64* filterIndices;                            ///< The index of each filtered component.
+            ChangeTicks ticks;                                      ///< The ticks of the system running the query.
+            uint64 row;                                             ///< The current row in the current table.
+            Tuple<RemoveConstRef<Components>*...> columns;          ///< The current table's column for each queried component.
+            std::array<uint64*, sizeof...(Components)> changed;     ///< The current table's changed ticks for each queried component.
+            std::array<const uint64*, sizeof...(Filters)> filters;  ///< The current table's ticks for each filter.
+
+            /**
+             * @brief Moves forward to the first matching row at or after the current one, skipping tables that are empty or do not match and
+             * loading the columns of each table it enters.
+             */
+            void seek() noexcept {
+                for (; archetype != end; ++archetype, row = 0) {
+                    const uint64 size = (*archetype)->getSize();
+                    if (row == 0) {
+                        if (size == 0 || !(*archetype)->getSignature().contains(*signature)) {
+                            continue;
+                        }
+                        load(std::make_index_sequence<sizeof...(Components)>{}, std::make_index_sequence<sizeof...(Filters)>{});
+                    }
+                    while (row < size && !passes()) {
+                        ++row;
+                    }
+                    if (row < size) {
+                        return;
+                    }
                 }
-                Iterator operator++(int) {
-                    Iterator tmp = *this;
-                    ++(*this);
-                    return tmp;
+            }
+
+            /**
+             * @brief Checks if the current row passes every filter.
+             * @return True if it does, false otherwise.
+             */
+            bool passes() const noexcept {
+                for (const uint64* tick : filters) {
+                    if (tick[row] <= ticks.lastRun) {
+                        return false;
+                    }
                 }
-                friend bool operator==(const Iterator& a, const Iterator& b) { return a.ptr == b.ptr; }
-                friend bool operator!=(const Iterator& a, const Iterator& b) { return a.ptr != b.ptr; }
+                return true;
+            }
 
-                private:
-                Tuple<Components...>* ptr;
-            };
-            Iterator begin() { return Iterator(&componentTuples[0]); }
-            Iterator end() { return Iterator(&componentTuples[0] + componentTuples.size()); }
+            /**
+             * @brief Stamps the current row's mutable components as changed.
+             * @tparam Is... The indices of the queried components.
+             */
+            template <size_t... Is>
+            void stamp(std::index_sequence<Is...>) const noexcept {
+                ((std::is_const_v<std::remove_reference_t<Components>> ? void() : void(changed[Is][row] = ticks.thisRun)), ...);
+            }
 
-            private:
-            Vec<Tuple<Components...>> componentTuples;  ///< The tuples of components for each entity.
+            /**
+             * @brief Loads the current table's columns and ticks.
+             * @tparam Is... The indices of the queried components.
+             * @tparam Fs... The indices of the filters.
+             */
+            template <size_t... Is, size_t... Fs>
+            void load(std::index_sequence<Is...>, std::index_sequence<Fs...>) noexcept {
+                Archetype& table = **archetype;
+                columns = Tuple<RemoveConstRef<Components>*...>(table.template getColumn<RemoveConstRef<Components>>(indices[Is]).data()...);
+                changed = {table.getColumn(indices[Is]).getChangedTicks()...};
+                filters = {Filters::getTicks(table.getColumn(filterIndices[Fs]))...};
+            }
         };
 
         /**
-         * @brief A Query iterates over entities with specific components in a given World. This version of the Query is a specialization for const
-         * the inclusion of an Entity reference in the query. Each one of the entities owns the queried components.
-         * @tparam Components... The components to query for. Must be reference types and be registered in the world.
+         * @brief The implementation behind every Query, once its parameters have been sorted into components and filters.
+         * @tparam WithEntity Whether each row is prefixed with a reference to the entity that owns it.
+         * @tparam ComponentList The TypeList of components to query for.
+         * @tparam FilterList The TypeList of filters each row must pass.
          */
-        template <typename... Components>
-        class Query<const Entity&, Components...> : SystemParameter {
+        template <bool WithEntity, typename ComponentList, typename FilterList>
+        class BasicQuery;
+
+        template <bool WithEntity, typename... Components, typename... Filters>
+        class BasicQuery<WithEntity, TypeList<Components...>, TypeList<Filters...>> : SystemParameter {
             static_assert((std::is_reference<Components>::value && ...), "All component types must be reference types.");
 
             public:
+            using Iterator = QueryIterator<WithEntity, TypeList<Components...>, TypeList<Filters...>>;  ///< Iterator over the queried entities.
+
             /**
              * @brief Creates a new Query.
              * @param entityRegistry The entity registry that the query will run on.
-             * @param resourceRegistry The resource registry that the query will run on. Unused.
+             * @param resourceRegistry The resource registry that the query will run on. Only used by parForEach.
              * @param systemManager The system manager that the query will run on. Unused.
              * @param eventManager The event manager that the query will run on. Unused.
              */
-            explicit Query(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
-                           EventManager& eventManager) noexcept
+            explicit BasicQuery(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                                EventManager& eventManager) noexcept
                 : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
-                  componentTuples(entityRegistry.getWithEntity<Components...>()) {}
+                  signature(entityRegistry.getComponentRegistry().getSignature<RemoveConstRef<Components>..., typename Filters::Type...>()),
+                  indices(),
+                  filterIndices(),
+                  ticks(entityRegistry.getComponentRegistry().getTicks()) {
+                Component::validate<RemoveConstRef<Components>..., typename Filters::Type...>();
+                if (signature) {
+                    indices = {entityRegistry.getComponentRegistry().getIndex<RemoveConstRef<Components>>()...};
+                    filterIndices = {entityRegistry.getComponentRegistry().getIndex<typename Filters::Type>()...};
+                }
+            }
             /**
              * @brief Default destructor.
              */
-            ~Query() noexcept = default;
+            ~BasicQuery() noexcept = default;
+
+            /**
+             * @brief Declares read access to every const or filtered component and write access to every other one.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess& access) noexcept {
+                (declareComponent<Components>(access), ...);
+                (access.readComponent(Component::getType<typename Filters::Type>()), ...);
+            }
 
             /**
              * @brief Iterator for easy access to the queried entities.
@@ -116,32 +285,195 @@ namespace cobalt {
              *          }
              *          // Do something with the updated components.
              */
-            class Iterator {
-                public:
-                explicit Iterator(Tuple<const Entity&, Components...>* ptr) : ptr(ptr) {}
+            Iterator begin() const noexcept {
+                const auto& archetypes = entityRegistry.getComponentRegistry().getArchetypes();
+                return signature ? Iterator(entityRegistry, archetypes.begin(), archetypes.end(), &*signature, indices.data(), filterIndices.data(),
+                                            ticks)
+                                 : end();
+            }
+            Iterator end() const noexcept {
+                const auto& archetypes = entityRegistry.getComponentRegistry().getArchetypes();
+                return Iterator(entityRegistry, archetypes.end(), archetypes.end(), nullptr, indices.data(), filterIndices.data(), ticks);
+            }
 
-                Tuple<const Entity&, Components...>& operator*() const { return *ptr; }
-                Tuple<const Entity&, Components...>* operator->() { return ptr; }
-                Iterator& operator++() {
-                    ptr++;
-                    return *this;
+            /**
+             * @brief Runs a function on every queried entity, splitting the matching tables into chunks that run in parallel on the world's
+             * JobSystem. Returns once every chunk has finished. The function may run concurrently with itself, so it must only touch the
+             * components it is given.
+             * Example:
+             *
+             *          query.parForEach([](Position& position, const Velocity& velocity) {
+             *              position.x += velocity.x;
+             *          });
+             *
+             * @tparam Func The function type.
+             * @param func The function to run on each entity. Takes the entity first if the query includes it.
+             * @param grainSize The maximum number of entities in a chunk.
+             */
+            template <typename Func>
+            void parForEach(Func&& func, const uint64 grainSize = 1024) const {
+                if constexpr (WithEntity) {
+                    static_assert(std::is_invocable<Func, const Entity&, Components...>::value,
+                                  "Func must be invocable with the entity and the queried components.");
+                } else {
+                    static_assert(std::is_invocable<Func, Components...>::value, "Func must be invocable with the queried components.");
                 }
-                Iterator operator++(int) {
-                    Iterator tmp = *this;
-                    ++(*this);
-                    return tmp;
+                if (!signature) {
+                    return;
                 }
-                friend bool operator==(const Iterator& a, const Iterator& b) { return a.ptr == b.ptr; }
-                friend bool operator!=(const Iterator& a, const Iterator& b) { return a.ptr != b.ptr; }
-
-                private:
-                Tuple<const Entity&, Components...>* ptr;
-            };
-            Iterator begin() { return Iterator(&componentTuples[0]); }
-            Iterator end() { return Iterator(&componentTuples[0] + componentTuples.size()); }
+                JobSystem& jobs = resourceRegistry.get<JobSystem&>();
+                JobSystem::Counter counter = 0;
+                const uint64 grain = std::max<uint64>(grainSize, 1);
+                for (const auto& archetype : entityRegistry.getComponentRegistry().getArchetypes()) {
+                    if (archetype->getSize() == 0 || !archetype->getSignature().contains(*signature)) {
+                        continue;
+                    }
+                    const Tuple<RemoveConstRef<Components>*...> columns = load(*archetype, std::make_index_sequence<sizeof...(Components)>{});
+                    const std::array<uint64*, sizeof...(Components)> changed =
+                        loadChanged(*archetype, std::make_index_sequence<sizeof...(Components)>{});
+                    const std::array<const uint64*, sizeof...(Filters)> filters =
+                        loadFilters(*archetype, std::make_index_sequence<sizeof...(Filters)>{});
+                    for (uint64 begin = 0; begin < archetype->getSize(); begin += grain) {
+                        const uint64 end = std::min(begin + grain, archetype->getSize());
+                        jobs.submit(counter, [this, &func, columns, changed, filters, entities = archetype->getEntities().data(), begin, end]() {
+                            for (uint64 row = begin; row < end; row++) {
+                                if (!passes(filters, row)) {
+                                    continue;
+                                }
+                                stamp(changed, row, std::make_index_sequence<sizeof...(Components)>{});
+                                if constexpr (WithEntity) {
+                                    func(entityRegistry.get(entities[row]), std::get<RemoveConstRef<Components>*>(columns)[row]...);
+                                } else {
+                                    func(std::get<RemoveConstRef<Components>*>(columns)[row]...);
+                                }
+                            }
+                        });
+                    }
+                }
+                jobs.wait(counter);
+            }
 
             private:
-            Vec<Tuple<const Entity&, Components...>> componentTuples;  ///< The tuples of components for each entity.
+            Opt<ComponentProperties::Signature> signature;         ///< The queried and filtered components' signature, if all registered.
+            std::array<uint64, sizeof...(Components)> indices;     ///< The index of each queried component.
+            std::array<uint64, sizeof...(Filters)> filterIndices;  ///< The index of each filtered component.
+            ChangeTicks ticks;                                     ///< The ticks of the system running the query, taken when it is created.
+
+            /**
+             * @brief Declares the access to a single queried component.
+             * @tparam ComponentRef The component reference type.
+             * @param access The access to declare into.
+             */
+            template <typename ComponentRef>
+            static void declareComponent(SystemAccess& access) noexcept {
+                if constexpr (std::is_const_v<std::remove_reference_t<ComponentRef>>) {
+                    access.readComponent(Component::getType<RemoveConstRef<ComponentRef>>());
+                } else {
+                    access.writeComponent(Component::getType<RemoveConstRef<ComponentRef>>());
+                }
+            }
+
+            /**
+             * @brief Checks if a row passes every filter.
+             * @param filters The table's ticks for each filter.
+             * @param row The row.
+             * @return True if it does, false otherwise.
+             */
+            bool passes(const std::array<const uint64*, sizeof...(Filters)>& filters, const uint64 row) const noexcept {
+                for (const uint64* tick : filters) {
+                    if (tick[row] <= ticks.lastRun) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            /**
+             * @brief Stamps a row's mutable components as changed.
+             * @tparam Is... The indices of the queried components.
+             * @param changed The table's changed ticks for each queried component.
+             * @param row The row.
+             */
+            template <size_t... Is>
+            void stamp(const std::array<uint64*, sizeof...(Components)>& changed, const uint64 row, std::index_sequence<Is...>) const noexcept {
+                ((std::is_const_v<std::remove_reference_t<Components>> ? void() : void(changed[Is][row] = ticks.thisRun)), ...);
+            }
+
+            /**
+             * @brief Loads a table's columns.
+             * @tparam Is... The indices of the queried components.
+             * @param archetype The table.
+             * @return The table's column for each queried component.
+             */
+            template <size_t... Is>
+            Tuple<RemoveConstRef<Components>*...> load(Archetype& archetype, std::index_sequence<Is...>) const noexcept {
+                return Tuple<RemoveConstRef<Components>*...>(archetype.template getColumn<RemoveConstRef<Components>>(indices[Is]).data()...);
+            }
+            /**
+             * @brief Loads a table's changed ticks.
+             * @tparam Is... The indices of the queried components.
+             * @param archetype The table.
+             * @return The table's changed ticks for each queried component.
+             */
+            template <size_t... Is>
+            std::array<uint64*, sizeof...(Components)> loadChanged(Archetype& archetype, std::index_sequence<Is...>) const noexcept {
+                return {archetype.getColumn(indices[Is]).getChangedTicks()...};
+            }
+            /**
+             * @brief Loads a table's ticks for each filter.
+             * @tparam Fs... The indices of the filters.
+             * @param archetype The table.
+             * @return The table's ticks for each filter.
+             */
+            template <size_t... Fs>
+            std::array<const uint64*, sizeof...(Filters)> loadFilters(Archetype& archetype, std::index_sequence<Fs...>) const noexcept {
+                return {Filters::getTicks(archetype.getColumn(filterIndices[Fs]))...};
+            }
+        };
+
+        /**
+         * @brief Sorts a query's parameters into components and filters, keeping their order.
+         * @tparam ComponentList The TypeList of components sorted so far.
+         * @tparam FilterList The TypeList of filters sorted so far.
+         * @tparam Params... The parameters left to sort.
+         */
+        template <typename ComponentList, typename FilterList, typename... Params>
+        struct QuerySplit {
+            using Components = ComponentList;  ///< The components.
+            using Filters = FilterList;        ///< The filters.
+        };
+        template <typename... Components, typename... Filters, typename Param, typename... Params>
+        struct QuerySplit<TypeList<Components...>, TypeList<Filters...>, Param, Params...>
+            : std::conditional_t<IsQueryFilter<Param>::value, QuerySplit<TypeList<Components...>, TypeList<Filters..., Param>, Params...>,
+                                 QuerySplit<TypeList<Components..., Param>, TypeList<Filters...>, Params...>> {};
+
+        /**
+         * @brief Picks the BasicQuery behind a Query's parameters. A leading const Entity& prefixes each row with the entity.
+         * @tparam Params... The query's parameters.
+         */
+        template <typename... Params>
+        struct QueryBase {
+            using Split = QuerySplit<TypeList<>, TypeList<>, Params...>;                          ///< The sorted parameters.
+            using Type = BasicQuery<false, typename Split::Components, typename Split::Filters>;  ///< The BasicQuery.
+        };
+        template <typename... Params>
+        struct QueryBase<const Entity&, Params...> {
+            using Split = QuerySplit<TypeList<>, TypeList<>, Params...>;                         ///< The sorted parameters.
+            using Type = BasicQuery<true, typename Split::Components, typename Split::Filters>;  ///< The BasicQuery.
+        };
+
+        /**
+         * @brief A Query iterates over entities with specific components in a given World.
+         * It is a lazy view over the world's archetype tables: creating or iterating it does not allocate. A leading const Entity& includes
+         * the entity that owns each row, and filters such as Added<T> and Changed<T> narrow the query down to the entities that changed since
+         * the system last ran. Every mutable component handed out is marked as changed.
+         * @tparam Params... The components to query for, which must be reference types and be registered in the world, and the filters.
+         */
+        template <typename... Params>
+        class Query : public QueryBase<Params...>::Type {
+            using Base = typename QueryBase<Params...>::Type;  ///< The BasicQuery behind the query.
+
+            public:
+            using Base::Base;
         };
     }  // namespace core::ecs
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
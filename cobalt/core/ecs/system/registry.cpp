@@ -1,5 +1,5 @@
 /**
- * @file registry.h
+ * @file registry.cpp
  * @brief Storage for every system in the ECS.
  * @author Tomás Marques
  * @date 13-02-2024
@@ -9,18 +9,85 @@
 
 namespace cobalt {
     namespace core::ecs {
-        SystemRegistry::SystemRegistry(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
-                                       EventManager& eventManager) noexcept
-            : systems(),
+        SystemRegistry::SystemRegistry(const std::string& name, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry,
+                                       SystemManager& systemManager, EventManager& eventManager, core::thread::ThreadPool* threadPool) noexcept
+            : name(name),
+              systems(),
+              dependents(),
+              dependencies(),
+              remaining(),
+              finished(0),
+              exclusive(NO_SYSTEM),
               entityRegistry(entityRegistry),
               resourceRegistry(resourceRegistry),
               systemManager(systemManager),
-              eventManager(eventManager) {}
+              eventManager(eventManager),
+              threadPool(threadPool) {}
 
         void SystemRegistry::run() noexcept {
-            for (auto& system : systems) {
-                system->run();
+            if (!threadPool || threadPool->getThreadCount() == 0 || systems.size() < 2) {
+                for (auto& system : systems) {
+                    CB_PROFILE_SCOPE(system->getName(), name);
+                    system->run();
+                }
+                return;
             }
+            finished.store(0, std::memory_order_relaxed);
+            for (uint64 i = 0; i < systems.size(); i++) {
+                remaining[i].store(dependencies[i], std::memory_order_relaxed);
+            }
+            for (uint64 i = 0; i < systems.size(); i++) {
+                if (dependencies[i] == 0) {
+                    schedule(i);
+                }
+            }
+            // The calling thread helps out instead of blocking, so a schedule never takes longer than running it alone.
+            while (finished.load(std::memory_order_acquire) < systems.size()) {
+                const uint64 index = exclusive.exchange(NO_SYSTEM, std::memory_order_acq_rel);
+                if (index != NO_SYSTEM) {
+                    execute(index);
+                } else if (!threadPool->help()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void SystemRegistry::link(const std::string& name, const RunCondition& condition) noexcept {
+            const uint64 last = systems.size() - 1;
+            systems[last]->setName(name.empty() ? this->name + " #" + std::to_string(last) : name);
+            systems[last]->setCondition(condition);
+            dependents.emplace_back();
+            dependencies.push_back(0);
+            const SystemAccess& access = systems[last]->getAccess();
+            for (uint64 i = 0; i < last; i++) {
+                if (systems[i]->getAccess().conflicts(access)) {
+                    dependents[i].push_back(last);
+                    dependencies[last]++;
+                }
+            }
+            remaining = CreateScope<std::atomic<uint>[]>(systems.size());
+        }
+
+        void SystemRegistry::schedule(const uint64 index) noexcept {
+            if (systems[index]->getAccess().isExclusive()) {
+                // An exclusive system conflicts with every other, so nothing else can be running or waiting to run alongside it.
+                exclusive.store(index, std::memory_order_release);
+            } else {
+                threadPool->submit([this, index]() { execute(index); });
+            }
+        }
+
+        void SystemRegistry::execute(const uint64 index) noexcept {
+            {
+                CB_PROFILE_SCOPE(systems[index]->getName(), name);
+                systems[index]->run();
+            }
+            for (const uint64 dependent : dependents[index]) {
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    schedule(dependent);
+                }
+            }
+            finished.fetch_add(1, std::memory_order_release);
         }
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "core/ecs/system/system.h"
+#include "core/thread/pool.h"
+#include "core/utils/profiler.h"
 
 namespace cobalt {
     namespace core::ecs {
@@ -15,53 +17,95 @@ namespace cobalt {
         class ResourceRegistry;
         class SystemManager;
 
+        /**
+         * @brief Stores the systems of a schedule and runs them.
+         * As systems are added, each one is made to wait for every earlier system whose access conflicts with its own, so conflicting systems
+         * always run in the order they were added. With a thread pool, systems that don't depend on each other run in parallel. Exclusive systems
+         * can't overlap with any other, so they always run on the calling thread.
+         * With CB_PROFILING defined, every system's runs are recorded with the profiler under the system's name, in the registry's category.
+         */
         class SystemRegistry {
             public:
             /**
              * @brief Creates a new SystemRegistry.
+             * @param name The name of the registry, which unnamed systems are named after.
              * @param entityRegistry The EntityRegistry that the systems will run on.
              * @param resourceRegistry The ResourceRegistry that the systems will run on.
              * @param systemManager The SystemManager that owns this registry.
              * @param eventManager The EventManager that the systems will run on.
+             * @param threadPool The thread pool to run the systems on, or nullptr to run them one after the other on the calling thread.
              */
-            SystemRegistry(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
-                           EventManager& eventManager) noexcept;
+            SystemRegistry(const std::string& name, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                           EventManager& eventManager, core::thread::ThreadPool* threadPool = nullptr) noexcept;
 
             /**
              * @brief Adds a System (lambda function) to the registry.
              * @tparam SystemType The system type.
+             * @param name The name to profile the system under, or empty to name it after the registry and its position in it.
+             * @param condition The condition the system only runs under.
              */
             template <typename SystemType>
-            void addSystem() noexcept {
+            void addSystem(const std::string& name = "", const RunCondition& condition = RunCondition()) noexcept {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
                 systems.push_back(Move(CreateScope<SystemType>(entityRegistry, resourceRegistry, systemManager, eventManager)));
+                link(name, condition);
             }
             /**
              * @brief Adds a System (lambda function) to the registry.
              * @tparam Params... The lambda function parameters.
              * @tparam Func The lambda function type.
              * @param func The lambda function.
+             * @param name The name to profile the system under, or empty to name it after the registry and its position in it.
+             * @param condition The condition the system only runs under.
              * @see SystemParameter
              * @see Query, ReadRequest, WriteRequest, Commands
              */
             template <typename... Params, typename Func>
-            void addSystem(Func func) noexcept {
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addSystem(Func func, const std::string& name = "", const RunCondition& condition = RunCondition()) noexcept {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
                 systems.push_back(
                     Move(CreateScope<LambdaSystem<Func, Params...>>(func, entityRegistry, resourceRegistry, systemManager, eventManager)));
+                link(name, condition);
             }
 
             /**
-             * @brief Runs all the systems in the registry.
+             * @brief Runs all the systems in the registry. Returns once every system has finished.
              */
             void run() noexcept;
 
             private:
-            Vec<Scope<SystemInterface>> systems;  ///< The stored systems.
-            EntityRegistry& entityRegistry;       ///< The EntityRegistry that the systems will run on.
-            ResourceRegistry& resourceRegistry;   ///< The ResourceRegistry that the systems will run on.
-            SystemManager& systemManager;         ///< The SystemManager that owns this registry.
-            EventManager& eventManager;           ///< The EventManager that the systems will run on.
+            static inline constexpr uint64 NO_SYSTEM = num::MAX_UINT64;  ///< Marks that no exclusive system is waiting.
+
+            std::string name;                      ///< The name of the registry.
+            Vec<Scope<SystemInterface>> systems;   ///< The stored systems.
+            Vec<Vec<uint64>> dependents;           ///< The later systems that wait for each system.
+            Vec<uint> dependencies;                ///< The number of earlier systems each system waits for.
+            Scope<std::atomic<uint>[]> remaining;  ///< The number of dependencies each system is still waiting for in the current run.
+            std::atomic<uint64> finished;          ///< The number of systems that have finished in the current run.
+            std::atomic<uint64> exclusive;         ///< An exclusive system waiting to run on the calling thread, if any.
+            EntityRegistry& entityRegistry;        ///< The EntityRegistry that the systems will run on.
+            ResourceRegistry& resourceRegistry;    ///< The ResourceRegistry that the systems will run on.
+            SystemManager& systemManager;          ///< The SystemManager that owns this registry.
+            EventManager& eventManager;            ///< The EventManager that the systems will run on.
+            core::thread::ThreadPool* threadPool;  ///< The thread pool to run the systems on, if any.
+
+            /**
+             * @brief Names the last added system, sets its run condition and makes it wait for every earlier system it conflicts with.
+             * @param name The name of the system, or empty to name it after the registry and its position in it.
+             * @param condition The condition the system only runs under.
+             */
+            void link(const std::string& name, const RunCondition& condition) noexcept;
+            /**
+             * @brief Queues a system whose dependencies have all finished, either on the thread pool or, if exclusive, for the calling thread.
+             * @param index The system to queue.
+             */
+            void schedule(const uint64 index) noexcept;
+            /**
+             * @brief Runs a system and schedules the dependents it was the last dependency of.
+             * @param index The system to run.
+             */
+            void execute(const uint64 index) noexcept;
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file removed.h
+ * @brief A SystemParameter that lists the entities that recently lost a component.
+ * @author Tomás Marques
+ * @date 06-09-2024
+ */
+
+#pragma once
+
+#include "core/ecs/entity/registry.h"
+#include "core/ecs/system/parameter.h"
+
+namespace cobalt {
+    namespace core::ecs {
+        class ResourceRegistry;
+        class SystemManager;
+
+        /**
+         * @brief Walks a component's removal log, skipping the removals the system has already seen.
+         */
+        class RemovedIterator {
+            public:
+            using Removal = Pair<EntityProperties::ID, uint64>;  ///< A removed entity and the tick at which it happened.
+
+            /**
+             * @brief Creates a new RemovedIterator, positioned on the first unseen removal at or after the given one.
+             * @param removal The first removal to look at.
+             * @param end The end of the removal log.
+             * @param lastRun The tick at which the system last ran.
+             */
+            RemovedIterator(const Removal* removal, const Removal* end, const uint64 lastRun) noexcept
+                : removal(removal), end(end), lastRun(lastRun) {
+                seek();
+            }
+
+            /**
+             * @brief Gets the current entity.
+             * @return The ID of the entity that lost the component. It may have been killed since.
+             */
+            const EntityProperties::ID& operator*() const noexcept { return removal->first; }
+            /**
+             * @brief Advances to the next unseen removal.
+             * @return Reference to this.
+             */
+            RemovedIterator& operator++() noexcept {
+                ++removal;
+                seek();
+                return *this;
+            }
+            friend bool operator==(const RemovedIterator& a, const RemovedIterator& b) { return a.removal == b.removal; }
+            friend bool operator!=(const RemovedIterator& a, const RemovedIterator& b) { return !(a == b); }
+
+            private:
+            const Removal* removal;  ///< The current removal.
+            const Removal* end;      ///< The end of the removal log.
+            uint64 lastRun;          ///< The tick at which the system last ran.
+
+            /**
+             * @brief Skips the removals the system has already seen.
+             */
+            void seek() noexcept {
+                while (removal != end && removal->second <= lastRun) {
+                    ++removal;
+                }
+            }
+        };
+
+        /**
+         * @brief Removed lists the entities that lost a component since the system last ran, whether it was removed or the entity was killed.
+         * Unlike Added and Changed, it is a system parameter of its own rather than a query filter: the entities no longer have the component,
+         * so no query could match them. Removals are forgotten after a couple of frames.
+         * Example:
+         *
+         *          for (const EntityProperties::ID entity : removed) {
+         *              // Clean up whatever was tied to the entity's component.
+         *          }
+         *
+         * @tparam ComponentType The component type.
+         */
+        template <typename ComponentType>
+        class Removed : SystemParameter {
+            public:
+            /**
+             * @brief Creates a new Removed.
+             * @param entityRegistry The entity registry that holds the removal log.
+             * @param resourceRegistry The resource registry. Unused.
+             * @param systemManager The system manager. Unused.
+             * @param eventManager The event manager. Unused.
+             */
+            explicit Removed(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                             EventManager& eventManager) noexcept
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  index(entityRegistry.getComponentRegistry().template findIndex<ComponentType>()),
+                  lastRun(entityRegistry.getComponentRegistry().getTicks().lastRun) {
+                Component::validate<ComponentType>();
+            }
+            /**
+             * @brief Default destructor.
+             */
+            ~Removed() noexcept = default;
+
+            /**
+             * @brief Declares read access to the component, so the system is ordered against the ones that write it.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess& access) noexcept { access.readComponent(Component::getType<ComponentType>()); }
+
+            /**
+             * @brief Iterator over the IDs of the entities that lost the component since the system last ran.
+             */
+            RemovedIterator begin() const noexcept {
+                if (!index) {
+                    return end();
+                }
+                const auto& removals = entityRegistry.getComponentRegistry().getRemovals(*index);
+                return RemovedIterator(removals.data(), removals.data() + removals.size(), lastRun);
+            }
+            RemovedIterator end() const noexcept {
+                if (!index) {
+                    return RemovedIterator(nullptr, nullptr, lastRun);
+                }
+                const auto& removals = entityRegistry.getComponentRegistry().getRemovals(*index);
+                return RemovedIterator(removals.data() + removals.size(), removals.data() + removals.size(), lastRun);
+            }
+
+            private:
+            Opt<uint64> index;  ///< The component's index into the signature mask, if it is registered.
+            uint64 lastRun;     ///< The tick at which the system last ran.
+        };
+    }  // namespace core::ecs
+}  // namespace cobalt
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "core/ecs/entity/registry.h"
 #include "core/ecs/resource/registry.h"
 #include "core/ecs/system/parameter.h"
 
@@ -21,6 +22,8 @@ namespace cobalt {
         template <typename ResourceType>
         class ReadRequest : SystemParameter {
             public:
+            using State = ResourceSlot<const ResourceType>;  ///< The resource, cached by the system between runs.
+
             /**
              * @brief Creates a new ReadRequest.
              * @param entityRegistry The EntityRegistry that the request will run on. Unused.
@@ -33,11 +36,28 @@ namespace cobalt {
                   resource(resourceRegistry.get<const ResourceType&>()) {
                 Resource::validate<ResourceType>();
             }
+            /**
+             * @brief Creates a new ReadRequest through a cached slot, only looking the resource up if the registry changed since.
+             * @param state The cached slot.
+             * @param entityRegistry The EntityRegistry that the request will run on. Unused.
+             * @param resourceRegistry The ResourceRegistry that the request will run on.
+             * @param systemManager The SystemManager that the request will run on. Unused.
+             * @param eventManager The EventManager that the request will run on. Unused.
+             */
+            ReadRequest(State& state, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                        EventManager& eventManager)
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager), resource(resourceRegistry.get(state)) {}
             /**
              * @brief Default destructor.
              */
             ~ReadRequest() noexcept = default;
 
+            /**
+             * @brief Declares read access to the requested resource.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess& access) noexcept { access.readResource(Resource::getType<ResourceType>()); }
+
             /**
              * @brief Dereferences into the underlying resource directly.
              * @return The requested resource.
@@ -54,42 +74,75 @@ namespace cobalt {
         };
 
         /**
-         * @brief A WriteRequest provides read-write access to a resource.
+         * @brief A WriteRequest provides read-write access to a resource. Dereferencing it counts as changing the resource.
          * @tparam ResourceType The Resource type to write.
          */
         template <typename ResourceType>
         class WriteRequest : SystemParameter {
             public:
+            using State = ResourceSlot<ResourceType>;  ///< The resource, cached by the system between runs.
+
             /**
              * @brief Creates a new WriteRequest.
-             * @param entityRegistry The EntityRegistry that the request will run on. Unused.
+             * @param entityRegistry The EntityRegistry whose change tick stamps changes to the resource.
              * @param resourceRegistry The ResourceRegistry that the request will run on.
              * @param systemManager The SystemManager that the request will run on. Unused.
              * @param eventManager The EventManager that the request will run on. Unused.
              */
             explicit WriteRequest(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
                                   EventManager& eventManager)
-                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager), resource(resourceRegistry.get<ResourceType&>()) {
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  resource(resourceRegistry.get<ResourceType&>()),
+                  changeTick(resourceRegistry.getChangeTick(Resource::getType<ResourceType>())),
+                  tick(entityRegistry.getComponentRegistry().getTicks().thisRun) {
                 Resource::validate<ResourceType>();
             }
+            /**
+             * @brief Creates a new WriteRequest through a cached slot, only looking the resource up if the registry changed since.
+             * @param state The cached slot.
+             * @param entityRegistry The EntityRegistry whose change tick stamps changes to the resource.
+             * @param resourceRegistry The ResourceRegistry that the request will run on.
+             * @param systemManager The SystemManager that the request will run on. Unused.
+             * @param eventManager The EventManager that the request will run on. Unused.
+             */
+            WriteRequest(State& state, EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                         EventManager& eventManager)
+                : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager),
+                  resource(resourceRegistry.get(state)),
+                  changeTick(resourceRegistry.getChangeTick(Resource::getType<ResourceType>())),
+                  tick(entityRegistry.getComponentRegistry().getTicks().thisRun) {}
             /**
              * @brief Default destructor.
              */
             ~WriteRequest() noexcept = default;
 
             /**
-             * @brief Dereferences into the underlying resource directly.
+             * @brief Declares write access to the requested resource.
+             * @param access The access to declare into.
+             */
+            static void declare(SystemAccess& access) noexcept { access.writeResource(Resource::getType<ResourceType>()); }
+
+            /**
+             * @brief Dereferences into the underlying resource directly, marking it as changed.
              * @return The requested resource.
              */
-            ResourceType& operator*() { return resource; }
+            ResourceType& operator*() {
+                changeTick = tick;
+                return resource;
+            }
             /**
-             * @brief Dereferences into the underlying resource directly.
+             * @brief Dereferences into the underlying resource directly, marking it as changed.
              * @return The requested resource.
              */
-            ResourceType* operator->() { return &resource; }
+            ResourceType* operator->() {
+                changeTick = tick;
+                return &resource;
+            }
 
             private:
             ResourceType& resource;  ///< The requested resource.
+            uint64& changeTick;      ///< The tick at which the resource was last changed.
+            uint64 tick;             ///< The tick of the system run, stamped on the resource when it is changed.
         };
     }  // namespace core::ecs
 }  // namespace cobalt
\ No newline at end of file
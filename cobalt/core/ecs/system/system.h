@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include "core/ecs/system/condition.h"
+#include "core/ecs/system/events.h"
 #include "core/ecs/system/query.h"
+#include "core/ecs/system/removed.h"
 #include "core/ecs/system/request.h"
 
 namespace cobalt {
@@ -29,11 +32,54 @@ namespace cobalt {
              */
             virtual void run() = 0;
 
+            /**
+             * @brief Get the world data the system touches, used to decide which systems may run at the same time.
+             * @return The system's access.
+             */
+            const SystemAccess& getAccess() const noexcept { return access; }
+            /**
+             * @brief Get the name the system is profiled under.
+             * @return The system's name.
+             */
+            const std::string& getName() const noexcept { return name; }
+            /**
+             * @brief Set the name the system is profiled under.
+             * @param name The system's name.
+             */
+            void setName(const std::string& name) noexcept { this->name = name; }
+            /**
+             * @brief Set the condition the system only runs under. Its access is added to the system's, so it must be set before the
+             * system is scheduled.
+             * @param condition The condition.
+             */
+            void setCondition(const RunCondition& condition) noexcept {
+                this->condition = condition;
+                access.merge(condition.getAccess());
+            }
+
             protected:
             /**
-             * @brief Default constructor.
+             * @brief Default constructor. Nothing is known about what the system touches, so it is made exclusive.
+             */
+            SystemInterface() noexcept : access(), name(), condition() { access.setExclusive(); }
+            /**
+             * @brief Creates a system that touches the given world data.
+             * @param access The system's access.
+             */
+            explicit SystemInterface(SystemAccess&& access) noexcept : access(Move(access)), name(), condition() {}
+
+            /**
+             * @brief Checks the condition the system only runs under.
+             * @param resourceRegistry The resources of the world the system runs in.
+             * @param lastRun The tick of the system's last run, or 0 if it never ran.
+             * @return True if the system should run, false otherwise.
              */
-            SystemInterface() noexcept = default;
+            bool checkCondition(const ResourceRegistry& resourceRegistry, const uint64 lastRun) { return condition(resourceRegistry, lastRun); }
+
+            private:
+            SystemAccess access;     ///< The world data the system touches.
+            std::string name;        ///< The name the system is profiled under.
+            RunCondition condition;  ///< The condition the system only runs under.
         };
 
         /**
@@ -46,9 +92,12 @@ namespace cobalt {
         template <typename... Params>
         class System : public SystemInterface {
             static_assert((std::is_base_of<SystemParameter, Params>::value && ...), "All system parameters must derive from SystemParameter.");
-            static_assert(
-                (std::is_constructible<Params, EntityRegistry&, ResourceRegistry&, SystemManager&, EventManager&>::value && ...),
-                "All system parameters must be constructible with an EntityRegistry, a ResourceRegistry, a SystemManager and an EventManager.");
+            static_assert(((std::is_constructible<Params, EntityRegistry&, ResourceRegistry&, SystemManager&, EventManager&>::value ||
+                            std::is_constructible<Params, typename SystemParameterState<Params>::Type&, EntityRegistry&, ResourceRegistry&,
+                                                  SystemManager&, EventManager&>::value) &&
+                           ...),
+                          "All system parameters must be constructible with (their state,) an EntityRegistry, a ResourceRegistry, a SystemManager "
+                          "and an EventManager.");
 
             public:
             /**
@@ -60,16 +109,28 @@ namespace cobalt {
              */
             explicit System(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
                             EventManager& eventManager) noexcept
-                : entityRegistry(entityRegistry), resourceRegistry(resourceRegistry), systemManager(systemManager), eventManager(eventManager) {}
+                : SystemInterface(SystemAccess::from<Params...>()),
+                  entityRegistry(entityRegistry),
+                  resourceRegistry(resourceRegistry),
+                  systemManager(systemManager),
+                  eventManager(eventManager),
+                  lastRun(0),
+                  states() {}
             /**
              * @brief Default destructor.
              */
             virtual ~System() noexcept = default;
 
             /**
-             * @brief Runs the system.
+             * @brief Runs the system if its run condition holds. Change filters in its parameters see whatever changed since its previous run.
              */
-            void run() override { populateParams(std::make_index_sequence<sizeof...(Params)>{}); }
+            void run() override {
+                if (!this->checkCondition(resourceRegistry, lastRun)) {
+                    return;
+                }
+                lastRun = entityRegistry.getComponentRegistry().track(lastRun,
+                                                                      [this]() { populateParams(std::make_index_sequence<sizeof...(Params)>{}); });
+            }
 
             /**
              * @brief Runs the system on the given system parameters. Overload this function to implement custom logic.
@@ -80,11 +141,27 @@ namespace cobalt {
             virtual void run(Params... params) = 0;
 
             private:
-            EntityRegistry& entityRegistry;      ///< The EntityRegistry that the system will run on.
-            ResourceRegistry& resourceRegistry;  ///< The ResourceRegistry that the system will run on.
-            SystemManager& systemManager;        ///< The SystemManager that owns this system.
-            EventManager& eventManager;          ///< The EventManager that the system will run on.
+            EntityRegistry& entityRegistry;                                ///< The EntityRegistry that the system will run on.
+            ResourceRegistry& resourceRegistry;                            ///< The ResourceRegistry that the system will run on.
+            SystemManager& systemManager;                                  ///< The SystemManager that owns this system.
+            EventManager& eventManager;                                    ///< The EventManager that the system will run on.
+            uint64 lastRun;                                                ///< The tick of the system's previous run, or 0 if it never ran.
+            Tuple<typename SystemParameterState<Params>::Type...> states;  ///< What each parameter keeps between runs.
 
+            /**
+             * @brief Creates one system parameter, handing it its state if it has one.
+             * @tparam Param The system parameter.
+             * @param state The parameter's state.
+             * @return The parameter.
+             */
+            template <typename Param>
+            Param createParam(typename SystemParameterState<Param>::Type& state) {
+                if constexpr (requires { typename Param::State; }) {
+                    return Param(state, entityRegistry, resourceRegistry, systemManager, eventManager);
+                } else {
+                    return Param(entityRegistry, resourceRegistry, systemManager, eventManager);
+                }
+            }
             /**
              * @brief Automagically populates the system parameters.
              * @tparam Is... The indices of the system parameters.
@@ -93,7 +170,7 @@ namespace cobalt {
              */
             template <size_t... Is>
             void populateParams(std::index_sequence<Is...>) {
-                run(std::tuple_element_t<Is, Tuple<Params...>>(entityRegistry, resourceRegistry, systemManager, eventManager)...);
+                run(createParam<std::tuple_element_t<Is, Tuple<Params...>>>(std::get<Is>(states))...);
             }
         };
 
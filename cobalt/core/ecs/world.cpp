@@ -9,18 +9,35 @@
 
 namespace cobalt {
     namespace core::ecs {
-        World::World() noexcept
+        World::World(const uint threadCount, const MemoryConfig& memory) noexcept
             : entityRegistry(componentRegistry),
-              componentRegistry(),
+              componentRegistry(memory),
               resourceRegistry(),
-              systemManager(entityRegistry, resourceRegistry, eventManager),
-              eventManager(entityRegistry, resourceRegistry, systemManager) {}
+              systemManager(entityRegistry, resourceRegistry, eventManager, threadCount),
+              eventManager(entityRegistry, resourceRegistry, systemManager) {
+            resourceRegistry.add<JobSystem>(systemManager.getThreadPool());
+            resourceRegistry.add<FrameArena>();
+        }
 
         Entity& World::spawn() noexcept { return entityRegistry.add(); }
 
-        void World::registerEvent(const std::string& name, const std::string& description) noexcept { eventManager.registerEvent(name, description); }
+        void World::addSchedule(const std::string& name, const DefaultSchedules parent, const double rate) {
+            systemManager.addSchedule(name, parent, rate);
+        }
+
+        void World::setTimestep(const double seconds) noexcept { systemManager.setTimestep(seconds); }
+
+        Opt<Wrap<Entity>> World::getEntity(const EntityProperties::Handle handle) noexcept { return entityRegistry.get(handle); }
+
+        const Event& World::registerEvent(const std::string& name, const std::string& description) noexcept {
+            return eventManager.registerEvent(name, description);
+        }
+
+        bool World::triggerEvent(const std::string& eventName) noexcept { return eventManager.triggerEvent(eventName); }
+
+        bool World::triggerEvent(const Event& event) noexcept { return eventManager.triggerEvent(event); }
 
-        void World::triggerEvent(const std::string& eventName) noexcept { eventManager.triggerEvent(eventName); }
+        const EventQueueStats World::getEventQueueStats() const noexcept { return eventManager.getQueueStats(); }
 
         bool World::isPlugin(const std::string& title) const noexcept { return pluginManager.isPlugin(title); }
 
@@ -30,7 +47,9 @@ namespace cobalt {
         }
 
         void World::update() noexcept {
+            eventManager.updateChannels();
             eventManager.clearQueue();
+            entityRegistry.getComponentRegistry().flushRemovals();
             systemManager.update();
         }
 
@@ -10,6 +10,8 @@
 #include "core/ecs/event/manager.h"
 #include "core/ecs/plugin/bundle.h"
 #include "core/ecs/plugin/manager.h"
+#include "core/ecs/resource/arena.h"
+#include "core/ecs/system/commands.h"
 
 namespace cobalt {
     namespace core::ecs {
@@ -20,9 +22,12 @@ namespace cobalt {
             public:
             /**
              * @brief Create a new world.
+             * @param threadCount The number of worker threads used to run systems and jobs.
+             * @param memory Where to allocate components and tables from.
              * @return World instance.
              */
-            World() noexcept;
+            explicit World(const uint threadCount = core::thread::ThreadPool::getDefaultThreadCount(),
+                           const MemoryConfig& memory = MemoryConfig()) noexcept;
             /**
              * @brief Destroy the world. Releases all resources allocated for the ECS resources.
              */
@@ -33,6 +38,31 @@ namespace cobalt {
              * @return Entity instance.
              */
             Entity& spawn() noexcept;
+            /**
+             * @brief Spawn a batch of entities sharing the same components. Storage is reserved once and the components are written
+             * contiguously, which is much faster than spawning and adding to each entity one at a time.
+             * @tparam ComponentTypes... The component types.
+             * @param count The number of entities to spawn.
+             * @param components The components to copy into each entity.
+             * @return The new entities' handles.
+             */
+            template <typename... ComponentTypes>
+            Vec<EntityProperties::Handle> spawnBatch(const uint64 count, const ComponentTypes&... components) {
+                const Vec<EntityProperties::ID> entityIDs = entityRegistry.addBatch(count);
+                componentRegistry.fillBatch<ComponentTypes...>(entityIDs, components...);
+                Vec<EntityProperties::Handle> handles;
+                handles.reserve(count);
+                for (const EntityProperties::ID entityID : entityIDs) {
+                    handles.push_back(entityRegistry.get(entityID).getHandle());
+                }
+                return handles;
+            }
+            /**
+             * @brief Get the entity a handle refers to.
+             * @param handle The entity handle, as returned by Entity::getHandle().
+             * @return The entity, or None if it has been killed since the handle was created.
+             */
+            Opt<Wrap<Entity>> getEntity(const EntityProperties::Handle handle) noexcept;
 
             /**
              * @brief Register a component.
@@ -47,11 +77,13 @@ namespace cobalt {
              * @brief Add a system to the world.
              * @tparam SystemType The system type.
              * @param schedule Schedule to add the system to.
+             * @param name Name to profile the system under. Defaults to the schedule and the system's position in it.
+             * @param condition Condition the system only runs under. Defaults to always.
              */
             template <typename SystemType>
-            void addSystem(DefaultSchedules schedule) noexcept {
+            void addSystem(DefaultSchedules schedule, const std::string& name = "", const RunCondition& condition = RunCondition()) noexcept {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
-                systemManager.addSystem<SystemType>(schedule);
+                systemManager.addSystem<SystemType>(schedule, name, condition);
             }
             /**
              * @brief Add a system to the world.
@@ -59,22 +91,69 @@ namespace cobalt {
              * @tparam Func Lambda function type.
              * @param schedule Schedule to add the system to.
              * @param func Lambda function.
+             * @param name Name to profile the system under. Defaults to the schedule and the system's position in it.
+             * @param condition Condition the system only runs under. Defaults to always.
+             */
+            template <typename... Params, typename Func>
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addSystem(DefaultSchedules schedule, Func func, const std::string& name = "",
+                           const RunCondition& condition = RunCondition()) noexcept {
+                static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
+                systemManager.addSystem<Params...>(schedule, func, name, condition);
+            }
+            /**
+             * @brief Add a system to a custom schedule.
+             * @tparam SystemType The system type.
+             * @param schedule Name of the schedule to add the system to.
+             * @param name Name to profile the system under. Defaults to the schedule and the system's position in it.
+             * @param condition Condition the system only runs under. Defaults to always.
+             * @throws ScheduleNotFoundException If the schedule was never added.
+             */
+            template <typename SystemType>
+            void addSystem(const std::string& schedule, const std::string& name = "", const RunCondition& condition = RunCondition()) {
+                static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
+                systemManager.addSystem<SystemType>(schedule, name, condition);
+            }
+            /**
+             * @brief Add a system to a custom schedule.
+             * @tparam Params... Lambda function parameter types.
+             * @tparam Func Lambda function type.
+             * @param schedule Name of the schedule to add the system to.
+             * @param func Lambda function.
+             * @param name Name to profile the system under. Defaults to the schedule and the system's position in it.
+             * @param condition Condition the system only runs under. Defaults to always.
+             * @throws ScheduleNotFoundException If the schedule was never added.
              */
             template <typename... Params, typename Func>
-            void addSystem(DefaultSchedules schedule, Func func) noexcept {
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addSystem(const std::string& schedule, Func func, const std::string& name = "", const RunCondition& condition = RunCondition()) {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
-                systemManager.addSystem<Params...>(schedule, func);
+                systemManager.addSystem<Params...>(schedule, func, name, condition);
             }
+            /**
+             * @brief Add a custom schedule, which runs right after its parent every time the parent runs.
+             * @param name Name of the schedule.
+             * @param parent Schedule it runs after.
+             * @param rate How many times per second it runs, or 0 to run once every time its parent does.
+             * @throws DuplicateScheduleException If a schedule with the same name was already added.
+             */
+            void addSchedule(const std::string& name, const DefaultSchedules parent, const double rate = 0.0);
+            /**
+             * @brief Set how much time each update stands for, which fixed-rate schedules advance by.
+             * @param seconds Timestep in seconds.
+             */
+            void setTimestep(const double seconds) noexcept;
 
             /**
              * @brief Hook a system to an event.
              * @tparam SystemType The system type.
              * @param eventName Event to hook into.
+             * @param name Name to profile the hook under. Defaults to the event and the hook's position among its hooks.
              */
             template <typename SystemType>
-            void addHook(const std::string& eventName) noexcept {
+            void addHook(const std::string& eventName, const std::string& name = "") noexcept {
                 static_assert(std::is_base_of<SystemInterface, SystemType>::value, "System must be a subclass of SystemInterface.");
-                eventManager.addHook<SystemType>(eventName);
+                eventManager.addHook<SystemType>(eventName, name);
             }
             /**
              * @brief Hook a system to an event.
@@ -82,34 +161,68 @@ namespace cobalt {
              * @tparam Func Lambda function type.
              * @param eventName The event to hook into.
              * @param func Lambda function.
+             * @param name Name to profile the hook under. Defaults to the event and the hook's position among its hooks.
              */
             template <typename... Params, typename Func>
-            void addHook(const std::string& eventName, Func func) noexcept {
+                requires(!std::is_convertible_v<Func, std::string>)
+            void addHook(const std::string& eventName, Func func, const std::string& name = "") noexcept {
                 static_assert(std::is_invocable_r<void, Func, Params...>::value, "Func must be invocable with Params");
-                eventManager.addHook<Params...>(eventName, func);
+                eventManager.addHook<Params...>(eventName, func, name);
             }
             /**
              * @brief Register an event.
              * @param name The event's name.
              * @param description The event's description.
+             * @return An event handle.
              */
-            void registerEvent(const std::string& name, const std::string& description) noexcept;
+            const Event& registerEvent(const std::string& name, const std::string& description) noexcept;
             /**
-             * @brief Trigger an event.
+             * @brief Trigger an event. Safe to call from any thread, as long as no event is being registered at the same time.
              * @param eventName The event to trigger.
+             * @return True if the event was queued, false if it does not exist or the event queue was full.
+             */
+            bool triggerEvent(const std::string& eventName) noexcept;
+            /**
+             * @brief Trigger an event without looking it up by name. Safe to call from any thread.
+             * @param event The event handle, as returned by registerEvent.
+             * @return True if the event was queued, false if the event queue was full.
              */
-            void triggerEvent(const std::string& eventName) noexcept;
+            bool triggerEvent(const Event& event) noexcept;
+            /**
+             * @brief Get the event queue's backpressure statistics.
+             * @return The statistics.
+             */
+            const EventQueueStats getEventQueueStats() const noexcept;
+            /**
+             * @brief Register a typed event channel, so systems can send and read events of the type.
+             * @tparam EventType The event type.
+             * @see EventWriter, EventReader
+             */
+            template <typename EventType>
+            void registerEvent() noexcept {
+                eventManager.registerEvent<EventType>();
+            }
+            /**
+             * @brief Send a typed event from outside any system. It is read by the systems that run after this.
+             * @tparam EventType The event type.
+             * @param event The event.
+             */
+            template <typename EventType>
+            void sendEvent(EventType event) {
+                resourceRegistry.get<Events<EventType>&>().emplace(componentRegistry.getTicks().thisRun, Move(event));
+            }
 
             /**
-             * @brief Add a unique resource.
+             * @brief Add a unique resource. Counts as a change to it.
              * @tparam ResourceType The resource type.
              */
             template <typename ResourceType>
             void addResource() noexcept {
                 resourceRegistry.add<ResourceType>();
+                resourceRegistry.getChangeTick(Resource::getType<ResourceType>()) = componentRegistry.getTicks().thisRun;
             }
             /**
-             * @brief Add a resource with constructor arguments.
+             * @brief Add a resource with constructor arguments. Counts as a change to it.
              * @tparam ResourceType The resource type.
              * @tparam Args... Resource constructor argument types.
              * @param args Resource constructor arguments.
@@ -117,6 +230,7 @@ namespace cobalt {
             template <typename ResourceType, typename... Args>
             void addResource(Args&&... args) noexcept {
                 resourceRegistry.add<ResourceType>(std::forward<Args>(args)...);
+                resourceRegistry.getChangeTick(Resource::getType<ResourceType>()) = componentRegistry.getTicks().thisRun;
             }
 
             /**
@@ -137,6 +251,27 @@ namespace cobalt {
             const ResourceType& getResource() const {
                 return resourceRegistry.get<const ResourceType&>();
             }
+            /**
+             * @brief Get a resource through a cached slot, for code that gets the same resource every frame. It is only looked up again
+             * once a resource has been added since.
+             * @tparam ResourceType The resource type, const-qualified for read-only access.
+             * @param slot The slot.
+             * @return ResourceType The requested resource.
+             */
+            template <typename ResourceType>
+            ResourceType& getResource(ResourceSlot<ResourceType>& slot) {
+                return resourceRegistry.get(slot);
+            }
+
+            /**
+             * @brief Get the memory used by a component type, over every table. The component must be registered.
+             * @tparam ComponentType The component type.
+             * @return The memory usage.
+             */
+            template <typename ComponentType>
+            const core::memory::MemoryUsage& getMemoryUsage() const {
+                return componentRegistry.getMemoryUsage<ComponentType>();
+            }
 
             /**
              * @brief Find out if a given plugin is registered. The title must match exactly.
@@ -10,7 +10,7 @@
 
 namespace cobalt {
     namespace core::geom {
-        AABB::AABB() noexcept : min(FLT_MAX), max(FLT_MIN) {}
+        AABB::AABB() noexcept : min(FLT_MAX), max(-FLT_MAX) {}
 
         AABB::AABB(const glm::vec3& min, const glm::vec3& max) noexcept : min(min), max(max) {}
 
@@ -55,6 +55,11 @@ namespace cobalt {
 
         const glm::vec3 AABB::getCenter() const noexcept { return (min + max) / 2.0f; }
 
+        float AABB::getSurfaceArea() const noexcept {
+            const glm::vec3 size = glm::max(max - min, glm::vec3(0.0f));
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
         AABB::CompareAxis::CompareAxis(Axis axis) noexcept : axis(axis) {}
 
         bool AABB::CompareAxis::operator()(const AABB& a, const AABB& b) const noexcept {
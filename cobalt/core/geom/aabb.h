@@ -20,7 +20,7 @@ namespace cobalt {
         class AABB {
             public:
             /**
-             * @brief Creates an empty axis-aligned bounding box.
+             * @brief Creates an empty axis-aligned bounding box. Adding another box to it results in that box.
              */
             AABB() noexcept;
             /**
@@ -106,6 +106,12 @@ namespace cobalt {
              */
             const glm::vec3 getCenter() const noexcept;
 
+            /**
+             * @brief Gets the surface area of the box.
+             * @return The surface area, or 0 if the box is empty.
+             */
+            float getSurfaceArea() const noexcept;
+
             /**
              * @brief Enum class for specifying an axis in 3D space.
              */
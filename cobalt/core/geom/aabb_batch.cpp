@@ -0,0 +1,456 @@
+/**
+ * @file aabb_batch.cpp
+ * @brief A batch of axis-aligned bounding boxes laid out as a structure of arrays, so that a query box or frustum can be tested against many
+ * of them at once with SIMD instructions.
+ * @author Tomás Marques
+ * @date 19-09-2024
+ */
+
+#include "core/geom/aabb_batch.h"
+
+#if defined(__x86_64__)
+#define CB_BATCH_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CB_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace cobalt {
+    namespace core::geom {
+        namespace {
+            using Lanes = AABBBatch::Lanes;
+            using Kernel = AABBBatch::Kernel;
+
+            /**
+             * @brief The functions a kernel provides.
+             */
+            struct Kernels {
+                void (*intersects)(Vec<uint>& found, const Lanes& lanes, const AABB& query);  ///< Tests a query box against every box.
+                void (*cull)(Vec<uint>& found, const Lanes& lanes, const glm::vec4* planes);  ///< Tests a frustum against every box.
+                void (*getBounds)(const Lanes& lanes, glm::vec3& min, glm::vec3& max);        ///< Reduces every box to their bounds.
+            };
+
+            /**
+             * @brief Appends the indices of the set bits of a mask, skipping the padding past the end of the batch.
+             * @param found The indices found.
+             * @param mask The mask, one bit per box.
+             * @param first The index of the box in the mask's lowest bit.
+             * @param size The number of boxes in the batch.
+             */
+            inline void append(Vec<uint>& found, uint mask, const uint64 first, const uint64 size) noexcept {
+                while (mask) {
+                    const uint64 index = first + (uint64)__builtin_ctz(mask);
+                    if (index >= size) {
+                        return;
+                    }
+                    found.push_back((uint)index);
+                    mask &= mask - 1;
+                }
+            }
+
+            /**
+             * @brief Picks, for every plane, the coordinate arrays of the box corner furthest along the plane's normal. If that corner is
+             * outside the plane, so is the whole box.
+             * @param lanes The batch's arrays.
+             * @param planes The frustum's planes.
+             * @param corners The x, y and z arrays of each plane's corner.
+             */
+            void getCorners(const Lanes& lanes, const glm::vec4* planes, const float* corners[Frustum::PLANES][3]) noexcept {
+                for (uint p = 0; p < Frustum::PLANES; p++) {
+                    corners[p][0] = planes[p].x >= 0.0f ? lanes.maxX : lanes.minX;
+                    corners[p][1] = planes[p].y >= 0.0f ? lanes.maxY : lanes.minY;
+                    corners[p][2] = planes[p].z >= 0.0f ? lanes.maxZ : lanes.minZ;
+                }
+            }
+
+            void intersectsScalar(Vec<uint>& found, const Lanes& lanes, const AABB& query) {
+                const glm::vec3& min = query.getMin();
+                const glm::vec3& max = query.getMax();
+                for (uint64 i = 0; i < lanes.size; i++) {
+                    if (lanes.minX[i] <= max.x && lanes.maxX[i] >= min.x && lanes.minY[i] <= max.y && lanes.maxY[i] >= min.y &&
+                        lanes.minZ[i] <= max.z && lanes.maxZ[i] >= min.z) {
+                        found.push_back((uint)i);
+                    }
+                }
+            }
+
+            void cullScalar(Vec<uint>& found, const Lanes& lanes, const glm::vec4* planes) {
+                const float* corners[Frustum::PLANES][3];
+                getCorners(lanes, planes, corners);
+                for (uint64 i = 0; i < lanes.size; i++) {
+                    bool inside = true;
+                    for (uint p = 0; p < Frustum::PLANES && inside; p++) {
+                        inside = planes[p].x * corners[p][0][i] + planes[p].y * corners[p][1][i] + planes[p].z * corners[p][2][i] + planes[p].w >=
+                                 0.0f;
+                    }
+                    if (inside) {
+                        found.push_back((uint)i);
+                    }
+                }
+            }
+
+            void getBoundsScalar(const Lanes& lanes, glm::vec3& min, glm::vec3& max) {
+                for (uint64 i = 0; i < lanes.size; i++) {
+                    min = glm::min(min, glm::vec3(lanes.minX[i], lanes.minY[i], lanes.minZ[i]));
+                    max = glm::max(max, glm::vec3(lanes.maxX[i], lanes.maxY[i], lanes.maxZ[i]));
+                }
+            }
+
+#if defined(CB_BATCH_X86)
+            // SSE2 is part of x86-64, so these need no check. Each step tests two registers of four boxes.
+            void intersectsSSE2(Vec<uint>& found, const Lanes& lanes, const AABB& query) {
+                const __m128 minX = _mm_set1_ps(query.getMin().x), minY = _mm_set1_ps(query.getMin().y), minZ = _mm_set1_ps(query.getMin().z);
+                const __m128 maxX = _mm_set1_ps(query.getMax().x), maxY = _mm_set1_ps(query.getMax().y), maxZ = _mm_set1_ps(query.getMax().z);
+                for (uint64 i = 0; i < lanes.size; i += 8) {
+                    uint mask = 0;
+                    for (uint64 j = i; j < i + 8; j += 4) {
+                        __m128 in = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(lanes.minX + j), maxX), _mm_cmpge_ps(_mm_loadu_ps(lanes.maxX + j), minX));
+                        in = _mm_and_ps(in, _mm_cmple_ps(_mm_loadu_ps(lanes.minY + j), maxY));
+                        in = _mm_and_ps(in, _mm_cmpge_ps(_mm_loadu_ps(lanes.maxY + j), minY));
+                        in = _mm_and_ps(in, _mm_cmple_ps(_mm_loadu_ps(lanes.minZ + j), maxZ));
+                        in = _mm_and_ps(in, _mm_cmpge_ps(_mm_loadu_ps(lanes.maxZ + j), minZ));
+                        mask |= (uint)_mm_movemask_ps(in) << (j - i);
+                    }
+                    append(found, mask, i, lanes.size);
+                }
+            }
+
+            void cullSSE2(Vec<uint>& found, const Lanes& lanes, const glm::vec4* planes) {
+                const float* corners[Frustum::PLANES][3];
+                getCorners(lanes, planes, corners);
+                const __m128 zero = _mm_setzero_ps();
+                for (uint64 i = 0; i < lanes.size; i += 8) {
+                    uint mask = 0;
+                    for (uint64 j = i; j < i + 8; j += 4) {
+                        __m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                        for (uint p = 0; p < Frustum::PLANES; p++) {
+                            __m128 distance = _mm_mul_ps(_mm_set1_ps(planes[p].x), _mm_loadu_ps(corners[p][0] + j));
+                            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].y), _mm_loadu_ps(corners[p][1] + j)));
+                            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].z), _mm_loadu_ps(corners[p][2] + j)));
+                            distance = _mm_add_ps(distance, _mm_set1_ps(planes[p].w));
+                            in = _mm_and_ps(in, _mm_cmpge_ps(distance, zero));
+                        }
+                        mask |= (uint)_mm_movemask_ps(in) << (j - i);
+                    }
+                    append(found, mask, i, lanes.size);
+                }
+            }
+
+            /**
+             * @brief Reduces the four lanes of a register to their minimum or maximum.
+             */
+            inline float reduceMin(__m128 v) noexcept {
+                v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+                return _mm_cvtss_f32(_mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+            }
+            inline float reduceMax(__m128 v) noexcept {
+                v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+                return _mm_cvtss_f32(_mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+            }
+
+            void getBoundsSSE2(const Lanes& lanes, glm::vec3& min, glm::vec3& max) {
+                // The padding holds empty boxes, which leave the bounds as they are.
+                __m128 minX = _mm_set1_ps(FLT_MAX), minY = minX, minZ = minX;
+                __m128 maxX = _mm_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;
+                for (uint64 i = 0; i < lanes.size; i += 4) {
+                    minX = _mm_min_ps(minX, _mm_loadu_ps(lanes.minX + i));
+                    minY = _mm_min_ps(minY, _mm_loadu_ps(lanes.minY + i));
+                    minZ = _mm_min_ps(minZ, _mm_loadu_ps(lanes.minZ + i));
+                    maxX = _mm_max_ps(maxX, _mm_loadu_ps(lanes.maxX + i));
+                    maxY = _mm_max_ps(maxY, _mm_loadu_ps(lanes.maxY + i));
+                    maxZ = _mm_max_ps(maxZ, _mm_loadu_ps(lanes.maxZ + i));
+                }
+                min = glm::min(min, glm::vec3(reduceMin(minX), reduceMin(minY), reduceMin(minZ)));
+                max = glm::max(max, glm::vec3(reduceMax(maxX), reduceMax(maxY), reduceMax(maxZ)));
+            }
+
+            // AVX2 is compiled per function, so the rest of the engine doesn't need it, and only used if the CPU reports it. Each step tests
+            // two registers of eight boxes.
+            __attribute__((target("avx2"))) void intersectsAVX2(Vec<uint>& found, const Lanes& lanes, const AABB& query) {
+                const __m256 minX = _mm256_set1_ps(query.getMin().x), minY = _mm256_set1_ps(query.getMin().y);
+                const __m256 minZ = _mm256_set1_ps(query.getMin().z), maxX = _mm256_set1_ps(query.getMax().x);
+                const __m256 maxY = _mm256_set1_ps(query.getMax().y), maxZ = _mm256_set1_ps(query.getMax().z);
+                for (uint64 i = 0; i < lanes.size; i += 16) {
+                    uint mask = 0;
+                    for (uint64 j = i; j < i + 16; j += 8) {
+                        __m256 in = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(lanes.minX + j), maxX, _CMP_LE_OQ),
+                                                  _mm256_cmp_ps(_mm256_loadu_ps(lanes.maxX + j), minX, _CMP_GE_OQ));
+                        in = _mm256_and_ps(in, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(lanes.minY + j), maxY, _CMP_LE_OQ),
+                                                             _mm256_cmp_ps(_mm256_loadu_ps(lanes.maxY + j), minY, _CMP_GE_OQ)));
+                        in = _mm256_and_ps(in, _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(lanes.minZ + j), maxZ, _CMP_LE_OQ),
+                                                             _mm256_cmp_ps(_mm256_loadu_ps(lanes.maxZ + j), minZ, _CMP_GE_OQ)));
+                        mask |= (uint)_mm256_movemask_ps(in) << (j - i);
+                    }
+                    append(found, mask, i, lanes.size);
+                }
+            }
+
+            __attribute__((target("avx2"))) void cullAVX2(Vec<uint>& found, const Lanes& lanes, const glm::vec4* planes) {
+                const float* corners[Frustum::PLANES][3];
+                getCorners(lanes, planes, corners);
+                const __m256 zero = _mm256_setzero_ps();
+                for (uint64 i = 0; i < lanes.size; i += 16) {
+                    uint mask = 0;
+                    for (uint64 j = i; j < i + 16; j += 8) {
+                        __m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                        for (uint p = 0; p < Frustum::PLANES; p++) {
+                            __m256 distance = _mm256_mul_ps(_mm256_set1_ps(planes[p].x), _mm256_loadu_ps(corners[p][0] + j));
+                            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].y), _mm256_loadu_ps(corners[p][1] + j)));
+                            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].z), _mm256_loadu_ps(corners[p][2] + j)));
+                            distance = _mm256_add_ps(distance, _mm256_set1_ps(planes[p].w));
+                            in = _mm256_and_ps(in, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+                        }
+                        mask |= (uint)_mm256_movemask_ps(in) << (j - i);
+                    }
+                    append(found, mask, i, lanes.size);
+                }
+            }
+
+            __attribute__((target("avx2"))) inline float reduceMin(const __m256 v) noexcept {
+                return reduceMin(_mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+            }
+            __attribute__((target("avx2"))) inline float reduceMax(const __m256 v) noexcept {
+                return reduceMax(_mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+            }
+
+            __attribute__((target("avx2"))) void getBoundsAVX2(const Lanes& lanes, glm::vec3& min, glm::vec3& max) {
+                __m256 minX = _mm256_set1_ps(FLT_MAX), minY = minX, minZ = minX;
+                __m256 maxX = _mm256_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;
+                for (uint64 i = 0; i < lanes.size; i += 8) {
+                    minX = _mm256_min_ps(minX, _mm256_loadu_ps(lanes.minX + i));
+                    minY = _mm256_min_ps(minY, _mm256_loadu_ps(lanes.minY + i));
+                    minZ = _mm256_min_ps(minZ, _mm256_loadu_ps(lanes.minZ + i));
+                    maxX = _mm256_max_ps(maxX, _mm256_loadu_ps(lanes.maxX + i));
+                    maxY = _mm256_max_ps(maxY, _mm256_loadu_ps(lanes.maxY + i));
+                    maxZ = _mm256_max_ps(maxZ, _mm256_loadu_ps(lanes.maxZ + i));
+                }
+                min = glm::min(min, glm::vec3(reduceMin(minX), reduceMin(minY), reduceMin(minZ)));
+                max = glm::max(max, glm::vec3(reduceMax(maxX), reduceMax(maxY), reduceMax(maxZ)));
+            }
+#endif
+
+#if defined(CB_BATCH_NEON)
+            /**
+             * @brief Packs the lanes of a comparison into the low four bits of a mask, like SSE's movemask.
+             */
+            inline uint movemask(const uint32x4_t in) noexcept {
+                static const uint32_t bits[4] = {1, 2, 4, 8};
+                return vaddvq_u32(vandq_u32(in, vld1q_u32(bits)));
+            }
+
+            // Each step tests two registers of four boxes.
+            void intersectsNEON(Vec<uint>& found, const Lanes& lanes, const AABB& query) {
+                const float32x4_t minX = vdupq_n_f32(query.getMin().x), minY = vdupq_n_f32(query.getMin().y), minZ = vdupq_n_f32(query.getMin().z);
+                const float32x4_t maxX = vdupq_n_f32(query.getMax().x), maxY = vdupq_n_f32(query.getMax().y), maxZ = vdupq_n_f32(query.getMax().z);
+                for (uint64 i = 0; i < lanes.size; i += 8) {
+                    uint mask = 0;
+                    for (uint64 j = i; j < i + 8; j += 4) {
+                        uint32x4_t in = vandq_u32(vcleq_f32(vld1q_f32(lanes.minX + j), maxX), vcgeq_f32(vld1q_f32(lanes.maxX + j), minX));
+                        in = vandq_u32(in, vandq_u32(vcleq_f32(vld1q_f32(lanes.minY + j), maxY), vcgeq_f32(vld1q_f32(lanes.maxY + j), minY)));
+                        in = vandq_u32(in, vandq_u32(vcleq_f32(vld1q_f32(lanes.minZ + j), maxZ), vcgeq_f32(vld1q_f32(lanes.maxZ + j), minZ)));
+                        mask |= movemask(in) << (j - i);
+                    }
+                    append(found, mask, i, lanes.size);
+                }
+            }
+
+            void cullNEON(Vec<uint>& found, const Lanes& lanes, const glm::vec4* planes) {
+                const float* corners[Frustum::PLANES][3];
+                getCorners(lanes, planes, corners);
+                const float32x4_t zero = vdupq_n_f32(0.0f);
+                for (uint64 i = 0; i < lanes.size; i += 8) {
+                    uint mask = 0;
+                    for (uint64 j = i; j < i + 8; j += 4) {
+                        uint32x4_t in = vdupq_n_u32(~0u);
+                        for (uint p = 0; p < Frustum::PLANES; p++) {
+                            float32x4_t distance = vmulq_n_f32(vld1q_f32(corners[p][0] + j), planes[p].x);
+                            distance = vaddq_f32(distance, vmulq_n_f32(vld1q_f32(corners[p][1] + j), planes[p].y));
+                            distance = vaddq_f32(distance, vmulq_n_f32(vld1q_f32(corners[p][2] + j), planes[p].z));
+                            distance = vaddq_f32(distance, vdupq_n_f32(planes[p].w));
+                            in = vandq_u32(in, vcgeq_f32(distance, zero));
+                        }
+                        mask |= movemask(in) << (j - i);
+                    }
+                    append(found, mask, i, lanes.size);
+                }
+            }
+
+            void getBoundsNEON(const Lanes& lanes, glm::vec3& min, glm::vec3& max) {
+                float32x4_t minX = vdupq_n_f32(FLT_MAX), minY = minX, minZ = minX;
+                float32x4_t maxX = vdupq_n_f32(-FLT_MAX), maxY = maxX, maxZ = maxX;
+                for (uint64 i = 0; i < lanes.size; i += 4) {
+                    minX = vminq_f32(minX, vld1q_f32(lanes.minX + i));
+                    minY = vminq_f32(minY, vld1q_f32(lanes.minY + i));
+                    minZ = vminq_f32(minZ, vld1q_f32(lanes.minZ + i));
+                    maxX = vmaxq_f32(maxX, vld1q_f32(lanes.maxX + i));
+                    maxY = vmaxq_f32(maxY, vld1q_f32(lanes.maxY + i));
+                    maxZ = vmaxq_f32(maxZ, vld1q_f32(lanes.maxZ + i));
+                }
+                min = glm::min(min, glm::vec3(vminvq_f32(minX), vminvq_f32(minY), vminvq_f32(minZ)));
+                max = glm::max(max, glm::vec3(vmaxvq_f32(maxX), vmaxvq_f32(maxY), vmaxvq_f32(maxZ)));
+            }
+#endif
+
+            /**
+             * @brief Gets the functions of a kernel.
+             * @param kernel The kernel, which must be supported.
+             * @return The functions.
+             */
+            const Kernels& getKernels(const Kernel kernel) noexcept {
+                static const Kernels scalar = {intersectsScalar, cullScalar, getBoundsScalar};
+#if defined(CB_BATCH_X86)
+                static const Kernels sse2 = {intersectsSSE2, cullSSE2, getBoundsSSE2};
+                static const Kernels avx2 = {intersectsAVX2, cullAVX2, getBoundsAVX2};
+                if (kernel == Kernel::SSE2) {
+                    return sse2;
+                }
+                if (kernel == Kernel::AVX2) {
+                    return avx2;
+                }
+#elif defined(CB_BATCH_NEON)
+                static const Kernels neon = {intersectsNEON, cullNEON, getBoundsNEON};
+                if (kernel == Kernel::NEON) {
+                    return neon;
+                }
+#endif
+                return scalar;
+            }
+
+            /**
+             * @brief Gets the kernel every batch uses, picking the widest one the CPU supports the first time it is called.
+             * @return The kernel.
+             */
+            Kernel& getActiveKernel() noexcept {
+                static Kernel active = [] {
+                    for (const Kernel kernel : {Kernel::AVX2, Kernel::SSE2, Kernel::NEON}) {
+                        if (AABBBatch::isSupported(kernel)) {
+                            return kernel;
+                        }
+                    }
+                    return Kernel::Scalar;
+                }();
+                return active;
+            }
+        }  // namespace
+
+        AABBBatch::AABBBatch(const Vec<AABB>& boxes) noexcept {
+            reserve(boxes.size());
+            for (const AABB& box : boxes) {
+                push(box);
+            }
+        }
+
+        uint AABBBatch::push(const AABB& box) noexcept {
+            if (size == minX.size()) {
+                // Grow by a whole step of empty boxes, so the kernels never need to handle a partial one.
+                minX.resize(size + WIDTH, FLT_MAX);
+                minY.resize(size + WIDTH, FLT_MAX);
+                minZ.resize(size + WIDTH, FLT_MAX);
+                maxX.resize(size + WIDTH, -FLT_MAX);
+                maxY.resize(size + WIDTH, -FLT_MAX);
+                maxZ.resize(size + WIDTH, -FLT_MAX);
+            }
+            set((uint)size, box);
+            return (uint)size++;
+        }
+
+        void AABBBatch::set(const uint index, const AABB& box) noexcept {
+            minX[index] = box.getMin().x;
+            minY[index] = box.getMin().y;
+            minZ[index] = box.getMin().z;
+            maxX[index] = box.getMax().x;
+            maxY[index] = box.getMax().y;
+            maxZ[index] = box.getMax().z;
+        }
+
+        AABB AABBBatch::get(const uint index) const noexcept {
+            return AABB(glm::vec3(minX[index], minY[index], minZ[index]), glm::vec3(maxX[index], maxY[index], maxZ[index]));
+        }
+
+        void AABBBatch::reserve(const uint64 capacity) noexcept {
+            const uint64 padded = (capacity + WIDTH - 1) / WIDTH * WIDTH;
+            for (Vec<float>* lane : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+                lane->reserve(padded);
+            }
+        }
+
+        void AABBBatch::clear() noexcept {
+            for (Vec<float>* lane : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+                lane->clear();
+            }
+            size = 0;
+        }
+
+        uint64 AABBBatch::intersects(Vec<uint>& found, const AABB& query) const noexcept {
+            const uint64 before = found.size();
+            getKernels(getActiveKernel()).intersects(found, getLanes(), query);
+            return found.size() - before;
+        }
+
+        uint64 AABBBatch::contains(Vec<uint>& found, const glm::vec3& point) const noexcept {
+            // A box contains a point exactly when it intersects the empty-sized box at that point.
+            return intersects(found, AABB(point, point));
+        }
+
+        uint64 AABBBatch::intersects(Vec<uint>& found, const Frustum& frustum) const noexcept {
+            const uint64 before = found.size();
+            getKernels(getActiveKernel()).cull(found, getLanes(), frustum.getPlanes());
+            return found.size() - before;
+        }
+
+        AABB AABBBatch::getBounds() const noexcept {
+            glm::vec3 min(FLT_MAX);
+            glm::vec3 max(-FLT_MAX);
+            getKernels(getActiveKernel()).getBounds(getLanes(), min, max);
+            return AABB(min, max);
+        }
+
+        uint64 AABBBatch::getSize() const noexcept { return size; }
+
+        AABBBatch::Kernel AABBBatch::getKernel() noexcept { return getActiveKernel(); }
+
+        bool AABBBatch::setKernel(const Kernel kernel) noexcept {
+            if (!isSupported(kernel)) {
+                return false;
+            }
+            getActiveKernel() = kernel;
+            return true;
+        }
+
+        bool AABBBatch::isSupported(const Kernel kernel) noexcept {
+            switch (kernel) {
+                case Kernel::Scalar:
+                    return true;
+#if defined(CB_BATCH_X86)
+                case Kernel::SSE2:
+                    return true;
+                case Kernel::AVX2:
+                    return __builtin_cpu_supports("avx2");
+#elif defined(CB_BATCH_NEON)
+                case Kernel::NEON:
+                    return true;
+#endif
+                default:
+                    return false;
+            }
+        }
+
+        const char* AABBBatch::getName(const Kernel kernel) noexcept {
+            switch (kernel) {
+                case Kernel::SSE2:
+                    return "SSE2";
+                case Kernel::AVX2:
+                    return "AVX2";
+                case Kernel::NEON:
+                    return "NEON";
+                default:
+                    return "scalar";
+            }
+        }
+
+        AABBBatch::Lanes AABBBatch::getLanes() const noexcept {
+            return {minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data(), size};
+        }
+    }  // namespace core::geom
+}  // namespace cobalt
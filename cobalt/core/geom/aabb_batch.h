@@ -0,0 +1,171 @@
+/**
+ * @file aabb_batch.h
+ * @brief A batch of axis-aligned bounding boxes laid out as a structure of arrays, so that a query box or frustum can be tested against many
+ * of them at once with SIMD instructions.
+ * @author Tomás Marques
+ * @date 19-09-2024
+ */
+
+#pragma once
+
+#include "core/geom/frustum.h"
+
+namespace cobalt {
+    namespace core::geom {
+        /**
+         * @brief A batch of axis-aligned bounding boxes laid out as a structure of arrays: one array per coordinate of their minimum and
+         * maximum points. Broad-phase and culling loops test a single query against every box in the batch, which this layout lets SIMD
+         * kernels do 4 (SSE2, NEON) or 8 (AVX2) boxes per instruction, two registers at a time.
+         * The kernel is picked at runtime from what the CPU supports, with a scalar fallback everywhere else.
+         */
+        class AABBBatch {
+            public:
+            static inline constexpr uint64 WIDTH = 16;  ///< Every array is padded to a multiple of this many boxes, the most a kernel tests per step.
+
+            /**
+             * @brief Enum class for specifying the instruction set a batch's kernels run on.
+             */
+            enum class Kernel {
+                Scalar,  ///< Plain C++, one box at a time.
+                SSE2,    ///< x86 SSE2, four boxes per instruction.
+                AVX2,    ///< x86 AVX2, eight boxes per instruction.
+                NEON     ///< ARM NEON, four boxes per instruction.
+            };
+
+            /**
+             * @brief Creates an empty batch.
+             */
+            AABBBatch() noexcept = default;
+            /**
+             * @brief Creates a batch from a set of boxes.
+             * @param boxes The boxes.
+             */
+            explicit AABBBatch(const Vec<AABB>& boxes) noexcept;
+
+            /**
+             * @brief Adds a box to the end of the batch.
+             * @param box The box.
+             * @return The index of the box in the batch.
+             */
+            uint push(const AABB& box) noexcept;
+
+            /**
+             * @brief Replaces a box in the batch.
+             * @param index The index of the box.
+             * @param box The new box.
+             */
+            void set(const uint index, const AABB& box) noexcept;
+
+            /**
+             * @brief Gets a box in the batch.
+             * @param index The index of the box.
+             * @return The box.
+             */
+            AABB get(const uint index) const noexcept;
+
+            /**
+             * @brief Reserves space for a number of boxes.
+             * @param capacity The number of boxes.
+             */
+            void reserve(const uint64 capacity) noexcept;
+
+            /**
+             * @brief Removes every box from the batch.
+             */
+            void clear() noexcept;
+
+            /**
+             * @brief Finds every box in the batch that intersects with a query box. Two boxes intersect if they overlap in any way, or touch
+             * each other.
+             * @param found The indices of the boxes found, in increasing order, are appended here.
+             * @param query The query box.
+             * @return The number of boxes found.
+             */
+            uint64 intersects(Vec<uint>& found, const AABB& query) const noexcept;
+
+            /**
+             * @brief Finds every box in the batch that contains a point.
+             * @param found The indices of the boxes found, in increasing order, are appended here.
+             * @param point The point.
+             * @return The number of boxes found.
+             */
+            uint64 contains(Vec<uint>& found, const glm::vec3& point) const noexcept;
+
+            /**
+             * @brief Finds every box in the batch that is at least partially inside a frustum. Conservative, like Frustum::intersects.
+             * @param found The indices of the boxes found, in increasing order, are appended here.
+             * @param frustum The frustum.
+             * @return The number of boxes found.
+             */
+            uint64 intersects(Vec<uint>& found, const Frustum& frustum) const noexcept;
+
+            /**
+             * @brief Gets the smallest box containing every box in the batch.
+             * @return The box, empty if the batch is.
+             */
+            AABB getBounds() const noexcept;
+
+            /**
+             * @brief Gets the number of boxes in the batch.
+             * @return The number of boxes.
+             */
+            uint64 getSize() const noexcept;
+
+            /**
+             * @brief Gets the kernel the batches are currently using.
+             * @return The kernel.
+             */
+            static Kernel getKernel() noexcept;
+
+            /**
+             * @brief Sets the kernel every batch uses, overriding the one picked at startup. Meant for testing and benchmarking.
+             * @param kernel The kernel.
+             * @return Whether the kernel is supported, and was set.
+             */
+            static bool setKernel(const Kernel kernel) noexcept;
+
+            /**
+             * @brief Checks if the CPU and the build support a kernel.
+             * @param kernel The kernel.
+             * @return Whether the kernel is supported.
+             */
+            static bool isSupported(const Kernel kernel) noexcept;
+
+            /**
+             * @brief Gets the name of a kernel.
+             * @param kernel The kernel.
+             * @return The name.
+             */
+            static const char* getName(const Kernel kernel) noexcept;
+
+            /**
+             * @brief The coordinate arrays of a batch, as handed to the kernels. Each holds a multiple of WIDTH values, padded with empty
+             * boxes.
+             */
+            struct Lanes {
+                const float* minX;  ///< The minimum x coordinate of each box.
+                const float* minY;  ///< The minimum y coordinate of each box.
+                const float* minZ;  ///< The minimum z coordinate of each box.
+                const float* maxX;  ///< The maximum x coordinate of each box.
+                const float* maxY;  ///< The maximum y coordinate of each box.
+                const float* maxZ;  ///< The maximum z coordinate of each box.
+                uint64 size;        ///< The number of boxes, without the padding.
+            };
+
+            private:
+            Vec<float> minX;  ///< The minimum x coordinate of each box.
+            Vec<float> minY;  ///< The minimum y coordinate of each box.
+            Vec<float> minZ;  ///< The minimum z coordinate of each box.
+            Vec<float> maxX;  ///< The maximum x coordinate of each box.
+            Vec<float> maxY;  ///< The maximum y coordinate of each box.
+            Vec<float> maxZ;  ///< The maximum z coordinate of each box.
+            uint64 size = 0;  ///< The number of boxes, without the padding.
+
+            /**
+             * @brief Gets the batch's arrays for a kernel.
+             * @return The arrays.
+             */
+            Lanes getLanes() const noexcept;
+        };
+    }  // namespace core::geom
+}  // namespace cobalt
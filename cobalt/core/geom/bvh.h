@@ -1,6 +1,6 @@
 /**
  * @file bvh.h
- * @brief A bounding volume hierarchy is a tree structure on a set of geometric objects, most commonly used for collision detection and ray tracing.
+ * @brief A bounding volume hierarchy is a tree structure on a set of geometric objects, most commonly used for collision detection and ray tracing
  * acceleration.
  * @author Tomás Marques
  * @date 02-09-2024
@@ -8,7 +8,8 @@
 
 #pragma once
 
-#include "core/pch.h"
+#include "core/geom/strategy/split_strategy.h"
+#include "core/thread/pool.h"
 
 namespace cobalt {
     namespace core::geom {
@@ -16,102 +17,666 @@ namespace cobalt {
          * @brief A bounding volume hierarchy is a tree structure on a set of geometric objects, most commonly used for collision detection and ray
          * tracing. Being a tree, it has a root node, internal nodes and leaf nodes. The root node contains the entire set of objects, and each
          * internal node contains a bounding volume that encompasses all the objects in its child nodes.
-         * @tparam ElementType The type of the data stored in the BVH. Must have a bounding volume (even if null).
+         * The tree is flat: its nodes live in a single array in depth-first order, so a node's left child is the node right after it and only the
+         * right child's index is stored. Elements are reordered when building so that every leaf's elements, and their bounds, are contiguous.
+         * For moving elements, the tree can be refit to their new bounds instead of rebuilt, and updated to also rebuild the sub-trees that moving
+         * elements degraded the most, within a budget. Moving elements are usually handles to objects that live elsewhere, e.g. an entity or an
+         * index, whose bounds the bounds function looks up.
+         * Example:
+         *
+         *          BVH<Collider> bvh([](const Collider& collider) { return collider.getBounds(); });
+         *          bvh.build(colliders);
+         *          Vec<Wrap<Collider>> found;
+         *          bvh.query(found, AABB({0, 0, 0}, {1, 1, 1}));
+         *
+         * @tparam ElementType The type of the data stored in the BVH. Must be movable and have a bounding volume.
          */
         template <typename ElementType>
         class BVH {
             public:
-            BVH(const uint maxLeafSize) noexcept : maxLeafSize(maxLeafSize) {}
-
-            private:
             /**
-             * @brief A node in the BVH tree. Can be either an internal node or a leaf node.
+             * @brief A node in the BVH tree. Can be either an internal node or a leaf node. Two of them fit in a cache line.
              */
-            class BVHNode {
-                public:
+            struct Node {
+                glm::vec3 min;  ///< The minimum point of the node's bounds, which encompass all the elements in the node's subtree.
+                uint index;     ///< For leaves, the first element. For internal nodes, the right child. The left child is the next node.
+                glm::vec3 max;  ///< The maximum point of the node's bounds.
+                uint count;     ///< For leaves, the number of elements. 0 for internal nodes.
+
                 /**
                  * @brief Checks if the node is a leaf node.
-                 * @return
+                 * @return Whether the node is a leaf.
                  */
-                bool isLeaf() const noexcept { return !left && !right; }
-
+                bool isLeaf() const noexcept { return count > 0; }
                 /**
-                 * @brief Builds the BVH sub-tree from a set of elements, using a given split strategy.
-                 * @param elements The set of elements to build the BVH from.
-                 * @param splitStrategy The strategy to use for splitting the elements.
-                 * @see SplitStrategy
+                 * @brief Gets the bounds of the node.
+                 * @return The bounds.
                  */
-                void build(Vector<ElementType*> elements, const SplitStrategy<ElementType>& splitStrategy) {
-                    // Leaf node
-                    if (elements.size() <= maxLeafSize) {
-                        this->elements = Move(elements);
-                        AABB totalBounds;
-                        for (ElementType* element : this->elements) {
-                            totalBounds += element->getBounds();
+                AABB getBounds() const noexcept { return AABB(min, max); }
+            };
+            static_assert(sizeof(Node) == 32, "BVH nodes must be 32 bytes.");
+
+            /**
+             * @brief The element a ray hit first.
+             */
+            struct Hit {
+                Wrap<ElementType> element;  ///< The element.
+                float distance;             ///< How far along the ray its bounds were entered, in multiples of the ray's direction.
+            };
+
+            static inline constexpr uint MAX_DEPTH = 64;         ///< The maximum depth of the tree. Nodes this deep are always leaves.
+            static inline constexpr uint PARALLEL_GRAIN = 8192;  ///< When building in parallel, sub-trees with fewer elements are built by one task.
+
+            /**
+             * @brief Creates an empty BVH.
+             * @param getElementBounds The function to get an element's bounding box.
+             * @param maxLeafSize The maximum number of elements in a leaf. Must be at least 1.
+             */
+            BVH(Func<AABB(const ElementType&)> getElementBounds, const uint maxLeafSize = 4) noexcept
+                : getElementBounds(getElementBounds), maxLeafSize(std::max(1u, maxLeafSize)) {}
+            /**
+             * @brief Destroys the BVH.
+             */
+            ~BVH() noexcept = default;
+
+            /**
+             * @brief Builds the tree from a set of elements, replacing whatever it held before.
+             * @param elements The elements. There must be fewer than 2^32 of them.
+             * @param splitStrategy The strategy to use for splitting the elements.
+             * @see SplitStrategy
+             */
+            void build(Vec<ElementType> elements, const SplitStrategy& splitStrategy = SAHSplitStrategy()) {
+                Vec<SplitStrategy::Element> splitting = prepare(elements);
+                if (!splitting.empty()) {
+                    buildNode(splitStrategy, splitting, nodes, 0, (uint)splitting.size(), 0);
+                }
+                store(elements, splitting);
+            }
+            /**
+             * @brief Builds the tree from a set of elements on a thread pool, replacing whatever it held before. The left and right sub-trees of
+             * large nodes are built by different tasks, and the calling thread helps run them. The result is the same as building on one thread.
+             * @param elements The elements. There must be fewer than 2^32 of them.
+             * @param threadPool The thread pool to build on.
+             * @param splitStrategy The strategy to use for splitting the elements. Must be safe to call from several threads at once.
+             * @see SplitStrategy
+             */
+            void build(Vec<ElementType> elements, thread::ThreadPool& threadPool, const SplitStrategy& splitStrategy = SAHSplitStrategy()) {
+                Vec<SplitStrategy::Element> splitting = prepare(elements);
+                if (!splitting.empty()) {
+                    Subtree root;
+                    std::atomic<uint64> pending = 0;
+                    buildSubtree(threadPool, splitStrategy, splitting, root, 0, (uint)splitting.size(), 0, pending);
+                    while (pending.load(std::memory_order_acquire) > 0) {
+                        if (!threadPool.help()) {
+                            std::this_thread::yield();
                         }
-                        bounds = totalBounds;
-                        bounds.step();  // Expand the bounds slightly to avoid floating point errors.
-                        return;
                     }
-
-                    // Internal node
-                    Pair<Vec<ElementType*>, Vec<ElementType*>> split = splitStrategy.split(elements);
-                    left = CreateScope<BVHNode>();
-                    left->build(Move(split.first), splitStrategy);
-                    right = CreateScope<BVHNode>();
-                    right->build(Move(split.second), splitStrategy);
-                    bounds = left->bounds + right->bounds;
+                    flatten(root);
                 }
+                store(elements, splitting);
+            }
 
-                /**
-                 * @brief Queries the BVH for elements that intersect a given range. If a range is not provided, the function returns all elements in
-                 * the BVH.
-                 * @param found The vector to store the found elements in.
-                 * @param range The range to query. If not provided, the function returns all elements in the BVH.
-                 */
-                void query(Vec<ElementType*>& found, Opt<const AABB&> range = None) const {
-                    if (range.has_value() && !boundingBox.intersects(range.value())) return;
-
-                    if (leftChild && rightChild) {
-                        leftChild->query(range, found);
-                        rightChild->query(range, found);
+            /**
+             * @brief Re-reads the bounds of every element and updates every node's bounds to match, bottom-up, in linear time. The structure of
+             * the tree is kept, so queries stay correct as elements move, but get slower as nodes stretch to follow elements that drift apart.
+             */
+            void refit() {
+                for (uint i = 0; i < elements.size(); i++) {
+                    const AABB elementBounds = getElementBounds(elements[i]);
+                    bounds[i] = {elementBounds.getMin(), elementBounds.getMax()};
+                }
+                // Children always come after their parent.
+                for (uint i = (uint)nodes.size(); i-- > 0;) {
+                    Node& node = nodes[i];
+                    if (node.isLeaf()) {
+                        node.min = glm::vec3(FLT_MAX);
+                        node.max = glm::vec3(-FLT_MAX);
+                        for (uint element = node.index; element < node.index + node.count; element++) {
+                            node.min = glm::min(node.min, bounds[element].min);
+                            node.max = glm::max(node.max, bounds[element].max);
+                        }
                     } else {
-                        for (auto& obj : objects) {
-                            if (range.intersects(getBoundingBox(*obj))) {
-                                found.push_back(obj);
-                            }
+                        node.min = glm::min(nodes[i + 1].min, nodes[node.index].min);
+                        node.max = glm::max(nodes[i + 1].max, nodes[node.index].max);
+                    }
+                }
+            }
+            /**
+             * @brief Refits the tree, then rebuilds the sub-trees whose quality degraded past a threshold since they were built, as long as they
+             * fit in a budget. Quality is measured with the surface area heuristic: the expected cost of a query that reaches a sub-tree's root,
+             * which grows as its nodes stretch and overlap.
+             * Sub-trees are picked top-down, so a degraded sub-tree is rebuilt whole if the budget allows, and its degraded descendants otherwise.
+             * @param budget The maximum number of elements to rebuild sub-trees over. Rebuilding takes time roughly linear in it.
+             * @param threshold How much worse than when it was built a sub-tree must get to be rebuilt, e.g. 1.5 for 50% worse.
+             * @param splitStrategy The strategy to use for splitting the elements of rebuilt sub-trees.
+             * @return The number of elements sub-trees were rebuilt over.
+             */
+            uint64 update(const uint64 budget, const float threshold = 1.5f, const SplitStrategy& splitStrategy = SAHSplitStrategy()) {
+                refit();
+                if (nodes.empty()) {
+                    return 0;
+                }
+                measure(nodes, costs);
+
+                // Pick degraded sub-trees top-down, without picking any inside another.
+                Vec<Pair<uint, uint>> picked;
+                uint64 rebuilt = 0;
+                uint stack[MAX_DEPTH];
+                uint depths[MAX_DEPTH];
+                uint size = 0;
+                stack[size] = 0;
+                depths[size++] = 0;
+                while (size > 0) {
+                    size--;
+                    const uint index = stack[size];
+                    const uint depth = depths[size];
+                    const Node& node = nodes[index];
+                    if (node.isLeaf()) {
+                        continue;
+                    }
+                    if (quality[index] > 0.0f && normalize(node, costs[index]) > threshold * quality[index]) {
+                        const Node& last = nodes[getLastNode(index)];
+                        const uint64 count = last.index + last.count - getFirstElement(index);
+                        if (rebuilt + count <= budget) {
+                            picked.push_back({index, depth});
+                            rebuilt += count;
+                            continue;
                         }
                     }
+                    stack[size] = node.index;
+                    depths[size++] = depth + 1;
+                    stack[size] = index + 1;
+                    depths[size++] = depth + 1;
                 }
-                /**
-                 * @brief Queries the BVH for elements that contain a given point. If a point is not provided, the function returns all elements in
-                 * the BVH.
-                 * @param found The vector to store the found elements in.
-                 * @param point The point to query. If not provided, the function returns all elements in the BVH.
-                 */
-                void query(Vector<ElementType*>& found, Opt<const glm::vec3&> point = None) const {
-                    if (point.has_value() && !boundingBox.contains(point.value())) return;
 
-                    if (leftChild && rightChild) {
-                        leftChild->query(point, found);
-                        rightChild->query(point, found);
-                    } else {
-                        for (auto& obj : objects) {
-                            if (getBoundingBox(*obj).contains(point)) {
-                                found.push_back(obj);
+                if (picked.empty()) {
+                    return 0;
+                }
+                Vec<Rebuild> rebuilds;
+                rebuilds.reserve(picked.size());
+                for (const auto& [root, depth] : picked) {
+                    rebuilds.push_back(rebuild(root, depth, splitStrategy));
+                }
+                splice(rebuilds);
+                return rebuilt;
+            }
+
+            /**
+             * @brief Queries the BVH for elements that intersect a given range.
+             * @param found The vector to store the found elements in.
+             * @param range The range to query.
+             */
+            void query(Vec<Wrap<ElementType>>& found, const AABB& range) {
+                const glm::vec3& rangeMin = range.getMin();
+                const glm::vec3& rangeMax = range.getMax();
+                traverse(
+                    [&](const glm::vec3& min, const glm::vec3& max) {
+                        return min.x <= rangeMax.x && max.x >= rangeMin.x && min.y <= rangeMax.y && max.y >= rangeMin.y && min.z <= rangeMax.z &&
+                               max.z >= rangeMin.z;
+                    },
+                    [&](const uint element) { found.push_back(elements[element]); });
+            }
+            /**
+             * @brief Queries the BVH for elements that contain a given point.
+             * @param found The vector to store the found elements in.
+             * @param point The point to query.
+             */
+            void query(Vec<Wrap<ElementType>>& found, const glm::vec3& point) {
+                traverse(
+                    [&](const glm::vec3& min, const glm::vec3& max) {
+                        return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y && point.z >= min.z && point.z <= max.z;
+                    },
+                    [&](const uint element) { found.push_back(elements[element]); });
+            }
+            /**
+             * @brief Queries the BVH for elements whose bounds a ray crosses, in no particular order.
+             * @param found The vector to store the found elements in.
+             * @param origin Where the ray starts.
+             * @param direction Where the ray goes. Need not be normalized.
+             * @param maxDistance How far the ray goes, in multiples of its direction.
+             */
+            void raycast(Vec<Wrap<ElementType>>& found, const glm::vec3& origin, const glm::vec3& direction, const float maxDistance = FLT_MAX) {
+                const glm::vec3 inverse = 1.0f / direction;
+                float distance;
+                traverse([&](const glm::vec3& min, const glm::vec3& max) { return crosses(min, max, origin, inverse, maxDistance, distance); },
+                         [&](const uint element) { found.push_back(elements[element]); });
+            }
+            /**
+             * @brief Finds the element whose bounds a ray enters first. Near children are visited first, and subtrees the ray enters after the
+             * closest hit so far are skipped.
+             * @param origin Where the ray starts.
+             * @param direction Where the ray goes. Need not be normalized.
+             * @param maxDistance How far the ray goes, in multiples of its direction.
+             * @return The hit, or nothing if the ray doesn't cross any element's bounds.
+             */
+            Opt<Hit> raycast(const glm::vec3& origin, const glm::vec3& direction, const float maxDistance = FLT_MAX) {
+                if (nodes.empty()) {
+                    return None;
+                }
+                const glm::vec3 inverse = 1.0f / direction;
+                float closest = maxDistance;
+                uint hit = UINT32_MAX;
+                uint stack[MAX_DEPTH];
+                float entries[MAX_DEPTH];
+                uint size = 0;
+                float entry;
+                if (crosses(nodes[0].min, nodes[0].max, origin, inverse, closest, entry)) {
+                    stack[size] = 0;
+                    entries[size++] = entry;
+                }
+                while (size > 0) {
+                    size--;
+                    if (entries[size] > closest) {
+                        continue;
+                    }
+                    const Node& node = nodes[stack[size]];
+                    if (node.isLeaf()) {
+                        for (uint element = node.index; element < node.index + node.count; element++) {
+                            if (crosses(bounds[element].min, bounds[element].max, origin, inverse, closest, entry) &&
+                                (hit == UINT32_MAX || entry < closest)) {
+                                closest = entry;
+                                hit = element;
                             }
                         }
+                        continue;
                     }
+                    const uint left = stack[size] + 1;
+                    const uint right = node.index;
+                    float leftEntry, rightEntry;
+                    const bool hitsLeft = crosses(nodes[left].min, nodes[left].max, origin, inverse, closest, leftEntry);
+                    const bool hitsRight = crosses(nodes[right].min, nodes[right].max, origin, inverse, closest, rightEntry);
+                    // Push the far child first so the near one is visited next.
+                    if (hitsLeft && hitsRight) {
+                        const bool leftFirst = leftEntry <= rightEntry;
+                        stack[size] = leftFirst ? right : left;
+                        entries[size++] = leftFirst ? rightEntry : leftEntry;
+                        stack[size] = leftFirst ? left : right;
+                        entries[size++] = leftFirst ? leftEntry : rightEntry;
+                    } else if (hitsLeft || hitsRight) {
+                        stack[size] = hitsLeft ? left : right;
+                        entries[size++] = hitsLeft ? leftEntry : rightEntry;
+                    }
+                }
+                if (hit == UINT32_MAX) {
+                    return None;
+                }
+                return Hit{elements[hit], closest};
+            }
+
+            /**
+             * @brief Gets the number of elements in the BVH.
+             * @return The number of elements.
+             */
+            uint64 getSize() const noexcept { return elements.size(); }
+            /**
+             * @brief Gets the elements in the BVH, in leaf order.
+             * @return The elements.
+             */
+            const Vec<ElementType>& getElements() const noexcept { return elements; }
+            /**
+             * @brief Gets the expected cost of a query that reaches the root, as estimated by the surface area heuristic. Lower is better, and
+             * elements drifting apart after the tree was built make it grow.
+             * @return The cost, or 0 if the tree is empty.
+             */
+            float getCost() const {
+                if (nodes.empty()) {
+                    return 0.0f;
                 }
+                Vec<float> measured;
+                measure(nodes, measured);
+                return normalize(nodes[0], measured[0]);
+            }
+            /**
+             * @brief Gets the nodes of the tree, in depth-first order. The first one is the root.
+             * @return The nodes.
+             */
+            const Vec<Node>& getNodes() const noexcept { return nodes; }
 
-                private:
-                AABB bounds;                 ///< The bounding volume of the node. Encompasses all the elements in the node's subtree.
-                Scope<BVHNode> left;         ///< The left child node.
-                Scope<BVHNode> right;        ///< The right child node.
-                Vec<ElementType*> elements;  ///< The elements in the node. Only present in leaf nodes.
+            private:
+            /**
+             * @brief The bounds of an element, kept next to the others so leaves can be checked without touching the elements.
+             */
+            struct Bounds {
+                glm::vec3 min;  ///< The minimum point of the element's bounds.
+                glm::vec3 max;  ///< The maximum point of the element's bounds.
             };
 
-            const uint maxLeafSize;
+            Func<AABB(const ElementType&)> getElementBounds;  ///< The function to get an element's bounding box.
+            const uint maxLeafSize;                           ///< The maximum number of elements in a leaf.
+            Vec<Node> nodes;                                  ///< The nodes, in depth-first order.
+            Vec<ElementType> elements;                        ///< The elements, in leaf order.
+            Vec<Bounds> bounds;                               ///< The bounds of every element, in leaf order.
+            Vec<float> quality;                               ///< The cost of every node when it was built, as measured by normalize().
+            Vec<float> costs;                                 ///< The cost of every node, measured when updating.
+            Vec<Node> spliced;                                ///< The nodes being spliced together when updating.
+            Vec<float> splicedQuality;                        ///< The quality of the nodes being spliced together when updating.
+
+            /**
+             * @brief A sub-tree being built in parallel. Large ones are split between two tasks, and small ones are built by a single task into
+             * their own array. Once every task is done, they are flattened into the tree in depth-first order.
+             */
+            struct Subtree {
+                Vec<Node> nodes;       ///< The nodes, if the sub-tree was built by a single task. Their indices are relative to its root.
+                Scope<Subtree> left;   ///< The left sub-tree, if the sub-tree was split between two tasks.
+                Scope<Subtree> right;  ///< The right sub-tree, if the sub-tree was split between two tasks.
+            };
+
+            /**
+             * @brief Clears the tree and gathers the bounds of the elements it is about to be built from.
+             * @param elements The elements.
+             * @return The elements to split, in their original order.
+             */
+            Vec<SplitStrategy::Element> prepare(const Vec<ElementType>& elements) {
+                nodes.clear();
+                bounds.clear();
+                this->elements.clear();
+                const uint count = (uint)elements.size();
+                Vec<SplitStrategy::Element> splitting(count);
+                for (uint i = 0; i < count; i++) {
+                    const AABB elementBounds = getElementBounds(elements[i]);
+                    splitting[i] = {elementBounds.getMin(), elementBounds.getMax(), elementBounds.getCenter(), i};
+                }
+                nodes.reserve(count == 0 ? 0 : 2 * (uint64)count - 1);
+                return splitting;
+            }
+
+            /**
+             * @brief Stores the elements in leaf order once the tree is built.
+             * @param elements The elements, in their original order.
+             * @param splitting The elements after splitting, in leaf order.
+             */
+            void store(Vec<ElementType>& elements, const Vec<SplitStrategy::Element>& splitting) {
+                this->elements.reserve(splitting.size());
+                bounds.reserve(splitting.size());
+                for (const SplitStrategy::Element& element : splitting) {
+                    this->elements.push_back(Move(elements[element.index]));
+                    bounds.push_back({element.min, element.max});
+                }
+                measure(nodes, quality);
+                for (uint i = 0; i < nodes.size(); i++) {
+                    quality[i] = normalize(nodes[i], quality[i]);
+                }
+            }
+
+            /**
+             * @brief Builds the BVH sub-tree from a range of elements, appending its nodes.
+             * @param splitStrategy The strategy to use for splitting the elements.
+             * @param elements The elements in leaf order so far. The range is reordered.
+             * @param built The nodes to append to. The sub-tree's indices are relative to the start of this array.
+             * @param first The first element of the range.
+             * @param count The number of elements in the range.
+             * @param depth The depth of the sub-tree's root.
+             * @return The index of the sub-tree's root.
+             */
+            uint buildNode(const SplitStrategy& splitStrategy, Vec<SplitStrategy::Element>& elements, Vec<Node>& built, const uint first,
+                           const uint count, const uint depth) const {
+                const uint index = (uint)built.size();
+                if (count <= maxLeafSize || depth + 1 >= MAX_DEPTH) {
+                    glm::vec3 min(FLT_MAX);
+                    glm::vec3 max(-FLT_MAX);
+                    for (uint i = first; i < first + count; i++) {
+                        min = glm::min(min, elements[i].min);
+                        max = glm::max(max, elements[i].max);
+                    }
+                    built.push_back({min, first, max, count});
+                    return index;
+                }
+                built.emplace_back();
+                const uint split = (uint)splitStrategy.split(elements.data() + first, count);
+                const uint left = buildNode(splitStrategy, elements, built, first, split, depth + 1);
+                const uint right = buildNode(splitStrategy, elements, built, first + split, count - split, depth + 1);
+                built[index] = {glm::min(built[left].min, built[right].min), right, glm::max(built[left].max, built[right].max), 0};
+                return index;
+            }
+
+            /**
+             * @brief Builds a sub-tree in parallel: large ones are split here, with the left half queued as a new task and the right half built
+             * on the calling thread. Small ones are built in one go.
+             * @param threadPool The thread pool to queue tasks on.
+             * @param splitStrategy The strategy to use for splitting the elements.
+             * @param elements The elements in leaf order so far. The range is reordered.
+             * @param subtree The sub-tree to build.
+             * @param first The first element of the range.
+             * @param count The number of elements in the range.
+             * @param depth The depth of the sub-tree's root.
+             * @param pending The number of queued tasks that haven't finished yet.
+             */
+            void buildSubtree(thread::ThreadPool& threadPool, const SplitStrategy& splitStrategy, Vec<SplitStrategy::Element>& elements,
+                              Subtree& subtree, const uint first, const uint count, const uint depth, std::atomic<uint64>& pending) const {
+                if (count < PARALLEL_GRAIN || count <= maxLeafSize || depth + 1 >= MAX_DEPTH) {
+                    buildNode(splitStrategy, elements, subtree.nodes, first, count, depth);
+                    return;
+                }
+                const uint split = (uint)splitStrategy.split(elements.data() + first, count);
+                subtree.left = CreateScope<Subtree>();
+                subtree.right = CreateScope<Subtree>();
+                pending.fetch_add(1, std::memory_order_relaxed);
+                threadPool.submit([this, &threadPool, &splitStrategy, &elements, &subtree, first, split, depth, &pending]() {
+                    buildSubtree(threadPool, splitStrategy, elements, *subtree.left, first, split, depth + 1, pending);
+                    pending.fetch_sub(1, std::memory_order_release);
+                });
+                buildSubtree(threadPool, splitStrategy, elements, *subtree.right, first + split, count - split, depth + 1, pending);
+            }
+
+            /**
+             * @brief Appends a sub-tree built in parallel to the tree, in depth-first order.
+             * @param subtree The sub-tree.
+             * @return The index of the sub-tree's root.
+             */
+            uint flatten(Subtree& subtree) {
+                const uint index = (uint)nodes.size();
+                if (!subtree.left) {
+                    for (Node node : subtree.nodes) {
+                        node.index += node.isLeaf() ? 0 : index;
+                        nodes.push_back(node);
+                    }
+                    return index;
+                }
+                nodes.emplace_back();
+                const uint left = flatten(*subtree.left);
+                const uint right = flatten(*subtree.right);
+                nodes[index] = {glm::min(nodes[left].min, nodes[right].min), right, glm::max(nodes[left].max, nodes[right].max), 0};
+                return index;
+            }
+
+            /**
+             * @brief Measures the cost of every node with the surface area heuristic: a node costs its surface area, times its number of elements
+             * if it is a leaf, plus the cost of its children.
+             * @param tree The nodes, in depth-first order, with indices relative to the first one.
+             * @param measured Set to the cost of every node.
+             */
+            static void measure(const Vec<Node>& tree, Vec<float>& measured) {
+                measured.resize(tree.size());
+                for (uint i = (uint)tree.size(); i-- > 0;) {
+                    const Node& node = tree[i];
+                    const float area = getArea(node);
+                    measured[i] = node.isLeaf() ? area * (float)node.count : area + measured[i + 1] + measured[node.index];
+                }
+            }
+            /**
+             * @brief Normalizes the cost of a node by its surface area, which makes it the expected cost of a query that reaches it. Unlike the
+             * cost itself, it doesn't change when the node just moves or scales.
+             * @param node The node.
+             * @param cost The cost of the node, as measured by measure().
+             * @return The normalized cost, or 0 if the node has no area.
+             */
+            static float normalize(const Node& node, const float cost) noexcept {
+                const float area = getArea(node);
+                return area > 0.0f ? cost / area : 0.0f;
+            }
+            /**
+             * @brief Gets the surface area of a node.
+             * @param node The node.
+             * @return The surface area.
+             */
+            static float getArea(const Node& node) noexcept { return AABB(node.min, node.max).getSurfaceArea(); }
+
+            /**
+             * @brief Gets the last node of a sub-tree: its right-most leaf.
+             * @param index The sub-tree's root.
+             * @return The index of the last node.
+             */
+            uint getLastNode(uint index) const noexcept {
+                while (!nodes[index].isLeaf()) {
+                    index = nodes[index].index;
+                }
+                return index;
+            }
+            /**
+             * @brief Gets the first element of a sub-tree, that of its left-most leaf.
+             * @param index The sub-tree's root.
+             * @return The index of the first element.
+             */
+            uint getFirstElement(uint index) const noexcept {
+                while (!nodes[index].isLeaf()) {
+                    index++;
+                }
+                return nodes[index].index;
+            }
+
+            /**
+             * @brief A sub-tree rebuilt by update(), waiting to replace the old one.
+             */
+            struct Rebuild {
+                uint root;                ///< The old sub-tree's root.
+                uint last;                ///< The old sub-tree's last node.
+                Vec<Node> nodes;          ///< The new nodes. Their child indices are relative to the sub-tree's root.
+                Vec<float> builtQuality;  ///< The cost of every new node, as measured by normalize().
+            };
+
+            /**
+             * @brief Rebuilds a sub-tree from its elements' current bounds. Its elements are reordered within the range they span, but its new
+             * nodes are only returned, to be spliced into the tree along with the others.
+             * @param root The sub-tree's root.
+             * @param depth The depth of the sub-tree's root.
+             * @param splitStrategy The strategy to use for splitting the elements.
+             * @return The rebuilt sub-tree.
+             */
+            Rebuild rebuild(const uint root, const uint depth, const SplitStrategy& splitStrategy) {
+                Rebuild result = {root, getLastNode(root), {}, {}};
+                const uint first = getFirstElement(root);
+                const uint count = nodes[result.last].index + nodes[result.last].count - first;
+                Vec<SplitStrategy::Element> splitting(count);
+                for (uint i = 0; i < count; i++) {
+                    const Bounds& elementBounds = bounds[first + i];
+                    splitting[i] = {elementBounds.min, elementBounds.max, (elementBounds.min + elementBounds.max) * 0.5f, first + i};
+                }
+                result.nodes.reserve(2 * (uint64)count - 1);
+                buildNode(splitStrategy, splitting, result.nodes, 0, count, depth);
+                measure(result.nodes, result.builtQuality);
+                for (uint i = 0; i < result.nodes.size(); i++) {
+                    result.builtQuality[i] = normalize(result.nodes[i], result.builtQuality[i]);
+                    result.nodes[i].index += result.nodes[i].isLeaf() ? first : 0;
+                }
+
+                Vec<ElementType> reordered;
+                reordered.reserve(count);
+                for (const SplitStrategy::Element& element : splitting) {
+                    reordered.push_back(Move(elements[element.index]));
+                }
+                for (uint i = 0; i < count; i++) {
+                    elements[first + i] = Move(reordered[i]);
+                    bounds[first + i] = {splitting[i].min, splitting[i].max};
+                }
+                return result;
+            }
+
+            /**
+             * @brief Replaces rebuilt sub-trees' old nodes with their new ones in a single pass, shifting the nodes between them if there are
+             * more or fewer of them.
+             * @param rebuilds The rebuilt sub-trees, in the order they appear in the tree. None can be inside another.
+             */
+            void splice(Vec<Rebuild>& rebuilds) {
+                // The shift of every node after each rebuilt sub-tree.
+                Vec<int64> shifts(rebuilds.size());
+                int64 shift = 0;
+                for (uint i = 0; i < rebuilds.size(); i++) {
+                    shift += (int64)rebuilds[i].nodes.size() - (int64)(rebuilds[i].last + 1 - rebuilds[i].root);
+                    shifts[i] = shift;
+                }
+                const auto remap = [&](const uint index) {
+                    const auto after = std::lower_bound(rebuilds.begin(), rebuilds.end(), index,
+                                                        [](const Rebuild& rebuild, const uint index) { return rebuild.last < index; });
+                    return after == rebuilds.begin() ? index : (uint)((int64)index + shifts[after - rebuilds.begin() - 1]);
+                };
+
+                spliced.clear();
+                splicedQuality.clear();
+                spliced.reserve((uint64)((int64)nodes.size() + shift));
+                splicedQuality.reserve(spliced.capacity());
+                uint next = 0;
+                for (uint i = 0; i < nodes.size();) {
+                    if (next < rebuilds.size() && i == rebuilds[next].root) {
+                        const uint root = (uint)spliced.size();
+                        for (Node node : rebuilds[next].nodes) {
+                            node.index += node.isLeaf() ? 0 : root;
+                            spliced.push_back(node);
+                        }
+                        splicedQuality.insert(splicedQuality.end(), rebuilds[next].builtQuality.begin(), rebuilds[next].builtQuality.end());
+                        i = rebuilds[next++].last + 1;
+                        continue;
+                    }
+                    Node node = nodes[i];
+                    node.index = node.isLeaf() ? node.index : remap(node.index);
+                    spliced.push_back(node);
+                    splicedQuality.push_back(quality[i++]);
+                }
+                // Keep the old arrays around, so the next update doesn't have to allocate.
+                std::swap(nodes, spliced);
+                std::swap(quality, splicedQuality);
+            }
+
+            /**
+             * @brief Visits every element whose bounds overlap something, skipping the sub-trees whose bounds don't.
+             * @param overlaps Whether a box, given by its minimum and maximum points, overlaps what's being looked for.
+             * @param visit What to do with each overlapping element, given its index.
+             */
+            template <typename OverlapsFunc, typename VisitFunc>
+            void traverse(OverlapsFunc&& overlaps, VisitFunc&& visit) const {
+                if (nodes.empty()) {
+                    return;
+                }
+                uint stack[MAX_DEPTH];
+                uint size = 0;
+                stack[size++] = 0;
+                while (size > 0) {
+                    const uint index = stack[--size];
+                    const Node& node = nodes[index];
+                    if (!overlaps(node.min, node.max)) {
+                        continue;
+                    }
+                    if (node.isLeaf()) {
+                        for (uint element = node.index; element < node.index + node.count; element++) {
+                            if (overlaps(bounds[element].min, bounds[element].max)) {
+                                visit(element);
+                            }
+                        }
+                        continue;
+                    }
+                    stack[size++] = node.index;
+                    stack[size++] = index + 1;
+                }
+            }
+
+            /**
+             * @brief Checks if a ray crosses a box, using the slab method.
+             * @param min The minimum point of the box.
+             * @param max The maximum point of the box.
+             * @param origin Where the ray starts.
+             * @param inverse The inverse of the ray's direction.
+             * @param maxDistance How far the ray goes, in multiples of its direction.
+             * @param distance Set to how far along the ray the box is entered, or 0 if the ray starts inside it.
+             * @return Whether the ray crosses the box.
+             */
+            static bool crosses(const glm::vec3& min, const glm::vec3& max, const glm::vec3& origin, const glm::vec3& inverse,
+                                const float maxDistance, float& distance) noexcept {
+                const glm::vec3 toMin = (min - origin) * inverse;
+                const glm::vec3 toMax = (max - origin) * inverse;
+                const glm::vec3 entries = glm::min(toMin, toMax);
+                const glm::vec3 exits = glm::max(toMin, toMax);
+                distance = std::max(std::max(entries.x, entries.y), std::max(entries.z, 0.0f));
+                return distance <= std::min(std::min(exits.x, exits.y), std::min(exits.z, maxDistance));
+            }
         };
     }  // namespace core::geom
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
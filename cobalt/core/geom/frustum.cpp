@@ -0,0 +1,57 @@
+/**
+ * @file frustum.cpp
+ * @brief A view frustum: the volume a camera sees, bounded by six planes. Used to cull whatever is out of view before it is drawn.
+ * @author Tomás Marques
+ * @date 19-09-2024
+ */
+
+#include "core/geom/frustum.h"
+
+#include <glm/gtc/matrix_access.hpp>
+
+namespace cobalt {
+    namespace core::geom {
+        Frustum::Frustum(const glm::mat4& viewProjection) noexcept {
+            // Gribb and Hartmann: every plane is the last row of the matrix plus or minus one of the others. glm is column-major.
+            const glm::vec4 x = glm::row(viewProjection, 0);
+            const glm::vec4 y = glm::row(viewProjection, 1);
+            const glm::vec4 z = glm::row(viewProjection, 2);
+            const glm::vec4 w = glm::row(viewProjection, 3);
+            planes[(uint)Plane::Left] = w + x;
+            planes[(uint)Plane::Right] = w - x;
+            planes[(uint)Plane::Bottom] = w + y;
+            planes[(uint)Plane::Top] = w - y;
+            planes[(uint)Plane::Near] = w + z;
+            planes[(uint)Plane::Far] = w - z;
+            for (glm::vec4& plane : planes) {
+                plane /= glm::length(glm::vec3(plane));
+            }
+        }
+
+        bool Frustum::intersects(const AABB& box) const noexcept {
+            const glm::vec3& min = box.getMin();
+            const glm::vec3& max = box.getMax();
+            for (const glm::vec4& plane : planes) {
+                // The corner furthest along the plane's normal is the last one to leave the frustum.
+                const glm::vec3 corner(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z);
+                if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool Frustum::contains(const glm::vec3& point) const noexcept {
+            for (const glm::vec4& plane : planes) {
+                if (glm::dot(glm::vec3(plane), point) + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const glm::vec4& Frustum::getPlane(const Plane plane) const noexcept { return planes[(uint)plane]; }
+
+        const glm::vec4* Frustum::getPlanes() const noexcept { return planes; }
+    }  // namespace core::geom
+}  // namespace cobalt
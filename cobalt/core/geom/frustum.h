@@ -0,0 +1,72 @@
+/**
+ * @file frustum.h
+ * @brief A view frustum: the volume a camera sees, bounded by six planes. Used to cull whatever is out of view before it is drawn.
+ * @author Tomás Marques
+ * @date 19-09-2024
+ */
+
+#pragma once
+
+#include "core/geom/aabb.h"
+
+namespace cobalt {
+    namespace core::geom {
+        /**
+         * @brief A view frustum: the volume a camera sees, bounded by six planes. Each plane is stored as (a, b, c, d), with its normal
+         * (a, b, c) pointing into the frustum, so that a point p is on the inside when a * p.x + b * p.y + c * p.z + d >= 0.
+         */
+        class Frustum {
+            public:
+            static inline constexpr uint PLANES = 6;  ///< The number of planes bounding the frustum.
+
+            /**
+             * @brief Enum class for specifying a plane of the frustum.
+             */
+            enum class Plane {
+                Left,    ///< The left plane.
+                Right,   ///< The right plane.
+                Bottom,  ///< The bottom plane.
+                Top,     ///< The top plane.
+                Near,    ///< The near plane.
+                Far      ///< The far plane.
+            };
+
+            /**
+             * @brief Creates a frustum from a combined view and projection matrix, extracting its planes from the matrix's rows.
+             * @param viewProjection The projection matrix times the view matrix, with OpenGL's [-1, 1] clip space depth.
+             */
+            explicit Frustum(const glm::mat4& viewProjection) noexcept;
+
+            /**
+             * @brief Checks if a box is at least partially inside the frustum. Conservative: a box near one of the frustum's corners may be
+             * reported as inside while being just outside, which is fine for culling.
+             * @param box The box.
+             * @return Whether the box might be inside the frustum.
+             */
+            bool intersects(const AABB& box) const noexcept;
+
+            /**
+             * @brief Checks if a point is inside the frustum.
+             * @param point The point.
+             * @return Whether the point is inside the frustum.
+             */
+            bool contains(const glm::vec3& point) const noexcept;
+
+            /**
+             * @brief Gets one of the frustum's planes.
+             * @param plane The plane.
+             * @return The plane's normal, pointing into the frustum, and its distance from the origin.
+             */
+            const glm::vec4& getPlane(const Plane plane) const noexcept;
+
+            /**
+             * @brief Gets the frustum's planes.
+             * @return The six planes, in the order of the Plane enum.
+             */
+            const glm::vec4* getPlanes() const noexcept;
+
+            private:
+            glm::vec4 planes[PLANES];  ///< The planes, normalized and in the order of the Plane enum.
+        };
+    }  // namespace core::geom
+}  // namespace cobalt
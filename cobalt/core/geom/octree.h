@@ -27,6 +27,7 @@ namespace cobalt {
             struct Configuration {
                 const uint maxDepth;                              // The maximum depth of the octree. 0 means no depth limit.
                 const uint maxElements;                           // The maximum number of elements in a node. This must be at least 1.
+                const float looseness;                            // How much larger than its octant each node's bounds are. 1 means a regular octree.
                 Func<AABB(const ElementType&)> getElementBounds;  // The function to get an element's bounding box.
 
                 /**
@@ -34,11 +35,15 @@ namespace cobalt {
                  * @param getElementBounds The function to get an element's bounding box.
                  * @param maxDepth The maximum depth of the octree. 0 means no depth limit.
                  * @param maxElements The maximum number of elements in a node. This must be at least 1.
+                 * @param looseness How much larger than its octant each node's bounds are, at least 1. A regular octree (1) keeps every element
+                 * that straddles a split plane in the node above it, however small. A loose octree (usually 2) lets nodes overlap, so elements
+                 * go as deep as their size allows, and moving ones rarely change nodes.
                  * @see Octree
                  * @see OctreeNode
                  */
-                Configuration(Func<AABB(const ElementType&)> getElementBounds, const uint maxDepth = 0, const uint maxElements = 8) noexcept
-                    : getElementBounds(getElementBounds), maxDepth(maxDepth), maxElements(maxElements) {}
+                Configuration(Func<AABB(const ElementType&)> getElementBounds, const uint maxDepth = 0, const uint maxElements = 8,
+                              const float looseness = 1.0f) noexcept
+                    : getElementBounds(getElementBounds), maxDepth(maxDepth), maxElements(maxElements), looseness(std::max(looseness, 1.0f)) {}
             };
 
             /**
@@ -74,6 +79,28 @@ namespace cobalt {
              */
             void insert(const ElementType& element) { root.insert(element); }
 
+            /**
+             * @brief Removes an element from the tree. Nodes left with few enough elements to fit in one are collapsed back into it.
+             * @param element The element to remove, found by comparing it with ==.
+             * @param bounds The bounds the element was inserted with. If not provided, its current bounds are used.
+             * @return Whether the element was found.
+             */
+            bool remove(const ElementType& element, const Opt<AABB>& bounds = None) {
+                return root.remove(element, bounds.has_value() ? bounds.value() : root.getElementBounds(element));
+            }
+
+            /**
+             * @brief Moves an element that changed its bounds to where they now belong, replacing the stored copy with it. Only the nodes
+             * between its old and new place are visited, and it stays where it is if it still belongs there. An element that left the octree's
+             * bounds is removed, as inserting it would have dropped it.
+             * @param element The element, found by comparing it with ==. Its current bounds are where it is moved to.
+             * @param oldBounds The bounds the element was inserted or last updated with.
+             * @return Whether the element was found.
+             */
+            bool update(const ElementType& element, const AABB& oldBounds) {
+                return root.update(element, oldBounds, root.getElementBounds(element));
+            }
+
             private:
             /**
              * @brief A node in the octree. The root node is the starting point of the octree, and all other nodes are its children.
@@ -89,7 +116,7 @@ namespace cobalt {
                  * @param depth The depth of the node.
                  */
                 OctreeNode(const AABB& bounds, const Configuration& config, const uint depth = 0) noexcept
-                    : bounds(bounds), config(config), depth(depth) {}
+                    : bounds(bounds), looseBounds(loosen(bounds, config.looseness)), config(config), depth(depth) {}
                 ~OctreeNode() noexcept = default;
                 OctreeNode(const OctreeNode&) = delete;
                 OctreeNode& operator=(const OctreeNode&) = delete;
@@ -103,7 +130,7 @@ namespace cobalt {
                  * @param range The range to query. If not provided, the function returns all elements in the octree.
                  */
                 void query(Vec<Wrap<ElementType>>& found, Opt<AABB> range = None) {
-                    if (range.has_value() && !range.value().intersects(bounds)) {
+                    if (range.has_value() && !range.value().intersects(looseBounds)) {
                         return;
                     }
                     for (auto& element : data) {
@@ -125,7 +152,7 @@ namespace cobalt {
                  * @param point The point to query. If not provided, the function returns all elements in the octree.
                  */
                 void query(Vec<Wrap<ElementType>>& found, const glm::vec3& point) {
-                    if (!bounds.contains(point)) {
+                    if (!looseBounds.contains(point)) {
                         return;
                     }
                     for (auto& element : data) {
@@ -148,7 +175,7 @@ namespace cobalt {
                 void insert(ConstWrap<ElementType> element) {
                     static_assert(std::is_copy_constructible<ElementType>::value, "ElementType must be copy constructible.");
                     const AABB& elementBounds = config.getElementBounds(element);
-                    if (!this->bounds.intersects(elementBounds)) return;
+                    if (!this->looseBounds.intersects(elementBounds)) return;
                     if (isLeaf()) {
                         data.push_back(CreateConstWrap<ElementType>(element));
                         if (data.size() > config.maxElements && (config.maxDepth == 0 || depth < config.maxDepth)) {
@@ -156,15 +183,51 @@ namespace cobalt {
                         }
                         return;
                     }
-                    for (auto& child : children) {
-                        if (child.bounds.contains(elementBounds)) {
-                            child.insert(CreateConstWrap<ElementType>(element));
-                            return;
-                        }
+                    if (OctreeNode* child = getChild(elementBounds)) {
+                        child->insert(CreateConstWrap<ElementType>(element));
+                        return;
                     }
                     data.push_back(element);
                 }
 
+                /**
+                 * @brief Removes an element from the node or its children, collapsing them on the way back up if they emptied out enough.
+                 * @param element The element to remove, found by comparing it with ==.
+                 * @param elementBounds The bounds the element was inserted with, which lead to the node it is in.
+                 * @return Whether the element was found.
+                 */
+                bool remove(const ElementType& element, const AABB& elementBounds) {
+                    if (!looseBounds.intersects(elementBounds)) return false;
+                    if (OctreeNode* child = getChild(elementBounds)) {
+                        if (child->remove(element, elementBounds)) {
+                            collapse();
+                            return true;
+                        }
+                    }
+                    auto it = std::find(data.begin(), data.end(), element);
+                    if (it == data.end()) return false;
+                    data.erase(it);
+                    return true;
+                }
+
+                /**
+                 * @brief Moves an element that changed its bounds, replacing the stored copy with it.
+                 * @param element The element, found by comparing it with ==.
+                 * @param oldBounds The bounds the element was inserted or last updated with.
+                 * @param newBounds The element's current bounds.
+                 * @return Whether the element was found.
+                 */
+                bool update(const ElementType& element, const AABB& oldBounds, const AABB& newBounds) {
+                    return relocate(element, oldBounds, newBounds, looseBounds.intersects(newBounds)) != Relocation::Missing;
+                }
+
+                /**
+                 * @brief Gets the function to get an element's bounding box.
+                 * @param element The element.
+                 * @return The element's bounding box.
+                 */
+                AABB getElementBounds(const ElementType& element) const { return config.getElementBounds(element); }
+
                 /**
                  * @brief Checks if the node is a leaf in the octree.
                  * @return Whether the node is a leaf.
@@ -175,9 +238,98 @@ namespace cobalt {
                 Vec<OctreeNode> children;     // The children of the node.
                 Vec<ElementType> data;        // The data stored in the node.
                 AABB bounds;                  // The bounds of the node.
+                AABB looseBounds;             // The bounds of the node, grown by the looseness around its center. Elements must fit in them.
                 const uint depth;             // The depth of the node.
                 const Configuration& config;  // The configuration of the octree.
 
+                /**
+                 * @brief The outcome of moving an element within a node.
+                 */
+                enum class Relocation {
+                    Missing,  // The element isn't in the node or its children.
+                    Done,     // The element was found and is where it now belongs.
+                    Pending   // The element was found and taken out, but belongs further up, so an ancestor has to insert it.
+                };
+
+                /**
+                 * @brief Moves an element along the path its old bounds lead to. The element is taken back up that path until it reaches a node
+                 * its new bounds lead to as well, which inserts it again. Both paths are the ones insert would follow, so the element can
+                 * always be found again from its bounds.
+                 * @param element The element, found by comparing it with ==.
+                 * @param oldBounds The bounds the element was inserted or last updated with.
+                 * @param newBounds The element's current bounds.
+                 * @param onPath Whether the new bounds lead to this node too.
+                 * @return Whether the element was missing, moved, or still has to be inserted by an ancestor.
+                 */
+                Relocation relocate(const ElementType& element, const AABB& oldBounds, const AABB& newBounds, const bool onPath) {
+                    if (!looseBounds.intersects(oldBounds)) return Relocation::Missing;
+                    Relocation result = Relocation::Missing;
+                    if (OctreeNode* child = getChild(oldBounds)) {
+                        result = child->relocate(element, oldBounds, newBounds, onPath && getChild(newBounds) == child);
+                    }
+                    if (result == Relocation::Missing) {
+                        auto it = std::find(data.begin(), data.end(), element);
+                        if (it == data.end()) return Relocation::Missing;
+                        if (onPath && !getChild(newBounds)) {
+                            // Still belongs here, so only its copy needs refreshing.
+                            *it = element;
+                            return Relocation::Done;
+                        }
+                        data.erase(it);
+                        result = Relocation::Pending;
+                    }
+                    if (result == Relocation::Pending && onPath) {
+                        insert(CreateConstWrap<ElementType>(element));
+                        result = Relocation::Done;
+                    }
+                    collapse();
+                    return result;
+                }
+
+                /**
+                 * @brief Grows a box by a factor around its center.
+                 * @param bounds The box.
+                 * @param looseness The factor.
+                 * @return The grown box.
+                 */
+                static AABB loosen(const AABB& bounds, const float looseness) noexcept {
+                    const glm::vec3 center = bounds.getCenter();
+                    const glm::vec3 half = bounds.getSize() * (looseness / 2.0f);
+                    return AABB(center - half, center + half);
+                }
+
+                /**
+                 * @brief Gets the child an element belongs in: the one whose octant holds the element's center, if the element fits in that
+                 * child's loose bounds.
+                 * @param elementBounds The bounds of the element.
+                 * @return The child, or nullptr if the node is a leaf or the element belongs in the node itself.
+                 */
+                OctreeNode* getChild(const AABB& elementBounds) {
+                    if (isLeaf()) return nullptr;
+                    const glm::vec3 mid = bounds.getCenter();
+                    const glm::vec3 center = elementBounds.getCenter();
+                    OctreeNode& child = children[(center.x >= mid.x) * 4 + (center.y >= mid.y) * 2 + (center.z >= mid.z)];
+                    return child.looseBounds.contains(elementBounds) ? &child : nullptr;
+                }
+
+                /**
+                 * @brief Merges the children back into the node if they are all leaves and their elements would fit in it without splitting it
+                 * again.
+                 */
+                void collapse() {
+                    if (isLeaf()) return;
+                    uint64 count = data.size();
+                    for (const auto& child : children) {
+                        if (!child.isLeaf()) return;
+                        count += child.data.size();
+                    }
+                    if (count > config.maxElements) return;
+                    for (auto& child : children) {
+                        data.insert(data.end(), child.data.begin(), child.data.end());
+                    }
+                    children.clear();
+                }
+
                 /**
                  * @brief Splits the node into 8 children and recursively distribute the data.
                  */
@@ -200,16 +352,9 @@ namespace cobalt {
 
                     // Distribute existing elements to appropriate children or keep them in the current node
                     for (const auto& element : tempData) {
-                        const AABB& elementBounds = config.getElementBounds(element);
-                        bool inserted = false;
-                        for (auto& child : children) {
-                            if (child.bounds.contains(elementBounds)) {
-                                child.insert(CreateConstWrap<ElementType>(element));
-                                inserted = true;
-                                break;  // Element fits entirely within one child
-                            }
-                        }
-                        if (!inserted) {
+                        if (OctreeNode* child = getChild(config.getElementBounds(element))) {
+                            child->insert(CreateConstWrap<ElementType>(element));
+                        } else {
                             // Element does not fit entirely within any child, so keep it in this node
                             data.push_back(element);
                         }
@@ -254,6 +399,13 @@ namespace cobalt {
                  * @return The bounds.
                  */
                 static const AABB& getBounds(const OctreeNode& node) { return node.bounds; }
+
+                /**
+                 * @brief Gets the loose bounds of a node, which its elements fit in.
+                 * @param node The node.
+                 * @return The loose bounds.
+                 */
+                static const AABB& getLooseBounds(const OctreeNode& node) { return node.looseBounds; }
             };
         };  // namespace core::geom
     }  // namespace core::geom
@@ -0,0 +1,139 @@
+/**
+ * @file split_strategy.cpp
+ * @brief A strategy for splitting a set of elements into two sets sorted on their bounding volumes according to a specific criterion.
+ * @author Tomás Marques
+ * @date 19-09-2024
+ */
+
+#include "core/geom/strategy/split_strategy.h"
+
+namespace cobalt {
+    namespace core::geom {
+        namespace {
+            /**
+             * @brief Gets the bounding volume of the centers of a set of elements.
+             * @param elements The elements.
+             * @param count The number of elements.
+             * @return The minimum and maximum points of their centers.
+             */
+            Pair<glm::vec3, glm::vec3> getCenterBounds(const SplitStrategy::Element* elements, const uint64 count) noexcept {
+                glm::vec3 min(FLT_MAX);
+                glm::vec3 max(-FLT_MAX);
+                for (uint64 i = 0; i < count; i++) {
+                    min = glm::min(min, elements[i].center);
+                    max = glm::max(max, elements[i].center);
+                }
+                return {min, max};
+            }
+
+            /**
+             * @brief A box grown one element at a time, along with the number of elements in it.
+             */
+            struct Bin {
+                glm::vec3 min;  ///< The minimum point of the box.
+                glm::vec3 max;  ///< The maximum point of the box.
+                uint64 count;   ///< The number of elements in the box.
+
+                /**
+                 * @brief Empties the bin. Bins start out uninitialized, so that only the ones in use are ever written.
+                 */
+                void clear() noexcept {
+                    min = glm::vec3(FLT_MAX);
+                    max = glm::vec3(-FLT_MAX);
+                    count = 0;
+                }
+                /**
+                 * @brief Adds an element, or every element of another bin.
+                 * @param otherMin The minimum point of the element's box.
+                 * @param otherMax The maximum point of the element's box.
+                 * @param otherCount The number of elements added.
+                 */
+                void add(const glm::vec3& otherMin, const glm::vec3& otherMax, const uint64 otherCount) noexcept {
+                    min = glm::min(min, otherMin);
+                    max = glm::max(max, otherMax);
+                    count += otherCount;
+                }
+                /**
+                 * @brief Gets the cost of the bin: its surface area times its number of elements.
+                 * @return The cost.
+                 */
+                float getCost() const noexcept { return AABB(min, max).getSurfaceArea() * (float)count; }
+            };
+        }  // namespace
+
+        uint64 LongestAxisSplitStrategy::split(Element* elements, const uint64 count) const {
+            const auto [min, max] = getCenterBounds(elements, count);
+            const glm::vec3 size = max - min;
+            const int axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+            const uint64 half = count / 2;
+            std::nth_element(elements, elements + half, elements + count,
+                             [axis](const Element& a, const Element& b) { return a.center[axis] < b.center[axis]; });
+            return half;
+        }
+
+        SAHSplitStrategy::SAHSplitStrategy(const uint bins) noexcept : bins(std::clamp(bins, 2u, MAX_BINS)) {}
+
+        uint64 SAHSplitStrategy::split(Element* elements, const uint64 count) const {
+            const auto [min, max] = getCenterBounds(elements, count);
+            const glm::vec3 size = max - min;
+            // Small sets don't need more bins than they have elements.
+            const uint binCount = (uint)std::min((uint64)bins, count);
+
+            // Bin every element along all three axes in a single pass.
+            glm::vec3 scale;
+            for (int axis = 0; axis < 3; axis++) {
+                scale[axis] = size[axis] > 0.0f ? (float)binCount / size[axis] : 0.0f;
+            }
+            Bin binned[3][MAX_BINS];
+            for (int axis = 0; axis < 3; axis++) {
+                for (uint bin = 0; bin < binCount; bin++) {
+                    binned[axis][bin].clear();
+                }
+            }
+            for (uint64 i = 0; i < count; i++) {
+                const glm::vec3 offset = (elements[i].center - min) * scale;
+                for (int axis = 0; axis < 3; axis++) {
+                    binned[axis][std::min(binCount - 1, (uint)offset[axis])].add(elements[i].min, elements[i].max, 1);
+                }
+            }
+
+            float bestCost = FLT_MAX;
+            int bestAxis = -1;
+            uint bestPlane = 0;
+            for (int axis = 0; axis < 3; axis++) {
+                if (size[axis] <= 0.0f) {
+                    continue;
+                }
+                // Sweep from the left, then from the right, trying every plane between two bins.
+                float leftCosts[MAX_BINS];
+                uint64 leftCounts[MAX_BINS];
+                Bin side;
+                side.clear();
+                for (uint bin = 0; bin < binCount - 1; bin++) {
+                    side.add(binned[axis][bin].min, binned[axis][bin].max, binned[axis][bin].count);
+                    leftCosts[bin] = side.getCost();
+                    leftCounts[bin] = side.count;
+                }
+                side.clear();
+                for (uint plane = binCount - 1; plane > 0; plane--) {
+                    side.add(binned[axis][plane].min, binned[axis][plane].max, binned[axis][plane].count);
+                    const float cost = leftCosts[plane - 1] + side.getCost();
+                    if (side.count > 0 && leftCounts[plane - 1] > 0 && cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestPlane = plane;
+                    }
+                }
+            }
+
+            if (bestAxis < 0) {
+                // Every center is in the same spot, so any split is as good as any other.
+                return count / 2;
+            }
+            const Element* middle = std::partition(elements, elements + count, [&](const Element& element) {
+                return std::min(binCount - 1, (uint)((element.center[bestAxis] - min[bestAxis]) * scale[bestAxis])) < bestPlane;
+            });
+            return (uint64)(middle - elements);
+        }
+    }  // namespace core::geom
+}  // namespace cobalt
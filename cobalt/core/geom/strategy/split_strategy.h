@@ -12,62 +12,77 @@
 namespace cobalt {
     namespace core::geom {
         /**
-         * @brief A strategy to split a set of elements into two sets sorted on their bounding volumes according to a specific criterion.
-         * @tparam ElementType The type of the elements in the array. Must be associated to a bounding volume (even if null).
+         * @brief A strategy to split a set of elements into two sets sorted on their bounding volumes according to a specific criterion. Used by
+         * the BVH to decide how each of its nodes is split between its two children.
+         * Strategies work on copies of the elements' bounding volumes rather than the elements themselves, so they don't depend on the element
+         * type, and every range they split is contiguous in memory.
          */
-        template <typename ElementType>
         class SplitStrategy {
             public:
-            virtual ~SplitStrategy() noexcept = default;
-
             /**
-             * @brief Splits the elements into two sets.
-             * @param elements The array of elements to split.
-             * @return A pair containing the two sets of elements.
+             * @brief An element being split: its bounding volume, its center, and where it is in the set the BVH is built from.
              */
-            virtual Pair<Vector<ElementType*>, Vector<ElementType*>> split(Vector<ElementType*> elements) const = 0;
+            struct Element {
+                glm::vec3 min;     ///< The minimum point of the element's bounding volume.
+                glm::vec3 max;     ///< The maximum point of the element's bounding volume.
+                glm::vec3 center;  ///< The center of the element's bounding volume.
+                uint index;        ///< The element's index in the set the BVH is built from.
+            };
+
+            virtual ~SplitStrategy() noexcept = default;
 
             /**
-             * @brief Gets the bounding volume for a specific element.
-             * @return The bounding volume for the element.
+             * @brief Splits the elements into two sets, reordering them so that the first set comes before the second.
+             * @param elements The elements to split.
+             * @param count The number of elements to split. Must be at least 2.
+             * @return The number of elements in the first set, between 1 and count - 1.
              */
-            virtual const AABB& getElementBounds(const ElementType& element) const noexcept = 0;
+            virtual uint64 split(Element* elements, const uint64 count) const = 0;
         };
 
         /**
-         * @brief A strategy for splitting a set of elements into two sets sorted on the longest axis of their bounding volume.
-         * @tparam ElementType The type of the elements in the array. Must be associated to a bounding volume (even if null).
+         * @brief A strategy for splitting a set of elements into two halves sorted on the longest axis of their centers' bounding volume. Quick,
+         * but blind to how the elements are distributed along it.
          */
-        template <typename ElementType>
-        class LongestAxisSplitStrategy : public SplitStrategy<ElementType> {
+        class LongestAxisSplitStrategy : public SplitStrategy {
             public:
             /**
-             * @brief Splits the elements into two sets sorted on the longest axis of their combined bounding volume.
-             * @param elements The array of elements to split.
-             * @return A pair containing the two sets of elements.
-             * @note You should extend this class and implement the getElementBounds method before instantiating it.
+             * @brief Splits the elements into two halves sorted on the longest axis of their centers' bounding volume.
+             * @param elements The elements to split.
+             * @param count The number of elements to split. Must be at least 2.
+             * @return The number of elements in the first set, count / 2.
              */
-            Pair<Vector<ElementType*>, Vector<ElementType*>> split(Vector<ElementType*> elements) const override {
-                if (elements.empty()) {
-                    return {Vector<ElementType*>(), Vector<ElementType*>()};
-                }
-
-                AABB combinedBounds;
-                for (ElementType* element : elements) {
-                    combinedBounds += getElementBounds(*element);
-                }
+            uint64 split(Element* elements, const uint64 count) const override;
+        };
 
-                glm::vec3 size = combinedBounds.getSize();
-                Axis axis = size.x > size.y ? (size.x > size.z ? Axis::X : Axis::Z) : (size.y > size.z ? Axis::Y : Axis::Z);
+        /**
+         * @brief A strategy for splitting a set of elements where the Surface Area Heuristic estimates rays and queries will be cheapest: the
+         * chance of a child being visited is proportional to its surface area, so the cost of a split is the sum of the area of each side
+         * times the number of elements in it.
+         * Instead of trying every possible split, the elements are binned by their center along each axis and only the planes between bins are
+         * tried, which keeps building linear in the number of elements.
+         */
+        class SAHSplitStrategy : public SplitStrategy {
+            public:
+            static inline constexpr uint MAX_BINS = 64;  ///< The maximum number of bins per axis.
 
-                std::sort(elements.begin(), elements.end(), AABB::CompareAxis(axis));
+            /**
+             * @brief Creates a surface area heuristic strategy.
+             * @param bins The number of bins per axis. More bins find better splits but take longer. Clamped between 2 and MAX_BINS.
+             */
+            SAHSplitStrategy(const uint bins = 16) noexcept;
 
-                size_t half = elements.size() / 2;
-                return {Vector<ElementType*>(elements.begin(), elements.begin() + half),
-                        Vector<ElementType*>(elements.begin() + half, elements.end())};
-            }
+            /**
+             * @brief Splits the elements where the surface area heuristic is lowest. Falls back to splitting them in half if their centers all
+             * coincide.
+             * @param elements The elements to split.
+             * @param count The number of elements to split. Must be at least 2.
+             * @return The number of elements in the first set, between 1 and count - 1.
+             */
+            uint64 split(Element* elements, const uint64 count) const override;
 
-            const AABB& getElementBounds(const ElementType& element) const noexcept = 0;
+            private:
+            const uint bins;  ///< The number of bins per axis.
         };
     }  // namespace core::geom
 }  // namespace cobalt
@@ -550,6 +550,28 @@ namespace cobalt {
                 }  // namespace gl
             }  // namespace core
 
+            /**
+             * @brief Gets the size of one channel of a pixel type.
+             * @param type The pixel type.
+             * @return The size in bytes of one channel.
+             */
+            inline const size_t getPixelTypeSize(const PixelType type) noexcept {
+                switch (type) {
+                    case PixelTypes::UnsignedShort:
+                    case PixelTypes::Short:
+                    case PixelTypes::HalfFloat:
+                        return 2;
+                    case PixelTypes::UnsignedInt:
+                    case PixelTypes::Int:
+                    case PixelTypes::Float:
+                        return 4;
+                    case PixelTypes::UnsignedByte:
+                    case PixelTypes::Byte:
+                    default:
+                        return 1;
+                }
+            }
+
             /**
              * @brief Type alias for integers used to represent different texture formats.
              */
@@ -692,6 +714,28 @@ namespace cobalt {
                 }
             }
 
+            /**
+             * @brief Gets the number of channels in a texture format.
+             * @param format The texture format.
+             * @return The number of channels.
+             */
+            inline const uint getTextureFormatChannels(const TextureFormat format) noexcept {
+                switch (format) {
+                    case TextureFormats::RG:
+                    case TextureFormats::RGInt:
+                    case TextureFormats::DepthStencil:
+                        return 2;
+                    case TextureFormats::RGB:
+                    case TextureFormats::RGBInt:
+                        return 3;
+                    case TextureFormats::RGBA:
+                    case TextureFormats::RGBAInt:
+                        return 4;
+                    default:
+                        return 1;
+                }
+            }
+
             /**
              * @brief Type alias for integers used to represent different texture wrapping modes.
              */
@@ -7,18 +7,26 @@
 
 #include "core/gl/ibo.h"
 
+#include "core/memory/stack.h"
+#include "core/memory/tracker.h"
+
 namespace cobalt {
     namespace core::gl {
-        IBO::IBO(const gl::Usage usage, const uint indexCount) : usage(usage), indexCount(indexCount) { glGenBuffers(1, &buffer); }
+        IBO::IBO(const gl::Usage usage, const uint indexCount) : usage(usage), indexCount(indexCount) {
+            glGenBuffers(1, &buffer);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Meshes, indexCount * sizeof(uint));
+        }
 
         IBO::IBO(const gl::Usage usage, const uint* indices, const uint indexCount) : usage(usage), indexCount(indexCount) {
             glGenBuffers(1, &buffer);
             bind();
             glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(uint), indices, (GLenum)usage);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Meshes, indexCount * sizeof(uint));
         }
 
         IBO::~IBO() {
             if (buffer != 0) {
+                CB_TRACK_FREE(core::memory::MemoryTag::Meshes, indexCount * sizeof(uint));
                 glDeleteBuffers(1, &buffer);
             }
         }
@@ -46,7 +54,9 @@ namespace cobalt {
             IBO ibo(usage, count * 6);
             ibo.bind();
             uint pattern[6] = {0, 1, 2, 2, 3, 0};
-            uint indices[count * 6];
+            memory::StackAllocator& scratch = memory::StackAllocator::getScratch();
+            memory::StackAllocator::ScopeGuard guard(scratch);
+            uint* indices = scratch.grabArray<uint>(count * 6);
             for (int i = 0; i < count * 6; i++) {
                 indices[i] = pattern[i % 6] + (i / 6) * 4;
             }
@@ -8,13 +8,15 @@
 #include "core/gl/shader.h"
 
 #include "core/exception.h"
+#include "core/memory/tracker.h"
 
 namespace cobalt {
     namespace core::gl {
-        Shader::Shader(gl::Handle handle) : program(handle) {}
+        Shader::Shader(gl::Handle handle) : program(handle) { CB_TRACK_ALLOC(core::memory::MemoryTag::Shaders, getBinarySize()); }
 
         Shader::~Shader() {
             if (program != 0) {
+                CB_TRACK_FREE(core::memory::MemoryTag::Shaders, getBinarySize());
                 glDeleteProgram(program);
             }
         }
@@ -40,6 +42,12 @@ namespace cobalt {
 
         const gl::Handle Shader::getGLHandle() const { return program; }
 
+        const size_t Shader::getBinarySize() const {
+            GLint length = 0;
+            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+            return (size_t)length;
+        }
+
         const GLuint Shader::getUniformLocation(const std::string& name) {
             GLint linkStatus;
             try {
@@ -69,6 +69,11 @@ namespace cobalt {
              * @return The OpenGL handle to the shader program.
              */
             const gl::Handle getGLHandle() const;
+            /**
+             * @brief Gets the size of the linked program binary, as reported by the driver.
+             * @return The size of the program binary in bytes.
+             */
+            const size_t getBinarySize() const;
 
             /**
              * @brief Sets a uniform integer array for the given uniform name.
@@ -12,15 +12,21 @@
 #define STBI_NO_SIMD
 #endif
 #define STB_IMAGE_IMPLEMENTATION
+// Decode images into the thread's scratch stack. Loaders free it all at once through a ScopeGuard, so freeing single images does nothing.
+#define STBI_MALLOC(size) ::cobalt::core::memory::StackAllocator::getScratch().grab(size)
+#define STBI_REALLOC_SIZED(ptr, oldSize, newSize) ::cobalt::core::memory::StackAllocator::getScratch().resize(ptr, oldSize, newSize)
+#define STBI_FREE(ptr) ((void)(ptr))
 #include "core/gl/texture.h"
 
 #include "core/exception.h"
+#include "core/memory/stack.h"
+#include "core/memory/tracker.h"
 #include "stb_image/stb_image.h"
 
 namespace cobalt {
     namespace core::gl {
         Texture::Texture(const gl::TextureEncoding encoding)
-            : texture(0), format(gl::getTextureFormat(encoding)), encoding(encoding), pixelType(gl::getPixelType(encoding)) {}
+            : texture(0), format(gl::getTextureFormat(encoding)), encoding(encoding), pixelType(gl::getPixelType(encoding)), width(0), height(0) {}
 
         Texture::Texture(Texture&& other) noexcept {
             texture = other.texture;
@@ -28,6 +34,7 @@ namespace cobalt {
             height = other.height;
             format = other.format;
             encoding = other.encoding;
+            pixelType = other.pixelType;
             source = Move(other.source);
             other.texture = 0;
         }
@@ -38,11 +45,14 @@ namespace cobalt {
             height = other.height;
             format = other.format;
             encoding = other.encoding;
+            pixelType = other.pixelType;
             source = Move(other.source);
             other.texture = 0;
             return *this;
         }
 
+        size_t Texture::getSize() const { return (size_t)width * height * gl::getTextureFormatChannels(format) * gl::getPixelTypeSize(pixelType); }
+
         Texture2D::Texture2D(const Color& color, const gl::TextureEncoding encoding, const gl::TextureFilter filter, const gl::TextureWrap wrap)
             : Texture(encoding) {
             source = "";
@@ -55,6 +65,7 @@ namespace cobalt {
             glTexImage2D(GL_TEXTURE_2D, 0, (GLint)encoding, 1, 1, 0, (GLenum)format, (GLenum)pixelType, data);
             setFilter(filter);
             setWrap(wrap);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             CB_CORE_INFO("Created {0}x{1} px 2D texture (GL: {2}) with encoding: {3}, format: {4}, pixels: {5}", width, height, texture,
                          gl::getTextureEncodingName(encoding), gl::getTextureFormatName(format), gl::getPixelTypeName(pixelType));
             CB_CORE_INFO("Using filter: {0}, wrap: {1}", gl::getTextureFilterName(filter), gl::getTextureWrapName(wrap));
@@ -70,6 +81,7 @@ namespace cobalt {
             glTexImage2D(GL_TEXTURE_2D, 0, (GLint)encoding, 1, 1, 0, (GLenum)format, (GLenum)pixelType, data);
             setFilter(filter);
             setWrap(wrap);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             CB_CORE_INFO("Created 1x1 px 2D texture (GL: {0}) with encoding: {1}, format: {2}, pixels: {3}", texture,
                          gl::getTextureEncodingName(encoding), gl::getTextureFormatName(format), gl::getPixelTypeName(pixelType));
             CB_CORE_INFO("Using filter: {0}, wrap: {1}", gl::getTextureFilterName(filter), gl::getTextureWrapName(wrap));
@@ -79,8 +91,6 @@ namespace cobalt {
                              const gl::TextureWrap wrap)
             : Texture(encoding) {
             source = "";
-            this->width = width;
-            this->height = height;
             glGenTextures(1, &texture);
             reserve(width, height);
             setFilter(filter);
@@ -97,18 +107,23 @@ namespace cobalt {
             source = path.getFileName();
             int width, height, channels;
             stbi_set_flip_vertically_on_load(true);
-            uchar* data = stbi_load(path.getPath().c_str(), &width, &height, &channels, STBI_rgb_alpha);
-            if (!data) {
-                throw CoreException<Texture2D>("Failed to load texture: " + source);
+            memory::StackAllocator& scratch = memory::StackAllocator::getScratch();
+            {
+                memory::StackAllocator::ScopeGuard guard(scratch);
+                uchar* data = stbi_load(path.getPath().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+                if (!data) {
+                    throw CoreException<Texture2D>("Failed to load texture: " + source);
+                }
+                this->width = width;
+                this->height = height;
+                glGenTextures(1, &texture);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                glTexImage2D(GL_TEXTURE_2D, 0, (GLint)encoding, width, height, 0, (GLenum)format, (GLenum)pixelType, data);
             }
-            this->width = width;
-            this->height = height;
-            glGenTextures(1, &texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
-            glTexImage2D(GL_TEXTURE_2D, 0, (GLint)encoding, width, height, 0, (GLenum)format, (GLenum)pixelType, data);
+            scratch.trim();
             setFilter(filter);
             setWrap(wrap);
-            stbi_image_free(data);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             CB_CORE_INFO("Loaded {0}x{1} px 2D texture (GL: {2}) from {3} with encoding: {4}, format: {4}", width, height, texture,
                          path.getFileName(), gl::getTextureEncodingName(encoding), gl::getTextureFormatName(format), gl::getPixelTypeName(pixelType));
             CB_CORE_INFO("Using filter: {0}, wrap: {1}", gl::getTextureFilterName(filter), gl::getTextureWrapName(wrap));
@@ -116,6 +131,7 @@ namespace cobalt {
 
         Texture2D::~Texture2D() {
             if (texture != 0) {
+                CB_TRACK_FREE(core::memory::MemoryTag::Textures, getSize());
                 glDeleteTextures(1, &texture);
             }
         }
@@ -128,8 +144,10 @@ namespace cobalt {
         }
 
         void Texture2D::reserve(const uint width, const uint height) {
+            CB_TRACK_FREE(core::memory::MemoryTag::Textures, getSize());
             this->width = width;
             this->height = height;
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             glBindTexture(GL_TEXTURE_2D, texture);
             glTexImage2D(GL_TEXTURE_2D, 0, (GLint)encoding, this->width, this->height, 0, (GLenum)format, (GLenum)pixelType, nullptr);
         }
@@ -167,6 +185,7 @@ namespace cobalt {
             }
             setFilter(filter);
             setWrap(wrap);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             CB_CORE_INFO("Created {0}x{1} px/face cubemap (GL: {2}) with encoding: {3}, format: {4}, pixels: {5}", width, height, texture,
                          gl::getTextureEncodingName(encoding), gl::getTextureFormatName(format), gl::getPixelTypeName(pixelType));
             CB_CORE_INFO("Using filter: {0}, wrap: {1}", gl::getTextureFilterName(filter), gl::getTextureWrapName(wrap));
@@ -186,6 +205,7 @@ namespace cobalt {
             }
             setFilter(filter);
             setWrap(wrap);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             CB_CORE_INFO("Created {0}x{1} px/face 3D texture (GL: {2}) with encoding: {3}, format: {4}, pixels: {5}", width, height, texture,
                          gl::getTextureEncodingName(encoding), gl::getTextureFormatName(format), gl::getPixelTypeName(pixelType));
             CB_CORE_INFO("Using filter: {0}, wrap: {1}", gl::getTextureFilterName(filter), gl::getTextureWrapName(wrap));
@@ -195,8 +215,6 @@ namespace cobalt {
                              const gl::TextureWrap wrap)
             : Texture(encoding) {
             source = "";
-            this->width = width;
-            this->height = height;
             glGenTextures(1, &texture);
             reserve(width, height);
             setFilter(filter);
@@ -216,16 +234,19 @@ namespace cobalt {
             int width, height, channels;
             stbi_set_flip_vertically_on_load(true);
             std::string faces[6] = {"right.png", "left.png", "bottom.png", "top.png", "front.png", "back.png"};
+            memory::StackAllocator& scratch = memory::StackAllocator::getScratch();
             for (uint i = 0; i < 6; i++) {
+                memory::StackAllocator::ScopeGuard guard(scratch);
                 uchar* data = stbi_load((path + faces[i]).getPath().c_str(), &width, &height, &channels, STBI_rgb_alpha);
                 if (!data) {
                     throw CoreException<Texture3D>("Failed to load texture: " + source);
                 }
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, (GLint)encoding, width, height, 0, (GLenum)format, (GLenum)pixelType, data);
-                stbi_image_free(data);
             }
+            scratch.trim();
             this->width = width;
             this->height = height;
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             CB_CORE_INFO("Loaded {0}x{1} px/face 3D texture (GL: {2}) from {3} with encoding: {4}, format: {4}", width, height, texture,
                          path.getFileName(), gl::getTextureEncodingName(encoding), gl::getTextureFormatName(format), gl::getPixelTypeName(pixelType));
             CB_CORE_INFO("Using filter: {0}, wrap: {1}", gl::getTextureFilterName(filter), gl::getTextureWrapName(wrap));
@@ -233,8 +254,11 @@ namespace cobalt {
             setWrap(wrap);
         }
 
+        size_t Texture3D::getSize() const { return 6 * Texture::getSize(); }
+
         Texture3D::~Texture3D() {
             if (texture != 0) {
+                CB_TRACK_FREE(core::memory::MemoryTag::Textures, getSize());
                 glDeleteTextures(1, &texture);
             }
         }
@@ -247,8 +271,10 @@ namespace cobalt {
         }
 
         void Texture3D::reserve(const uint width, const uint height) {
+            CB_TRACK_FREE(core::memory::MemoryTag::Textures, getSize());
             this->width = width;
             this->height = height;
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Textures, getSize());
             for (uint i = 0; i < 6; i++) {
                 glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, (GLint)encoding, this->width, this->height, 0, (GLenum)format, (GLenum)pixelType,
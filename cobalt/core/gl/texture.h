@@ -87,6 +87,11 @@ namespace cobalt {
              * @return The pixel encoding of the texture.
              */
             inline TextureEncoding getEncoding() const { return encoding; }
+            /**
+             * @brief Estimates the GPU memory used by the texture, from its size and encoding.
+             * @return The size of the texture in bytes.
+             */
+            virtual size_t getSize() const;
 
             template <typename TextureType>
             TextureType& as() {
@@ -312,6 +317,11 @@ namespace cobalt {
              * @param filter The filter mode.
              */
             void setFilter(const TextureFilter filter) override;
+            /**
+             * @brief Estimates the GPU memory used by the cubemap, over all six faces.
+             * @return The size of the cubemap in bytes.
+             */
+            size_t getSize() const override;
         };
     }  // namespace core::gl
 }  // namespace cobalt
\ No newline at end of file
@@ -7,17 +7,20 @@
 
 #include "core/gl/vbo.h"
 
+#include "core/memory/tracker.h"
+
 namespace cobalt {
     namespace core::gl {
-        VBO::VBO(const gl::Usage usage) : usage(usage) { glGenBuffers(1, &buffer); }
+        VBO::VBO(const gl::Usage usage) : usage(usage), size(0) { glGenBuffers(1, &buffer); }
 
         VBO::~VBO() {
             if (buffer != 0) {
+                CB_TRACK_FREE(core::memory::MemoryTag::Meshes, size);
                 glDeleteBuffers(1, &buffer);
             }
         }
 
-        VBO::VBO(VBO&& other) noexcept : usage(other.usage) {
+        VBO::VBO(VBO&& other) noexcept : usage(other.usage), size(other.size) {
             this->buffer = other.buffer;
             other.buffer = 0;
         }
@@ -25,6 +28,7 @@ namespace cobalt {
         VBO& VBO::operator=(VBO&& other) noexcept {
             if (this != &other) {
                 this->usage = other.usage;
+                this->size = other.size;
                 this->buffer = other.buffer;
                 other.buffer = 0;
             }
@@ -35,9 +39,14 @@ namespace cobalt {
 
         void VBO::unbind() const { glBindBuffer(GL_ARRAY_BUFFER, 0); }
 
-        void VBO::reserve(const size_t size) const { glBufferData(GL_ARRAY_BUFFER, size, nullptr, (GLenum)usage); }
+        void VBO::reserve(const size_t size) { load(nullptr, size); }
 
-        void VBO::load(const void* data, const size_t size) const { glBufferData(GL_ARRAY_BUFFER, size, data, (GLenum)usage); }
+        void VBO::load(const void* data, const size_t size) {
+            glBufferData(GL_ARRAY_BUFFER, size, data, (GLenum)usage);
+            CB_TRACK_FREE(core::memory::MemoryTag::Meshes, this->size);
+            CB_TRACK_ALLOC(core::memory::MemoryTag::Meshes, size);
+            this->size = size;
+        }
 
         void VBO::load(const void* data, const size_t size, const size_t offset) const { glBufferSubData(GL_ARRAY_BUFFER, offset, size, data); }
     }  // namespace core::gl
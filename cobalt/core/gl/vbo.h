@@ -59,14 +59,14 @@ namespace cobalt {
              * @brief Reserves space in the VBO. Bind before calling.
              * @param size The number of bytes to reserve.
              */
-            void reserve(const size_t size) const;
+            void reserve(const size_t size);
 
             /**
              * @brief Loads data into the VBO. Bind before calling.
              * @param data The data to load.
              * @param size The size of the data to load in bytes.
              */
-            void load(const void* data, const size_t size) const;
+            void load(const void* data, const size_t size);
             /**
              * @brief Loads a subset of data into the VBO. Bind before calling.
              * @param data The data to load.
@@ -78,6 +78,7 @@ namespace cobalt {
             private:
             gl::Handle buffer;  ///< The OpenGL buffer handle.
             gl::Usage usage;    ///< The usage of the buffer.
+            size_t size;        ///< The size of the buffer's data store in bytes.
         };
     }  // namespace core::gl
 }  // namespace cobalt
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace cobalt {
     namespace core::memory {
-        ArenaAllocator::ArenaAllocator(const size_t initial_size) : heap(), block_count(1), arena_size(0) {
+        ArenaAllocator::ArenaAllocator(const size_t initial_size, const MemoryTag tag) : heap(tag), block_count(1), current(0), arena_size(0) {
             blocks = (ArenaBlock*)heap.grab(sizeof(ArenaBlock));
             blocks[0] = arenaBlockCreate(heap, initial_size);
         }
@@ -19,20 +19,26 @@ namespace cobalt {
             heap.drop(blocks);
         }
 
-        void* ArenaAllocator::grab(const size_t size) {
-            arena_size += size;
-            for (uint i = 0; i < block_count; i++) {
-                if (blocks[i].block_size + size < blocks[i].block_capacity) {
-                    void* ptr = (void*)((char*)blocks[i].data + blocks[i].block_size);
-                    blocks[i].block_size += size;
-                    return ptr;
+        void* ArenaAllocator::grab(const size_t size) { return grab(size, 1); }
+
+        void* ArenaAllocator::grab(const size_t size, const size_t alignment) {
+            while (true) {
+                ArenaBlock& block = blocks[current];
+                const uintptr_t base = (uintptr_t)block.data;
+                const size_t offset = ((base + block.block_size + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+                if (offset + size <= block.block_capacity) {
+                    block.block_size = offset + size;
+                    arena_size += size;
+                    return (void*)((char*)block.data + offset);
+                }
+                if (current + 1 == block_count) {
+                    // Grow geometrically, so a frame that needs a lot of memory only adds a handful of blocks.
+                    const size_t capacity = std::max(size + alignment - 1, 2 * blocks[block_count - 1].block_capacity);
+                    blocks = (ArenaBlock*)heap.resize(blocks, (block_count + 1) * sizeof(ArenaBlock));
+                    blocks[block_count++] = arenaBlockCreate(heap, capacity);
                 }
+                current++;
             }
-            blocks = (ArenaBlock*)heap.resize(blocks, (block_count + 1) * sizeof(ArenaBlock));
-            blocks[block_count] = arenaBlockCreate(heap, ArenaAllocator::getSize());
-            void* ptr = (void*)((char*)blocks[block_count].data + blocks[block_count].block_size);
-            blocks[block_count++].block_size += size;
-            return ptr;
         }
 
         void* ArenaAllocator::resize(void* ptr, const size_t size) {
@@ -41,11 +47,34 @@ namespace cobalt {
             return new_ptr;
         }
 
+        void ArenaAllocator::reset() {
+            if (block_count > 1) {
+                size_t capacity = 0;
+                for (uint i = 0; i < block_count; i++) {
+                    capacity += blocks[i].block_capacity;
+                    arenaBlockDestroy(heap, &blocks[i]);
+                }
+                block_count = 1;
+                blocks[0] = arenaBlockCreate(heap, capacity);
+            }
+            blocks[0].block_size = 0;
+            current = 0;
+            arena_size = 0;
+        }
+
         size_t ArenaAllocator::getSize() { return arena_size; }
 
+        size_t ArenaAllocator::getReserved() {
+            size_t reserved = 0;
+            for (uint i = 0; i < block_count; i++) {
+                reserved += blocks[i].block_capacity;
+            }
+            return reserved;
+        }
+
         void* ArenaAllocator::alloc(const size_t size) { return grab(size); }
 
-        void ArenaAllocator::free(void* ptr) {
+        void ArenaAllocator::free(void*) {
             // Do nothing.
         }
 
@@ -60,5 +89,15 @@ namespace cobalt {
         }
 
         void ArenaAllocator::arenaBlockDestroy(HeapAllocator& heap, ArenaBlock* block) { heap.drop(block->data); }
+
+        ArenaResource::ArenaResource(ArenaAllocator& arena) noexcept : arena(arena) {}
+
+        void* ArenaResource::do_allocate(size_t bytes, size_t alignment) { return arena.grab(bytes, alignment); }
+
+        void ArenaResource::do_deallocate(void*, size_t, size_t) {
+            // Do nothing.
+        }
+
+        bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
     }  // namespace core::memory
 }  // namespace cobalt
\ No newline at end of file
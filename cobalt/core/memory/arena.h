@@ -17,8 +17,9 @@ namespace cobalt {
             /**
              * @brief Creates an arena allocator with a given initial size.
              * @param initial_size The initial size of the arena.
+             * @param tag The tag the arena's blocks are charged to.
              */
-            ArenaAllocator(const size_t initial_size);
+            ArenaAllocator(const size_t initial_size, const MemoryTag tag = MemoryTag::General);
             /**
              * @brief Destroys an arena allocator.
              */
@@ -30,6 +31,13 @@ namespace cobalt {
              * @return A pointer to the allocated block.
              */
             void* grab(const size_t size);
+            /**
+             * @brief Allocates an aligned block of memory from the arena.
+             * @param size The size of the block to allocate.
+             * @param alignment The alignment of the block. Must be a power of two.
+             * @return A pointer to the allocated block.
+             */
+            void* grab(const size_t size, const size_t alignment);
             /**
              * @brief Resizes a block of memory from the arena.
              * Since the arena allocator does not resize individual blocks,
@@ -40,11 +48,21 @@ namespace cobalt {
              * @return A pointer to the resized block.
              */
             void* resize(void* ptr, const size_t size);
+            /**
+             * @brief Releases every block grabbed from the arena at once. The memory is kept around to be grabbed again, merged into a single
+             * block if the arena had to grow, so the next round fits without growing.
+             */
+            void reset();
             /**
              * @brief Calculate the allocated size of the arena.
              * @return The allocated size of the arena in bytes.
              */
             size_t getSize();
+            /**
+             * @brief Calculate the memory the arena holds on to, grabbed from or not.
+             * @return The reserved size of the arena in bytes.
+             */
+            size_t getReserved();
 
             private:
             struct ArenaBlock {
@@ -56,6 +74,7 @@ namespace cobalt {
             HeapAllocator heap;  // The heap allocator of the arena.
             ArenaBlock* blocks;  // The blocks of the arena.
             uint block_count;    // The number of blocks in the arena.
+            uint current;        // The block being grabbed from. The ones before it are full.
             size_t arena_size;   // The size of the arena.
 
             /**
@@ -96,5 +115,46 @@ namespace cobalt {
              */
             void arenaBlockDestroy(HeapAllocator& heap, ArenaBlock* block);
         };
+
+        /**
+         * @brief Adapts an arena allocator to std::pmr::memory_resource, so standard containers (std::pmr::vector, std::pmr::string, ...) can
+         * allocate from it. Deallocation does nothing: the memory comes back when the arena is reset.
+         */
+        class ArenaResource : public std::pmr::memory_resource {
+            public:
+            /**
+             * @brief Creates an adaptor for an arena.
+             * @param arena The arena to allocate from. Must outlive the adaptor.
+             */
+            explicit ArenaResource(ArenaAllocator& arena) noexcept;
+            /**
+             * @brief Default destructor.
+             */
+            ~ArenaResource() noexcept = default;
+
+            private:
+            ArenaAllocator& arena;  // The arena to allocate from.
+
+            /**
+             * @brief Allocates memory from the arena.
+             * @param bytes The size of the memory.
+             * @param alignment The alignment of the memory.
+             * @return A pointer to the memory.
+             */
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            /**
+             * @brief Does nothing. The memory is released when the arena is reset.
+             * @param ptr The memory.
+             * @param bytes The size of the memory.
+             * @param alignment The alignment of the memory.
+             */
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+            /**
+             * @brief Checks if memory from another resource can be deallocated by this one.
+             * @param other The other resource.
+             * @return True if the other resource is this one, false otherwise.
+             */
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+        };
     }  // namespace core::memory
 }  // namespace cobalt
\ No newline at end of file
@@ -0,0 +1,72 @@
+/**
+ * @file counting.h
+ * @brief A memory resource that counts the memory allocated through it before passing the request on.
+ * @author Tomás Marques
+ * @date 14-09-2024
+ */
+
+#pragma once
+
+#include "core/memory/tracker.h"
+#include "core/pch.h"
+
+namespace cobalt {
+    namespace core::memory {
+        /**
+         * @brief Counts the memory allocated through it, passing every request on to another resource. Not thread-safe, like the
+         * unsynchronized resources it is usually put in front of.
+         */
+        class CountingResource : public std::pmr::memory_resource {
+            public:
+            /**
+             * @brief Creates a counting resource.
+             * @param upstream The resource that actually allocates. Must outlive this one.
+             */
+            explicit CountingResource(std::pmr::memory_resource* upstream) noexcept : upstream(upstream), usage{0, 0, 0} {}
+            /**
+             * @brief Default destructor.
+             */
+            ~CountingResource() noexcept = default;
+
+            /**
+             * @brief Get the memory allocated through this resource.
+             * @return The usage.
+             */
+            const MemoryUsage& getUsage() const noexcept { return usage; }
+
+            private:
+            std::pmr::memory_resource* upstream;  ///< The resource that actually allocates.
+            MemoryUsage usage;                    ///< The memory allocated so far.
+
+            /**
+             * @brief Allocates memory upstream and counts it.
+             * @param bytes The size of the memory.
+             * @param alignment The alignment of the memory.
+             * @return A pointer to the memory.
+             */
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                void* ptr = upstream->allocate(bytes, alignment);
+                usage.bytes += bytes;
+                usage.peak = std::max(usage.peak, usage.bytes);
+                usage.allocations++;
+                return ptr;
+            }
+            /**
+             * @brief Deallocates memory upstream and stops counting it.
+             * @param ptr The memory.
+             * @param bytes The size of the memory.
+             * @param alignment The alignment of the memory.
+             */
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+                upstream->deallocate(ptr, bytes, alignment);
+                usage.bytes -= bytes;
+            }
+            /**
+             * @brief Checks if memory from another resource can be deallocated by this one.
+             * @param other The other resource.
+             * @return True if the other resource is this one, false otherwise.
+             */
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+        };
+    }  // namespace core::memory
+}  // namespace cobalt
@@ -5,11 +5,48 @@
 
 namespace cobalt {
     namespace core::memory {
+#ifdef CB_MEMORY_TRACKING
+        void* HeapAllocator::grab(const size_t size) {
+            char* block = (char*)malloc(HEADER_SIZE + size);
+            if (!block) {
+                return nullptr;
+            }
+            *(size_t*)block = size;
+            CB_TRACK_ALLOC(tag, size);
+            return block + HEADER_SIZE;
+        }
+
+        void HeapAllocator::drop(void* ptr) {
+            if (!ptr) {
+                return;
+            }
+            char* block = (char*)ptr - HEADER_SIZE;
+            CB_TRACK_FREE(tag, *(size_t*)block);
+            ::free(block);
+        }
+
+        void* HeapAllocator::resize(void* ptr, const size_t size) {
+            if (!ptr) {
+                return grab(size);
+            }
+            char* block = (char*)ptr - HEADER_SIZE;
+            const size_t old_size = *(size_t*)block;
+            block = (char*)::realloc(block, HEADER_SIZE + size);
+            if (!block) {
+                return nullptr;
+            }
+            *(size_t*)block = size;
+            CB_TRACK_FREE(tag, old_size);
+            CB_TRACK_ALLOC(tag, size);
+            return block + HEADER_SIZE;
+        }
+#else
         void* HeapAllocator::grab(const size_t size) { return malloc(size); }
 
         void HeapAllocator::drop(void* ptr) { ::free(ptr); }
 
         void* HeapAllocator::resize(void* ptr, const size_t size) { return ::realloc(ptr, size); }
+#endif
 
         void* HeapAllocator::alloc(const size_t size) { return grab(size); }
 
@@ -4,12 +4,22 @@
 #pragma once
 
 #include "core/memory/allocator.h"
+#include "core/memory/tracker.h"
 
 namespace cobalt {
     namespace core::memory {
+        /**
+         * @brief A heap allocator is a thin wrapper over malloc. With CB_MEMORY_TRACKING, every block
+         * carries a small header with its size, so it can be charged to the allocator's tag and taken
+         * off again when it is dropped.
+         */
         class HeapAllocator : public Allocator {
             public:
-            HeapAllocator() = default;
+            /**
+             * @brief Creates a heap allocator.
+             * @param tag The tag its memory is charged to.
+             */
+            HeapAllocator(const MemoryTag tag = MemoryTag::General) : tag(tag) {}
             ~HeapAllocator() = default;
 
             /**
@@ -29,8 +39,19 @@ namespace cobalt {
              * @param size The size in bytes of the block to reallocate.
              */
             void* resize(void* ptr, const size_t size);
+            /**
+             * @brief Get the tag the allocator's memory is charged to.
+             * @return The tag.
+             */
+            MemoryTag getTag() const { return tag; }
 
             private:
+#ifdef CB_MEMORY_TRACKING
+            static inline constexpr size_t HEADER_SIZE = alignof(std::max_align_t);  // The size header in front of every block.
+#endif
+
+            MemoryTag tag;  // The tag the memory is charged to.
+
             /**
              * @brief Allocates a block of memory from the heap.
              * @param size The size in bytes of the block to allocate.
@@ -12,75 +12,180 @@ namespace cobalt {
          * @brief A pool allocator is a memory allocator that allocates
          * memory in blocks of a fixed size. It is useful for allocating many objects
          * of the same type (e.g. components in an ECS).
+         * Free blocks are chained through their own memory, so grabbing and dropping
+         * a block are both a single pointer swap, no matter how many chunks the pool has.
+         * Blocks are aligned for T. The pool itself is not thread-safe: threads that
+         * share one should each go through their own PoolAllocator::Cache.
          */
         template <typename T>
         class PoolAllocator : public Allocator {
             public:
             /**
-             * @brief Creates a pool allocator with a given block capacity and block count.
-             * @param block_capacity The number of blocks in the pool.
+             * @brief Creates a pool allocator with a given block capacity.
+             * @param block_capacity The number of blocks in the first chunk. Every new chunk doubles the pool's capacity.
+             * @param tag The tag the pool's chunks are charged to.
              */
-            PoolAllocator(const uint block_capacity) : heap(), chunk_count(1), block_count(0) {
-                chunks = (PoolChunk*)heap.grab(sizeof(PoolChunk));
-                chunks[0] = poolChunkCreate(heap, block_capacity);
+            PoolAllocator(const uint block_capacity, const MemoryTag tag = MemoryTag::General)
+                : heap(tag), chunks(nullptr), chunk_count(0), free_list(nullptr), block_count(0), block_capacity(0) {
+                addChunk(std::max<uint>(block_capacity, 1));
             }
             /**
              * @brief Destroys a pool allocator.
              */
             ~PoolAllocator() {
                 for (uint i = 0; i < chunk_count; i++) {
-                    poolChunkDestroy(heap, &chunks[i]);
+                    CB_TRACK_FREE(heap.getTag(), chunks[i].end - chunks[i].begin);
+                    ::operator delete(chunks[i].data, std::align_val_t(BLOCK_ALIGNMENT));
                 }
                 heap.drop(chunks);
             }
+            PoolAllocator(const PoolAllocator&) = delete;
+            PoolAllocator& operator=(const PoolAllocator&) = delete;
 
             /**
              * @brief Allocates a block of memory from the pool.
              * @return A pointer to the allocated block.
              */
             T* grab() {
-                block_count++;
-                for (uint i = 0; i < chunk_count; i++) {
-                    if (chunks[i].block_count < chunks[i].block_capacity) {
-                        uint index = chunks[i].free_blocks[chunks[i].block_count++];
-                        return (T*)((char*)chunks[i].data + index * sizeof(T));
-                    }
+                if (!free_list) {
+                    addChunk(block_capacity);
                 }
-                chunks = (PoolChunk*)heap.resize(chunks, (chunk_count + 1) * sizeof(PoolChunk));
-                chunks[chunk_count++] = poolChunkCreate(heap, PoolAllocator<T>::getSize());
-                return (T*)((char*)chunks[chunk_count - 1].data + chunks[chunk_count - 1].block_count++ * sizeof(T));
+                FreeBlock* block = free_list;
+                free_list = block->next;
+                block_count++;
+                return (T*)block;
             }
             /**
              * @brief Frees a block of memory from the pool.
-             * @param ptr The pointer to the block to free.
+             * @param ptr The pointer to the block to free. Must have been grabbed from this pool.
              */
             void drop(T* ptr) {
+                FreeBlock* block = (FreeBlock*)ptr;
+                block->next = free_list;
+                free_list = block;
                 block_count--;
-                for (uint i = 0; i < chunk_count; i++) {
-                    if (ptr >= (T*)chunks[i].data && ptr < (T*)((char*)chunks[i].data + chunks[i].block_capacity * sizeof(T))) {
-                        chunks[i].free_blocks[--chunks[i].block_count] = (uint)((char*)ptr - (char*)chunks[i].data) / sizeof(T);
-                        return;
+            }
+            /**
+             * @brief Checks if a block belongs to the pool, with a binary search over its chunks.
+             * @param ptr The pointer to check.
+             * @return True if the pointer is inside one of the pool's chunks, false otherwise.
+             */
+            bool owns(const void* ptr) const {
+                const uintptr_t address = (uintptr_t)ptr;
+                uint low = 0, high = chunk_count;
+                while (low < high) {
+                    const uint middle = (low + high) / 2;
+                    if (address < chunks[middle].begin) {
+                        high = middle;
+                    } else if (address >= chunks[middle].end) {
+                        low = middle + 1;
+                    } else {
+                        return true;
                     }
                 }
+                return false;
             }
             /**
-             * @brief Calculate the allocated size of the pool.
+             * @brief Calculate the allocated size of the pool. Blocks held by caches count as allocated.
              * @return The allocated size of the pool in bytes.
              */
             size_t getSize() { return block_count * sizeof(T); }
 
+            private:
+            struct FreeBlock {
+                FreeBlock* next;  // The next free block.
+            };
+
+            public:
+            /**
+             * @brief A per-thread front for a shared pool. Blocks are grabbed and dropped locally, and only move to and from the
+             * pool in batches, under the pool's lock. Dropping a block into a different thread's cache than the one it came
+             * from is fine.
+             */
+            class Cache {
+                public:
+                /**
+                 * @brief Creates a cache over a pool.
+                 * @param pool The shared pool. Must outlive the cache.
+                 * @param batch_size The number of blocks moved from or to the pool at a time.
+                 */
+                Cache(PoolAllocator& pool, const uint batch_size = 64)
+                    : pool(pool), free_list(nullptr), free_count(0), batch_size(std::max<uint>(batch_size, 1)) {}
+                /**
+                 * @brief Returns every cached block to the pool.
+                 */
+                ~Cache() {
+                    std::lock_guard<std::mutex> lock(pool.mutex);
+                    while (free_list) {
+                        FreeBlock* block = free_list;
+                        free_list = block->next;
+                        pool.drop((T*)block);
+                    }
+                }
+                Cache(const Cache&) = delete;
+                Cache& operator=(const Cache&) = delete;
+
+                /**
+                 * @brief Allocates a block, refilling the cache from the pool if it is empty.
+                 * @return A pointer to the allocated block.
+                 */
+                T* grab() {
+                    if (!free_list) {
+                        std::lock_guard<std::mutex> lock(pool.mutex);
+                        for (; free_count < batch_size; free_count++) {
+                            FreeBlock* block = (FreeBlock*)pool.grab();
+                            block->next = free_list;
+                            free_list = block;
+                        }
+                    }
+                    FreeBlock* block = free_list;
+                    free_list = block->next;
+                    free_count--;
+                    return (T*)block;
+                }
+                /**
+                 * @brief Frees a block, handing a batch back to the pool once the cache holds too many.
+                 * @param ptr The pointer to the block to free. Must have been grabbed from the same pool.
+                 */
+                void drop(T* ptr) {
+                    FreeBlock* block = (FreeBlock*)ptr;
+                    block->next = free_list;
+                    free_list = block;
+                    if (++free_count >= 2 * batch_size) {
+                        std::lock_guard<std::mutex> lock(pool.mutex);
+                        for (; free_count > batch_size; free_count--) {
+                            block = free_list;
+                            free_list = block->next;
+                            pool.drop((T*)block);
+                        }
+                    }
+                }
+
+                private:
+                PoolAllocator& pool;   // The shared pool.
+                FreeBlock* free_list;  // The cached free blocks.
+                uint free_count;       // The number of cached free blocks.
+                uint batch_size;       // The number of blocks moved from or to the pool at a time.
+            };
+
             private:
             struct PoolChunk {
-                void* data;           // The data of the chunk.
-                uint* free_blocks;    // The indices of the free blocks.
-                uint block_count;     // The number of allocated blocks in the chunk.
-                uint block_capacity;  // The maximum number of blocks in the chunk.
+                void* data;       // The data of the chunk.
+                uintptr_t begin;  // The address of the first block.
+                uintptr_t end;    // The address past the last block.
             };
 
-            HeapAllocator heap;  // The allocator for the chunks.
-            PoolChunk* chunks;   // The chunks of memory allocated by the pool.
-            uint chunk_count;    // The number of chunks allocated by the pool.
-            uint block_count;    // The number of blocks allocated by the pool.
+            static inline constexpr size_t BLOCK_ALIGNMENT = std::max(alignof(T), alignof(FreeBlock));  // The alignment of every block.
+            static inline constexpr size_t BLOCK_SIZE =
+                (std::max(sizeof(T), sizeof(FreeBlock)) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;  // The size of every block.
+
+            HeapAllocator heap;     // The allocator for the chunk index. Also holds the pool's tag.
+            PoolChunk* chunks;      // The chunks of memory allocated by the pool, sorted by address.
+            uint chunk_count;       // The number of chunks allocated by the pool.
+            FreeBlock* free_list;   // The free blocks, most recently dropped first.
+            size_t block_count;     // The number of blocks allocated by the pool.
+            size_t block_capacity;  // The number of blocks in every chunk together.
+            std::mutex mutex;       // Guards the pool while caches move blocks to or from it.
 
             /**
              * @brief Allocates a block of memory from the pool.
@@ -102,28 +207,27 @@ namespace cobalt {
              */
             void* realloc(void* ptr, const size_t size) override { return nullptr; }
             /**
-             * @brief Creates a pool chunk with a given block capacity.
-             * @param block_capacity The number of blocks in the chunk.
-             * @return The created chunk.
+             * @brief Adds a chunk, threads its blocks onto the free list and files it in the sorted chunk index.
+             * @param capacity The number of blocks in the chunk.
              */
-            PoolChunk poolChunkCreate(HeapAllocator& heap, const uint block_capacity) {
-                PoolChunk chunk = {.data = heap.grab(block_capacity * sizeof(T)),
-                                   .free_blocks = (uint*)heap.grab(block_capacity * sizeof(uint)),
-                                   .block_count = 0,
-                                   .block_capacity = block_capacity};
-                for (uint i = 0; i < block_capacity; i++) {
-                    chunk.free_blocks[i] = i;
+            void addChunk(const size_t capacity) {
+                void* data = ::operator new(capacity * BLOCK_SIZE, std::align_val_t(BLOCK_ALIGNMENT));
+                CB_TRACK_ALLOC(heap.getTag(), capacity * BLOCK_SIZE);
+                char* bytes = (char*)data;
+                for (size_t i = capacity; i-- > 0;) {
+                    FreeBlock* block = (FreeBlock*)(bytes + i * BLOCK_SIZE);
+                    block->next = free_list;
+                    free_list = block;
                 }
-                return chunk;
-            }
-            /**
-             * @brief Destroys a pool chunk.
-             * @param chunk The chunk to destroy.
-             */
-            void poolChunkDestroy(HeapAllocator& heap, PoolChunk* chunk) {
-                heap.drop(chunk->data);
-                heap.drop(chunk->free_blocks);
+                const PoolChunk chunk = {.data = data, .begin = (uintptr_t)data, .end = (uintptr_t)data + capacity * BLOCK_SIZE};
+                chunks = (PoolChunk*)heap.resize(chunks, (chunk_count + 1) * sizeof(PoolChunk));
+                uint index = chunk_count++;
+                for (; index > 0 && chunks[index - 1].begin > chunk.begin; index--) {
+                    chunks[index] = chunks[index - 1];
+                }
+                chunks[index] = chunk;
+                block_capacity += capacity;
             }
         };
     }  // namespace core::memory
-}  // namespace cobalt
\ No newline at end of file
+}  // namespace cobalt
@@ -0,0 +1,107 @@
+/**
+ * @file stack.cpp
+ * @brief A stack allocator for nested temporary allocations, released in LIFO order through markers.
+ * @author Tomás Marques
+ * @date 16-09-2024
+ */
+
+#include "core/memory/stack.h"
+
+#include <cstring>
+
+namespace cobalt {
+    namespace core::memory {
+        StackAllocator::StackAllocator(const size_t initial_size, const MemoryTag tag)
+            : heap(tag), block_count(1), current(0), offset(0), stack_size(0) {
+            blocks = (StackBlock*)heap.grab(sizeof(StackBlock));
+            blocks[0] = {heap.grab(initial_size), initial_size};
+        }
+
+        StackAllocator::~StackAllocator() {
+            for (uint i = 0; i < block_count; i++) {
+                heap.drop(blocks[i].data);
+            }
+            heap.drop(blocks);
+        }
+
+        StackAllocator& StackAllocator::getScratch() {
+            static thread_local StackAllocator scratch(SCRATCH_SIZE);
+            return scratch;
+        }
+
+        void* StackAllocator::grab(const size_t size) { return grab(size, alignof(std::max_align_t)); }
+
+        void* StackAllocator::grab(const size_t size, const size_t alignment) {
+            while (true) {
+                StackBlock& block = blocks[current];
+                const uintptr_t base = (uintptr_t)block.data;
+                const size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+                if (aligned + size <= block.capacity) {
+                    offset = aligned + size;
+                    stack_size += size;
+                    return (void*)((char*)block.data + aligned);
+                }
+                if (current + 1 == block_count) {
+                    const size_t capacity = std::max(size + alignment - 1, 2 * blocks[block_count - 1].capacity);
+                    blocks = (StackBlock*)heap.resize(blocks, (block_count + 1) * sizeof(StackBlock));
+                    blocks[block_count++] = {heap.grab(capacity), capacity};
+                }
+                current++;
+                offset = 0;
+            }
+        }
+
+        void* StackAllocator::resize(void* ptr, const size_t old_size, const size_t size) {
+            if (!ptr) {
+                return grab(size);
+            }
+            StackBlock& block = blocks[current];
+            const size_t start = (char*)ptr - (char*)block.data;
+            if ((char*)ptr + old_size == (char*)block.data + offset && start + size <= block.capacity) {
+                offset = start + size;
+                stack_size = stack_size - old_size + size;
+                return ptr;
+            }
+            void* new_ptr = grab(size);
+            memcpy(new_ptr, ptr, std::min(old_size, size));
+            return new_ptr;
+        }
+
+        StackAllocator::Marker StackAllocator::getMarker() const { return {current, offset, stack_size}; }
+
+        void StackAllocator::freeToMarker(const Marker& marker) {
+            // A marker above the top was taken inside a scope that has already been freed.
+            assert((marker.block < current || (marker.block == current && marker.offset <= offset)) && "Markers must be freed in LIFO order.");
+            current = marker.block;
+            offset = marker.offset;
+            stack_size = marker.size;
+        }
+
+        void StackAllocator::reset() { freeToMarker({0, 0, 0}); }
+
+        void StackAllocator::trim() {
+            for (uint i = current + 1; i < block_count; i++) {
+                heap.drop(blocks[i].data);
+            }
+            block_count = current + 1;
+        }
+
+        size_t StackAllocator::getSize() const { return stack_size; }
+
+        size_t StackAllocator::getReserved() const {
+            size_t reserved = 0;
+            for (uint i = 0; i < block_count; i++) {
+                reserved += blocks[i].capacity;
+            }
+            return reserved;
+        }
+
+        void* StackAllocator::alloc(const size_t size) { return grab(size); }
+
+        void StackAllocator::free(void*) {
+            // Do nothing.
+        }
+
+        void* StackAllocator::realloc(void*, const size_t) { return nullptr; }
+    }  // namespace core::memory
+}  // namespace cobalt
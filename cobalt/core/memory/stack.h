@@ -0,0 +1,183 @@
+/**
+ * @file stack.h
+ * @brief A stack allocator for nested temporary allocations, released in LIFO order through markers.
+ * @author Tomás Marques
+ * @date 16-09-2024
+ */
+
+#pragma once
+
+#include <cassert>
+
+#include "core/memory/heap.h"
+
+namespace cobalt {
+    namespace core::memory {
+        /**
+         * @brief A stack allocator hands out memory at the cost of a pointer bump, like an arena, but can also give it back: take a
+         * marker, grab whatever is needed, then free everything grabbed since the marker at once. Markers must be freed in LIFO
+         * order, which debug builds check. The stack grows by adding blocks, and keeps them around after they are freed.
+         * Not thread-safe: each thread has its own scratch stack for temporary work.
+         * Example:
+         *
+         *          StackAllocator& scratch = StackAllocator::getScratch();
+         *          StackAllocator::ScopeGuard guard(scratch);
+         *          float* vertices = scratch.grabArray<float>(count);
+         *
+         */
+        class StackAllocator : public Allocator {
+            public:
+            static inline constexpr size_t SCRATCH_SIZE = 256 * 1024;  // The initial size of each thread's scratch stack.
+
+            /**
+             * @brief A position in the stack to free back to.
+             */
+            struct Marker {
+                uint block;     // The block that was on top.
+                size_t offset;  // The offset of the top in that block.
+                size_t size;    // The number of bytes grabbed below the top.
+            };
+
+            /**
+             * @brief Takes a marker when created and frees back to it when destroyed, so everything grabbed in between lives for the
+             * scope.
+             */
+            class ScopeGuard {
+                public:
+                /**
+                 * @brief Takes a marker.
+                 * @param stack The stack. Must outlive the guard.
+                 */
+                explicit ScopeGuard(StackAllocator& stack) : stack(stack), marker(stack.getMarker()) {}
+                /**
+                 * @brief Frees everything grabbed since the marker.
+                 */
+                ~ScopeGuard() { stack.freeToMarker(marker); }
+                ScopeGuard(const ScopeGuard&) = delete;
+                ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+                private:
+                StackAllocator& stack;  // The stack.
+                Marker marker;          // The top of the stack when the guard was created.
+            };
+
+            /**
+             * @brief Creates a stack allocator with a given initial size.
+             * @param initial_size The initial size of the stack.
+             * @param tag The tag the stack's blocks are charged to.
+             */
+            StackAllocator(const size_t initial_size, const MemoryTag tag = MemoryTag::General);
+            /**
+             * @brief Destroys a stack allocator.
+             */
+            ~StackAllocator();
+            StackAllocator(const StackAllocator&) = delete;
+            StackAllocator& operator=(const StackAllocator&) = delete;
+
+            /**
+             * @brief Gets the calling thread's scratch stack, creating it on first use.
+             * @return The scratch stack.
+             */
+            static StackAllocator& getScratch();
+
+            /**
+             * @brief Allocates a block of memory from the top of the stack.
+             * @param size The size of the block to allocate.
+             * @return A pointer to the allocated block, aligned for any scalar type.
+             */
+            void* grab(const size_t size);
+            /**
+             * @brief Allocates an aligned block of memory from the top of the stack.
+             * @param size The size of the block to allocate.
+             * @param alignment The alignment of the block. Must be a power of two.
+             * @return A pointer to the allocated block.
+             */
+            void* grab(const size_t size, const size_t alignment);
+            /**
+             * @brief Allocates an uninitialized array from the top of the stack.
+             * @tparam T The element type. Never destroyed, so it should be trivially destructible.
+             * @param count The number of elements.
+             * @return A pointer to the first element.
+             */
+            template <typename T>
+            T* grabArray(const size_t count) {
+                static_assert(std::is_trivially_destructible<T>::value, "T must be trivially destructible.");
+                return (T*)grab(count * sizeof(T), alignof(T));
+            }
+            /**
+             * @brief Resizes a block of memory. The block grows in place if it is the top of the stack and its block has room;
+             * otherwise a new block is grabbed and the contents copied over.
+             * @param ptr The pointer to the block to resize. May be nullptr, in which case this is a grab.
+             * @param old_size The current size of the block.
+             * @param size The new size of the block.
+             * @return A pointer to the resized block.
+             */
+            void* resize(void* ptr, const size_t old_size, const size_t size);
+
+            /**
+             * @brief Get a marker for the top of the stack.
+             * @return The marker.
+             */
+            Marker getMarker() const;
+            /**
+             * @brief Frees everything grabbed since a marker was taken. Markers taken after it become invalid.
+             * @param marker The marker. Must not be below a marker that was already freed.
+             */
+            void freeToMarker(const Marker& marker);
+            /**
+             * @brief Frees everything grabbed from the stack.
+             */
+            void reset();
+            /**
+             * @brief Releases the blocks above the top of the stack, for after an unusually large burst of allocations.
+             */
+            void trim();
+
+            /**
+             * @brief Calculate the allocated size of the stack.
+             * @return The allocated size of the stack in bytes.
+             */
+            size_t getSize() const;
+            /**
+             * @brief Calculate the memory the stack holds on to, grabbed from or not.
+             * @return The reserved size of the stack in bytes.
+             */
+            size_t getReserved() const;
+
+            private:
+            struct StackBlock {
+                void* data;       // The data of the block.
+                size_t capacity;  // The capacity in bytes of the block.
+            };
+
+            HeapAllocator heap;  // The heap allocator of the stack.
+            StackBlock* blocks;  // The blocks of the stack.
+            uint block_count;    // The number of blocks in the stack.
+            uint current;        // The block holding the top of the stack. The ones after it are empty.
+            size_t offset;       // The offset of the top of the stack in the current block.
+            size_t stack_size;   // The number of bytes grabbed from the stack.
+
+            /**
+             * @brief Allocates a block of memory from the top of the stack.
+             * @param size The size of the block to allocate.
+             * @return A pointer to the allocated block.
+             */
+            void* alloc(const size_t size) override;
+            /**
+             * @brief Frees a block of memory from the stack.
+             * Since the stack only frees to markers, this function does nothing.
+             * @param ptr The pointer to the block to free.
+             */
+            void free(void* ptr) override;
+            /**
+             * @brief Reallocates a block of memory from the stack.
+             * Since the stack does not know the block's old size, this function
+             * simply returns nullptr. Use resize() instead.
+             * @param ptr The pointer to the block to reallocate.
+             * @param size The new size of the block.
+             * @return nullptr.
+             */
+            void* realloc(void* ptr, const size_t size) override;
+        };
+    }  // namespace core::memory
+}  // namespace cobalt
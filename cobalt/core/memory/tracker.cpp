@@ -0,0 +1,176 @@
+/**
+ * @file tracker.cpp
+ * @brief Tagged memory tracking: how much memory each engine subsystem is using, and whether it is over budget.
+ * @author Tomás Marques
+ * @date 15-09-2024
+ */
+
+#include "core/memory/tracker.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace cobalt {
+    namespace core::memory {
+        namespace {
+            constexpr size_t TAG_COUNT = (size_t)MemoryTag::Count;
+
+            /**
+             * @brief The shared counters of one tag.
+             */
+            struct TagCounters {
+                std::atomic<int64_t> bytes = 0;         ///< The bytes flushed so far. Can dip below zero while another thread holds frees.
+                std::atomic<int64_t> peak = 0;          ///< The most bytes seen on a flush.
+                std::atomic<uint64_t> allocations = 0;  ///< The allocations flushed so far.
+                std::atomic<uint64_t> budget = 0;       ///< The budget, or 0 if there is none.
+                std::atomic<bool> exceeded = false;     ///< Whether the tag was over budget on the last flush.
+            };
+
+            /**
+             * @brief One thread's counters, flushed when the thread exits.
+             */
+            struct LocalCounters {
+                int64_t bytes[TAG_COUNT] = {};         ///< The bytes not flushed yet.
+                uint64_t allocations[TAG_COUNT] = {};  ///< The allocations not flushed yet.
+
+                /**
+                 * @brief Flushes whatever is left.
+                 */
+                ~LocalCounters() noexcept { MemoryTracker::flush(); }
+            };
+
+            TagCounters counters[TAG_COUNT];                     ///< The shared counters of every tag.
+            std::mutex callbackMutex;                            ///< Guards the budget callbacks.
+            MemoryTracker::BudgetCallback callbacks[TAG_COUNT];  ///< The budget callback of every tag.
+            thread_local LocalCounters local;                    ///< The calling thread's counters.
+
+            /**
+             * @brief Reads the shared counters of one tag.
+             * @param tag The tag.
+             * @return The usage.
+             */
+            MemoryUsage load(const size_t tag) noexcept {
+                return MemoryUsage{.bytes = (uint64_t)std::max<int64_t>(counters[tag].bytes.load(std::memory_order_relaxed), 0),
+                                   .peak = (uint64_t)counters[tag].peak.load(std::memory_order_relaxed),
+                                   .allocations = counters[tag].allocations.load(std::memory_order_relaxed)};
+            }
+        }  // namespace
+
+        const char* getMemoryTagName(const MemoryTag tag) noexcept {
+            switch (tag) {
+                case MemoryTag::General:
+                    return "General";
+                case MemoryTag::ECS:
+                    return "ECS";
+                case MemoryTag::Textures:
+                    return "Textures";
+                case MemoryTag::Meshes:
+                    return "Meshes";
+                case MemoryTag::Shaders:
+                    return "Shaders";
+                case MemoryTag::Events:
+                    return "Events";
+                default:
+                    return "Unknown";
+            }
+        }
+
+        void MemoryTracker::record(const MemoryTag tag, const size_t bytes) noexcept {
+            const size_t index = (size_t)tag;
+            local.bytes[index] += (int64_t)bytes;
+            local.allocations[index]++;
+            if (local.bytes[index] >= FLUSH_THRESHOLD) {
+                flush(tag);
+            }
+        }
+
+        void MemoryTracker::release(const MemoryTag tag, const size_t bytes) noexcept {
+            const size_t index = (size_t)tag;
+            local.bytes[index] -= (int64_t)bytes;
+            if (local.bytes[index] <= -FLUSH_THRESHOLD) {
+                flush(tag);
+            }
+        }
+
+        void MemoryTracker::flush() noexcept {
+            for (size_t tag = 0; tag < TAG_COUNT; tag++) {
+                flush((MemoryTag)tag);
+            }
+        }
+
+        MemoryUsage MemoryTracker::getUsage(const MemoryTag tag) noexcept {
+            flush();
+            return load((size_t)tag);
+        }
+
+        MemorySnapshot MemoryTracker::snapshot() noexcept {
+            flush();
+            MemorySnapshot snapshot;
+            for (size_t tag = 0; tag < TAG_COUNT; tag++) {
+                snapshot[tag] = load(tag);
+            }
+            return snapshot;
+        }
+
+        void MemoryTracker::setBudget(const MemoryTag tag, const uint64_t bytes, const BudgetCallback& callback) {
+            const size_t index = (size_t)tag;
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            callbacks[index] = callback;
+            counters[index].exceeded.store(false, std::memory_order_relaxed);
+            counters[index].budget.store(bytes, std::memory_order_release);
+        }
+
+        void MemoryTracker::clearBudget(const MemoryTag tag) {
+            const size_t index = (size_t)tag;
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            counters[index].budget.store(0, std::memory_order_release);
+            callbacks[index] = nullptr;
+        }
+
+        std::pmr::memory_resource* MemoryTracker::getResource(const MemoryTag tag) noexcept {
+#ifdef CB_MEMORY_TRACKING
+            static TrackedResource resources[TAG_COUNT] = {
+                {MemoryTag::General, std::pmr::new_delete_resource()},  {MemoryTag::ECS, std::pmr::new_delete_resource()},
+                {MemoryTag::Textures, std::pmr::new_delete_resource()}, {MemoryTag::Meshes, std::pmr::new_delete_resource()},
+                {MemoryTag::Shaders, std::pmr::new_delete_resource()},  {MemoryTag::Events, std::pmr::new_delete_resource()}};
+            return &resources[(size_t)tag];
+#else
+            (void)tag;
+            return std::pmr::new_delete_resource();
+#endif
+        }
+
+        void MemoryTracker::flush(const MemoryTag tag) noexcept {
+            const size_t index = (size_t)tag;
+            const int64_t delta = local.bytes[index];
+            const uint64_t allocations = local.allocations[index];
+            if (delta == 0 && allocations == 0) {
+                return;
+            }
+            local.bytes[index] = 0;
+            local.allocations[index] = 0;
+            TagCounters& shared = counters[index];
+            shared.allocations.fetch_add(allocations, std::memory_order_relaxed);
+            const int64_t bytes = shared.bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+            int64_t peak = shared.peak.load(std::memory_order_relaxed);
+            while (bytes > peak && !shared.peak.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+            }
+            const uint64_t budget = shared.budget.load(std::memory_order_acquire);
+            if (budget == 0) {
+                return;
+            }
+            if (bytes <= (int64_t)budget) {
+                shared.exceeded.store(false, std::memory_order_relaxed);
+            } else if (!shared.exceeded.exchange(true, std::memory_order_relaxed)) {
+                BudgetCallback callback;
+                {
+                    std::lock_guard<std::mutex> lock(callbackMutex);
+                    callback = callbacks[index];
+                }
+                if (callback) {
+                    callback(tag, load(index));
+                }
+            }
+        }
+    }  // namespace core::memory
+}  // namespace cobalt
@@ -0,0 +1,189 @@
+/**
+ * @file tracker.h
+ * @brief Tagged memory tracking: how much memory each engine subsystem is using, and whether it is over budget.
+ * @author Tomás Marques
+ * @date 15-09-2024
+ */
+
+#pragma once
+
+// The allocators core/pch.h pulls in include this header, so it only relies on the standard library.
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+
+#ifndef CB_MEMORY_TRACKING_FLUSH
+#define CB_MEMORY_TRACKING_FLUSH (64 * 1024)
+#endif
+
+#ifdef CB_MEMORY_TRACKING
+#define CB_TRACK_ALLOC(tag, bytes) ::cobalt::core::memory::MemoryTracker::record(tag, bytes)
+#define CB_TRACK_FREE(tag, bytes) ::cobalt::core::memory::MemoryTracker::release(tag, bytes)
+#else
+#define CB_TRACK_ALLOC(tag, bytes)
+#define CB_TRACK_FREE(tag, bytes)
+#endif
+
+namespace cobalt {
+    namespace core::memory {
+        /**
+         * @brief A snapshot of how much memory something is using.
+         */
+        struct MemoryUsage {
+            uint64_t bytes;        ///< The number of bytes currently allocated.
+            uint64_t peak;         ///< The most bytes that were ever allocated at once.
+            uint64_t allocations;  ///< The number of allocations made so far.
+        };
+
+        /**
+         * @brief The subsystem a piece of memory is charged to.
+         */
+        enum class MemoryTag : uint8_t {
+            General,   ///< Anything not charged to a subsystem.
+            ECS,       ///< Component columns, archetype tables and the frame arena.
+            Textures,  ///< Texture storage on the GPU.
+            Meshes,    ///< Vertex and index buffers on the GPU.
+            Shaders,   ///< Linked shader program binaries.
+            Events,    ///< Event channel buffers.
+            Count      ///< The number of tags.
+        };
+
+        /**
+         * @brief Gets the name of a memory tag.
+         * @param tag The tag.
+         * @return The name of the tag.
+         */
+        const char* getMemoryTagName(const MemoryTag tag) noexcept;
+
+        /**
+         * @brief The usage of every tag at one point in time, indexed by tag.
+         */
+        using MemorySnapshot = std::array<MemoryUsage, (size_t)MemoryTag::Count>;
+
+        /**
+         * @brief Keeps track of the memory charged to each tag. Allocators and GPU objects report to it through CB_TRACK_ALLOC and
+         * CB_TRACK_FREE, which compile to nothing unless CB_MEMORY_TRACKING is defined.
+         * Each thread counts into its own counters and only moves them into the shared ones once they drift by CB_MEMORY_TRACKING_FLUSH
+         * bytes, when it calls flush() or when it exits. Reported usage can therefore lag by up to that much per thread, and the peak is
+         * only sampled on those flushes.
+         */
+        class MemoryTracker {
+            public:
+            /**
+             * @brief Called when a tag goes over its budget, on whichever thread flushed it over. Called again only once the tag has come
+             * back under the budget and gone over it anew.
+             */
+            using BudgetCallback = std::function<void(const MemoryTag tag, const MemoryUsage& usage)>;
+
+            static inline constexpr int64_t FLUSH_THRESHOLD = CB_MEMORY_TRACKING_FLUSH;  ///< How far a thread's counters drift before flushing.
+
+            /**
+             * @brief Charges an allocation to a tag. Safe to call from any thread.
+             * @param tag The tag.
+             * @param bytes The size of the allocation.
+             */
+            static void record(const MemoryTag tag, const size_t bytes) noexcept;
+            /**
+             * @brief Takes a deallocation off a tag. Safe to call from any thread, including one other than the one that allocated.
+             * @param tag The tag.
+             * @param bytes The size of the deallocation.
+             */
+            static void release(const MemoryTag tag, const size_t bytes) noexcept;
+            /**
+             * @brief Moves the calling thread's counters into the shared ones.
+             */
+            static void flush() noexcept;
+
+            /**
+             * @brief Gets the usage of one tag, after flushing the calling thread.
+             * @param tag The tag.
+             * @return The usage.
+             */
+            static MemoryUsage getUsage(const MemoryTag tag) noexcept;
+            /**
+             * @brief Gets the usage of every tag, after flushing the calling thread.
+             * @return The snapshot.
+             */
+            static MemorySnapshot snapshot() noexcept;
+
+            /**
+             * @brief Sets a hard budget on a tag, replacing any previous one.
+             * @param tag The tag.
+             * @param bytes The most bytes the tag may use.
+             * @param callback Called when the tag goes over the budget.
+             */
+            static void setBudget(const MemoryTag tag, const uint64_t bytes, const BudgetCallback& callback);
+            /**
+             * @brief Removes the budget on a tag.
+             * @param tag The tag.
+             */
+            static void clearBudget(const MemoryTag tag);
+
+            /**
+             * @brief Gets a memory resource that allocates from the default heap and charges to a tag, for std::pmr containers.
+             * Without CB_MEMORY_TRACKING this is just std::pmr::new_delete_resource().
+             * @param tag The tag.
+             * @return The memory resource. Thread-safe and lives for the whole program.
+             */
+            static std::pmr::memory_resource* getResource(const MemoryTag tag) noexcept;
+
+            private:
+            /**
+             * @brief Moves the calling thread's counters for one tag into the shared ones, checking the budget.
+             * @param tag The tag.
+             */
+            static void flush(const MemoryTag tag) noexcept;
+        };
+
+        /**
+         * @brief Charges everything allocated through it to a tag, passing every request on to another resource. Thread-safe if the
+         * upstream resource is.
+         */
+        class TrackedResource : public std::pmr::memory_resource {
+            public:
+            /**
+             * @brief Creates a tracked resource.
+             * @param tag The tag to charge.
+             * @param upstream The resource that actually allocates. Must outlive this one.
+             */
+            TrackedResource(const MemoryTag tag, std::pmr::memory_resource* upstream) noexcept : tag(tag), upstream(upstream) {}
+            /**
+             * @brief Default destructor.
+             */
+            ~TrackedResource() noexcept = default;
+
+            private:
+            MemoryTag tag;                        ///< The tag to charge.
+            std::pmr::memory_resource* upstream;  ///< The resource that actually allocates.
+
+            /**
+             * @brief Allocates memory upstream and charges it.
+             * @param bytes The size of the memory.
+             * @param alignment The alignment of the memory.
+             * @return A pointer to the memory.
+             */
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                void* ptr = upstream->allocate(bytes, alignment);
+                MemoryTracker::record(tag, bytes);
+                return ptr;
+            }
+            /**
+             * @brief Deallocates memory upstream and stops charging it.
+             * @param ptr The memory.
+             * @param bytes The size of the memory.
+             * @param alignment The alignment of the memory.
+             */
+            void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+                upstream->deallocate(ptr, bytes, alignment);
+                MemoryTracker::release(tag, bytes);
+            }
+            /**
+             * @brief Checks if memory from another resource can be deallocated by this one.
+             * @param other The other resource.
+             * @return True if the other resource is this one, false otherwise.
+             */
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+        };
+    }  // namespace core::memory
+}  // namespace cobalt
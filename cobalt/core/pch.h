@@ -13,7 +13,9 @@
 
 #include <algorithm>
 #include <any>
+#include <atomic>
 #include <bitset>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
 #include <deque>
@@ -22,14 +24,19 @@
 #include <limits>
 #include <list>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
 #include <queue>
+#include <span>
 #include <sstream>
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <typeindex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
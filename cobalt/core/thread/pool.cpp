@@ -0,0 +1,135 @@
+/**
+ * @file pool.cpp
+ * @brief A work-stealing thread pool used to run independent tasks (e.g. systems) in parallel.
+ * @author Tomás Marques
+ * @date 03-09-2024
+ */
+
+#include "core/thread/pool.h"
+
+namespace cobalt {
+    namespace core::thread {
+        static thread_local const ThreadPool* currentPool = nullptr;  ///< The pool the calling thread works for, if any.
+        static thread_local uint64 currentQueue = 0;                  ///< The calling worker's queue.
+
+        ThreadPool::ThreadPool(const uint threadCount) : queues(), workers(), sleepMutex(), wakeup(), pending(0), nextQueue(0), stopping(false) {
+            queues.reserve(threadCount);
+            for (uint i = 0; i < threadCount; i++) {
+                queues.push_back(CreateScope<WorkQueue>());
+            }
+            workers.reserve(threadCount);
+            for (uint i = 0; i < threadCount; i++) {
+                workers.emplace_back(&ThreadPool::work, this, i);
+            }
+        }
+
+        ThreadPool::~ThreadPool() noexcept {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;
+            }
+            wakeup.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        void ThreadPool::submit(Task&& task) {
+            if (queues.empty()) {
+                task();
+                return;
+            }
+            const uint64 index = currentPool == this ? currentQueue : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                queues[index]->pushBack(Move(task));
+            }
+            pending.fetch_add(1, std::memory_order_release);
+            {
+                // Pairs with the predicate check in work(), so a worker can't miss the task between checking and going to sleep.
+                std::lock_guard<std::mutex> lock(sleepMutex);
+            }
+            wakeup.notify_one();
+        }
+
+        const bool ThreadPool::help() {
+            Task task;
+            if (!take(currentPool == this ? currentQueue : queues.size(), task)) {
+                return false;
+            }
+            task();
+            return true;
+        }
+
+        const uint ThreadPool::getThreadCount() const noexcept { return workers.size(); }
+
+        const uint ThreadPool::getDefaultThreadCount() noexcept { return std::max(std::thread::hardware_concurrency(), 2u) - 1; }
+
+        void ThreadPool::work(const uint64 index) noexcept {
+            currentPool = this;
+            currentQueue = index;
+            Task task;
+            while (true) {
+                if (take(index, task)) {
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wakeup.wait(lock, [this]() { return stopping || pending.load(std::memory_order_acquire) > 0; });
+                if (stopping && pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+            }
+        }
+
+        const bool ThreadPool::take(const uint64 index, Task& task) noexcept {
+            if (pending.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+            if (index < queues.size()) {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                if (queues[index]->size > 0) {
+                    task = queues[index]->popBack();
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            for (uint64 i = 1; i <= queues.size(); i++) {
+                WorkQueue& victim = *queues[(index + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.size > 0) {
+                    task = victim.popFront();
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void ThreadPool::WorkQueue::pushBack(Task&& task) {
+            if (size == tasks.size()) {
+                Vec<Task> grown(std::max<uint64>(tasks.size() * 2, 16));
+                for (uint64 i = 0; i < size; i++) {
+                    grown[i] = Move(tasks[(head + i) % tasks.size()]);
+                }
+                tasks = Move(grown);
+                head = 0;
+            }
+            tasks[(head + size) % tasks.size()] = Move(task);
+            size++;
+        }
+
+        ThreadPool::Task ThreadPool::WorkQueue::popBack() noexcept {
+            size--;
+            return Move(tasks[(head + size) % tasks.size()]);
+        }
+
+        ThreadPool::Task ThreadPool::WorkQueue::popFront() noexcept {
+            Task task = Move(tasks[head]);
+            head = (head + 1) % tasks.size();
+            size--;
+            return task;
+        }
+    }  // namespace core::thread
+}  // namespace cobalt
@@ -0,0 +1,126 @@
+/**
+ * @file pool.h
+ * @brief A work-stealing thread pool used to run independent tasks (e.g. systems) in parallel.
+ * @author Tomás Marques
+ * @date 03-09-2024
+ */
+
+#pragma once
+
+#include "core/pch.h"
+
+namespace cobalt {
+    namespace core::thread {
+        /**
+         * @brief A fixed set of worker threads, each with its own task queue. Workers run their own most recently pushed task first and steal the
+         * oldest task from another queue when theirs runs dry, which keeps related work on the same core and spreads the rest.
+         * The thread that owns the pool may help run pending tasks while it waits for them to finish.
+         */
+        class ThreadPool {
+            public:
+            using Task = Func<void()>;  ///< A unit of work.
+
+            /**
+             * @brief Creates a new ThreadPool and starts its workers.
+             * @param threadCount The number of worker threads.
+             */
+            explicit ThreadPool(const uint threadCount = getDefaultThreadCount());
+            /**
+             * @brief Runs every pending task, then stops and joins the workers.
+             */
+            ~ThreadPool() noexcept;
+            /**
+             * @brief Copy constructor (deleted).
+             * @param other The pool to copy.
+             */
+            ThreadPool(const ThreadPool&) noexcept = delete;
+            /**
+             * @brief Move constructor (deleted).
+             * @param other The pool to move.
+             */
+            ThreadPool(ThreadPool&&) noexcept = delete;
+            /**
+             * @brief Copy assignment operator (deleted).
+             * @param other The pool to copy.
+             */
+            ThreadPool& operator=(const ThreadPool&) noexcept = delete;
+            /**
+             * @brief Move assignment operator (deleted).
+             * @param other The pool to move.
+             */
+            ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+            /**
+             * @brief Queues a task. Tasks submitted from a worker go to that worker's own queue, others are spread over every queue.
+             * @param task The task to run.
+             */
+            void submit(Task&& task);
+            /**
+             * @brief Runs a single pending task on the calling thread, if there is one.
+             * @return True if a task was run, false if there was nothing to do.
+             */
+            const bool help();
+
+            /**
+             * @brief Get the number of worker threads.
+             * @return The number of worker threads.
+             */
+            const uint getThreadCount() const noexcept;
+            /**
+             * @brief Get the default number of worker threads: one less than the hardware concurrency, to leave a core for the calling thread,
+             * but at least one.
+             * @return The default number of worker threads.
+             */
+            static const uint getDefaultThreadCount() noexcept;
+
+            private:
+            /**
+             * @brief A worker's task queue. The owner pops from the back, thieves from the front.
+             * Tasks live in a ring buffer that only ever grows, so a pool that has warmed up queues tasks without allocating.
+             */
+            struct WorkQueue {
+                std::mutex mutex;  ///< Guards the tasks.
+                Vec<Task> tasks;   ///< The ring buffer.
+                uint64 head = 0;   ///< The front of the queue.
+                uint64 size = 0;   ///< The number of queued tasks.
+
+                /**
+                 * @brief Push a task to the back of the queue.
+                 * @param task The task.
+                 */
+                void pushBack(Task&& task);
+                /**
+                 * @brief Pop the task at the back of the queue. The queue must not be empty.
+                 * @return The task.
+                 */
+                Task popBack() noexcept;
+                /**
+                 * @brief Pop the task at the front of the queue. The queue must not be empty.
+                 * @return The task.
+                 */
+                Task popFront() noexcept;
+            };
+
+            Vec<Scope<WorkQueue>> queues;    ///< One queue per worker.
+            Vec<std::thread> workers;        ///< The worker threads.
+            std::mutex sleepMutex;           ///< Guards sleeping workers.
+            std::condition_variable wakeup;  ///< Wakes sleeping workers when tasks are submitted or the pool stops.
+            std::atomic<uint64> pending;     ///< The number of queued tasks that have not been taken yet.
+            std::atomic<uint64> nextQueue;   ///< Round-robin queue for tasks submitted from outside the pool.
+            std::atomic<bool> stopping;      ///< Whether the pool is shutting down.
+
+            /**
+             * @brief The worker thread's main loop.
+             * @param index The worker's queue.
+             */
+            void work(const uint64 index) noexcept;
+            /**
+             * @brief Takes a task, preferring the given queue and stealing from the others.
+             * @param index The preferred queue, or the number of queues for none.
+             * @param task Set to the taken task.
+             * @return True if a task was taken, false otherwise.
+             */
+            const bool take(const uint64 index, Task& task) noexcept;
+        };
+    }  // namespace core::thread
+}  // namespace cobalt
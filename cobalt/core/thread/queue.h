@@ -0,0 +1,158 @@
+/**
+ * @file queue.h
+ * @brief A bounded, lock-free queue that any number of threads can push into and a single thread drains.
+ * @author Tomás Marques
+ * @date 11-09-2024
+ */
+
+#pragma once
+
+#include <bit>
+
+#include "core/pch.h"
+
+namespace cobalt {
+    namespace core::thread {
+        /**
+         * @brief A bounded multi-producer, single-consumer ring buffer. Producers claim a slot with a single compare-and-swap and never wait on
+         * each other or on the consumer: when the ring is full the value is dropped and counted instead. Each slot carries a sequence number
+         * that tells whether it is free to write, ready to read or still being written, so no locks are needed on either side.
+         * Drops and the fullest the ring has been are tracked, so callers can size it and notice backpressure.
+         * @tparam T The value type. Must be default constructible and movable.
+         */
+        template <typename T>
+        class MPSCQueue {
+            public:
+            /**
+             * @brief Creates a new MPSCQueue.
+             * @param capacity The maximum number of queued values. Rounded up to a power of two.
+             */
+            explicit MPSCQueue(const uint64 capacity)
+                : cells(), mask(std::bit_ceil(std::max(capacity, uint64(2))) - 1), tail(0), head(0), drops(0), highWaterMark(0) {
+                cells = CreateScope<Cell[]>(mask + 1);
+                for (uint64 i = 0; i <= mask; i++) {
+                    cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+            /**
+             * @brief Default destructor.
+             */
+            ~MPSCQueue() noexcept = default;
+            /**
+             * @brief Copy constructor (deleted).
+             * @param other The queue to copy.
+             */
+            MPSCQueue(const MPSCQueue&) noexcept = delete;
+            /**
+             * @brief Copy assignment operator (deleted).
+             * @param other The queue to copy.
+             */
+            MPSCQueue& operator=(const MPSCQueue&) noexcept = delete;
+
+            /**
+             * @brief Pushes a value. Safe to call from any thread.
+             * @param value The value. Moved from if it was queued.
+             * @return True if the value was queued, false if the queue was full and it was dropped.
+             */
+            bool push(T&& value) noexcept {
+                uint64 position = tail.load(std::memory_order_relaxed);
+                Cell* cell;
+                while (true) {
+                    cell = &cells[position & mask];
+                    const uint64 sequence = cell->sequence.load(std::memory_order_acquire);
+                    const int64 distance = int64(sequence - position);
+                    if (distance == 0) {
+                        if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (distance < 0) {
+                        drops.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    } else {
+                        position = tail.load(std::memory_order_relaxed);
+                    }
+                }
+                cell->value = Move(value);
+                cell->sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+            /**
+             * @brief Pushes a copy of a value. Safe to call from any thread.
+             * @param value The value.
+             * @return True if the value was queued, false if the queue was full and it was dropped.
+             */
+            bool push(const T& value) noexcept { return push(T(value)); }
+
+            /**
+             * @brief Pops the oldest value whose push has finished. Only the consumer thread may call this.
+             * @return The value, or nothing if the queue is empty.
+             */
+            Opt<T> pop() noexcept {
+                Cell& cell = cells[head & mask];
+                if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+                    return None;
+                }
+                T value = Move(cell.value);
+                cell.sequence.store(head + mask + 1, std::memory_order_release);
+                head++;
+                return value;
+            }
+            /**
+             * @brief Pops and handles the values queued when the drain starts. Values pushed while draining are left for the next drain, so
+             * producers can never keep the consumer busy forever. Only the consumer thread may call this.
+             * @tparam Handler The handler type. Must be invocable with a T&&.
+             * @param handler Called once per value, oldest first.
+             * @return The number of values handled.
+             */
+            template <typename Handler>
+            uint64 drain(Handler&& handler) {
+                const uint64 queued = std::min(tail.load(std::memory_order_relaxed) - head, mask + 1);
+                highWaterMark = std::max(highWaterMark, queued);
+                uint64 handled = 0;
+                for (; handled < queued; handled++) {
+                    Opt<T> value = pop();
+                    if (!value) {
+                        break;
+                    }
+                    handler(Move(*value));
+                }
+                return handled;
+            }
+
+            /**
+             * @brief Get the maximum number of queued values.
+             * @return The capacity.
+             */
+            const uint64 getCapacity() const noexcept { return mask + 1; }
+            /**
+             * @brief Get the number of values dropped because the queue was full.
+             * @return The number of drops.
+             */
+            const uint64 getDrops() const noexcept { return drops.load(std::memory_order_relaxed); }
+            /**
+             * @brief Get the most values that were ever waiting at the start of a drain. Only the consumer thread may call this.
+             * @return The high-water mark.
+             */
+            const uint64 getHighWaterMark() const noexcept { return highWaterMark; }
+
+            private:
+            static inline constexpr uint64 CACHE_LINE = 64;  ///< Keeps the producers' and the consumer's positions off each other's cache line.
+
+            /**
+             * @brief A slot in the ring. A sequence equal to the slot's position means it is free to write, one past it means the value is
+             * ready to read.
+             */
+            struct Cell {
+                std::atomic<uint64> sequence;  ///< The slot's sequence number.
+                T value;                       ///< The queued value.
+            };
+
+            Scope<Cell[]> cells;                           ///< The ring.
+            uint64 mask;                                   ///< The capacity minus one.
+            alignas(CACHE_LINE) std::atomic<uint64> tail;  ///< The next position to push to.
+            alignas(CACHE_LINE) uint64 head;               ///< The next position to pop from.
+            std::atomic<uint64> drops;                     ///< The number of dropped values.
+            uint64 highWaterMark;                          ///< The most values seen waiting by a drain.
+        };
+    }  // namespace core::thread
+}  // namespace cobalt
@@ -0,0 +1,294 @@
+/**
+ * @file profiler.cpp
+ * @brief A frame profiler: how long each system, schedule, render node and event hook takes, with a Chrome trace export.
+ * @author Tomás Marques
+ * @date 17-09-2024
+ */
+
+#include "core/utils/profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+namespace cobalt {
+    namespace core {
+        namespace {
+            /**
+             * @brief The last runs of one scope, in a ring.
+             */
+            struct Samples {
+                uint64 times[Profiler::WINDOW];  ///< The duration of each run in nanoseconds.
+                uint64 count = 0;                ///< The number of runs so far.
+            };
+
+            /**
+             * @brief One run of a scope, as recorded by a thread and waiting to be merged.
+             */
+            struct Run {
+                uint name;        ///< The interned name of the scope.
+                uint category;    ///< The interned name of what the scope belongs to.
+                uint64 start;     ///< When the run started.
+                uint64 duration;  ///< How long the run took.
+                bool captured;    ///< Whether a capture was in progress when the run was recorded.
+            };
+
+            /**
+             * @brief The runs a thread recorded since they were last merged. Only its own thread and merges touch it, so its lock is
+             * almost never contended.
+             */
+            struct ThreadBuffer {
+                std::mutex mutex;  ///< Guards the runs.
+                Vec<Run> runs;     ///< The runs recorded since the last merge.
+                uint thread;       ///< The thread's index in traces.
+            };
+
+            /**
+             * @brief One run of a scope, as written to a trace.
+             */
+            struct TraceEvent {
+                std::string_view name;      ///< The name of the scope.
+                std::string_view category;  ///< What the scope belongs to.
+                uint64 start;               ///< When the run started.
+                uint64 duration;            ///< How long the run took.
+                uint thread;                ///< The thread the run was on.
+            };
+
+            std::mutex mutex;                            ///< Guards everything below.
+            std::deque<std::string> names;               ///< Every interned name, indexed by id. Never shrinks, so views into it stay valid.
+            UMap<std::string_view, uint> ids;            ///< The id of every interned name.
+            Vec<Samples> samples;                        ///< The last runs of every scope, indexed by the id of its name.
+            Vec<Shared<ThreadBuffer>> buffers;           ///< The buffer of every thread that recorded a run, kept after the thread exits.
+            Vec<Run> drained;                            ///< Scratch space for merging a buffer's runs, swapped back to keep its capacity.
+            Vec<TraceEvent> events;                      ///< The runs captured so far.
+            std::string capturePath;                     ///< The file the capture is written to.
+            uint captureFrames = 0;                      ///< The frames left to capture, or 0 if no capture is in progress.
+            uint64 frameStart = 0;                       ///< When the current captured frame started.
+            std::atomic<bool> capturing = false;         ///< Whether a capture is in progress, read by recording threads without the lock.
+            std::atomic<uint> threadCount = 0;           ///< The number of threads that recorded a run so far.
+            thread_local uint threadId = threadCount++;  ///< The calling thread's index in traces.
+
+            /**
+             * @brief Interns a name, giving it an id and a slot for its statistics the first time it is seen. The lock must be held.
+             * @param name The name.
+             * @return The name's id.
+             */
+            uint intern(const std::string_view name) {
+                const auto found = ids.find(name);
+                if (found != ids.end()) {
+                    return found->second;
+                }
+                const uint id = (uint)names.size();
+                names.emplace_back(name);
+                ids.emplace(names.back(), id);
+                samples.emplace_back();
+                return id;
+            }
+
+            /**
+             * @brief What a thread keeps to record runs without taking the lock: its buffer, and the ids of the names it has seen.
+             */
+            struct ThreadState {
+                Shared<ThreadBuffer> buffer;         ///< The thread's buffer, also listed in buffers.
+                UMap<std::string_view, uint> known;  ///< The ids of the names this thread interned, keyed by views into names.
+
+                /**
+                 * @brief Creates the thread's buffer and lists it for merging.
+                 */
+                ThreadState() : buffer(CreateShared<ThreadBuffer>()) {
+                    buffer->thread = threadId;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    buffers.push_back(buffer);
+                }
+
+                /**
+                 * @brief Gets the id of a name, only taking the lock the first time this thread sees it.
+                 * @param name The name.
+                 * @return The name's id.
+                 */
+                uint getId(const std::string_view name) {
+                    const auto found = known.find(name);
+                    if (found != known.end()) {
+                        return found->second;
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    const uint id = intern(name);
+                    known.emplace(names[id], id);
+                    return id;
+                }
+            };
+            thread_local ThreadState threadState;  ///< The calling thread's state.
+
+            /**
+             * @brief Moves the runs every thread recorded into the statistics, and into the capture if they were recorded during one. The
+             * lock must be held.
+             */
+            void merge() {
+                for (const auto& buffer : buffers) {
+                    {
+                        std::lock_guard<std::mutex> lock(buffer->mutex);
+                        drained.swap(buffer->runs);
+                    }
+                    for (const Run& run : drained) {
+                        Samples& scope = samples[run.name];
+                        scope.times[scope.count++ % Profiler::WINDOW] = run.duration;
+                        if (run.captured) {
+                            events.push_back({names[run.name], names[run.category], run.start, run.duration, buffer->thread});
+                        }
+                    }
+                    drained.clear();
+                }
+            }
+
+            /**
+             * @brief Converts nanoseconds to the microseconds statistics and traces are in.
+             * @param nanoseconds The time in nanoseconds.
+             * @return The time in microseconds.
+             */
+            double toMicroseconds(const uint64 nanoseconds) noexcept { return (double)nanoseconds / 1000.0; }
+
+            /**
+             * @brief Appends a string to a JSON document as a string literal.
+             * @param json The JSON document.
+             * @param string The string.
+             */
+            void appendString(std::string& json, const std::string_view string) {
+                json += '"';
+                for (const char c : string) {
+                    if (c == '"' || c == '\\') {
+                        json += '\\';
+                        json += c;
+                    } else if ((unsigned char)c < 0x20) {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        json += escaped;
+                    } else {
+                        json += c;
+                    }
+                }
+                json += '"';
+            }
+
+            /**
+             * @brief Writes captured runs as a Chrome trace.
+             * @param path The file to write to.
+             * @param captured The captured runs.
+             */
+            void writeTrace(const std::string& path, const Vec<TraceEvent>& captured) {
+                std::string json = "{\"traceEvents\":[";
+                char numbers[96];
+                for (uint64 i = 0; i < captured.size(); i++) {
+                    const TraceEvent& event = captured[i];
+                    json += i == 0 ? "{\"name\":" : ",\n{\"name\":";
+                    appendString(json, event.name);
+                    json += ",\"cat\":";
+                    appendString(json, event.category);
+                    snprintf(numbers, sizeof(numbers), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}", toMicroseconds(event.start),
+                             toMicroseconds(event.duration), event.thread);
+                    json += numbers;
+                }
+                json += "],\"displayTimeUnit\":\"ms\"}\n";
+                io::File(io::Path(path, false)).write(json);
+            }
+        }  // namespace
+
+        uint64 Profiler::now() noexcept {
+            static const auto epoch = std::chrono::steady_clock::now();
+            return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+        }
+
+        void Profiler::record(const std::string_view name, const std::string_view category, const uint64 start, const uint64 end) {
+            const Run run = {threadState.getId(name), threadState.getId(category), start, end - start, capturing.load(std::memory_order_relaxed)};
+            std::lock_guard<std::mutex> lock(threadState.buffer->mutex);
+            threadState.buffer->runs.push_back(run);
+        }
+
+        void Profiler::endFrame() {
+            Vec<TraceEvent> captured;
+            std::string path;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                merge();
+                if (captureFrames == 0) {
+                    return;
+                }
+                const uint64 end = now();
+                const std::string_view frame = names[intern("Frame")];
+                events.push_back({frame, frame, frameStart, end - frameStart, threadId});
+                frameStart = end;
+                if (--captureFrames > 0) {
+                    return;
+                }
+                capturing = false;
+                captured = Move(events);
+                path = Move(capturePath);
+                events.clear();
+            }
+            // Writing can take a while, so other threads keep recording in the meantime.
+            writeTrace(path, captured);
+        }
+
+        ProfileStats Profiler::getStats(const std::string& name) {
+            uint64 times[WINDOW];
+            uint64 count;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                merge();
+                const auto id = ids.find(name);
+                if (id == ids.end() || samples[id->second].count == 0) {
+                    return {0, 0.0, 0.0, 0.0, 0.0};
+                }
+                const Samples& scope = samples[id->second];
+                count = std::min(scope.count, WINDOW);
+                std::copy(scope.times, scope.times + count, times);
+            }
+            std::sort(times, times + count);
+            uint64 total = 0;
+            for (uint64 i = 0; i < count; i++) {
+                total += times[i];
+            }
+            // Nearest-rank percentiles.
+            const uint64 p50 = (count + 1) / 2 - 1;
+            const uint64 p99 = (count * 99 + 99) / 100 - 1;
+            return {count, toMicroseconds(total) / count, toMicroseconds(times[p50]), toMicroseconds(times[p99]), toMicroseconds(times[count - 1])};
+        }
+
+        Vec<std::string> Profiler::getNames() {
+            std::lock_guard<std::mutex> lock(mutex);
+            merge();
+            Vec<std::string> ran;
+            for (uint id = 0; id < samples.size(); id++) {
+                if (samples[id].count > 0) {
+                    ran.push_back(names[id]);
+                }
+            }
+            return ran;
+        }
+
+        void Profiler::reset() {
+            std::lock_guard<std::mutex> lock(mutex);
+            merge();
+            // Names stay interned, as threads keep their ids.
+            for (Samples& scope : samples) {
+                scope.count = 0;
+            }
+        }
+
+        void Profiler::capture(const io::Path& path, const uint frames) {
+            std::lock_guard<std::mutex> lock(mutex);
+            // Runs recorded during a capture this one replaces must not end up in it.
+            merge();
+            events.clear();
+            capturePath = path.getPath();
+            captureFrames = frames;
+            frameStart = now();
+            capturing = frames > 0;
+        }
+
+        bool Profiler::isCapturing() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return captureFrames > 0;
+        }
+    }  // namespace core
+}  // namespace cobalt
@@ -0,0 +1,129 @@
+/**
+ * @file profiler.h
+ * @brief A frame profiler: how long each system, schedule, render node and event hook takes, with a Chrome trace export.
+ * @author Tomás Marques
+ * @date 17-09-2024
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "core/io/file.h"
+#include "core/pch.h"
+
+#ifndef CB_PROFILING_WINDOW
+#define CB_PROFILING_WINDOW 128
+#endif
+
+#define CB_PROFILE_CONCAT_INNER(a, b) a##b
+#define CB_PROFILE_CONCAT(a, b) CB_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef CB_PROFILING
+#define CB_PROFILE_SCOPE(name, category) ::cobalt::core::ProfileScope CB_PROFILE_CONCAT(profileScope, __LINE__)(name, category)
+#define CB_PROFILE_FRAME() ::cobalt::core::Profiler::endFrame()
+#else
+#define CB_PROFILE_SCOPE(name, category)
+#define CB_PROFILE_FRAME()
+#endif
+
+namespace cobalt {
+    namespace core {
+        /**
+         * @brief Rolling statistics of how long something took, over its last CB_PROFILING_WINDOW runs. Times are in microseconds.
+         */
+        struct ProfileStats {
+            uint64 samples;  ///< The number of runs the statistics cover.
+            double mean;     ///< The mean time.
+            double p50;      ///< The median time.
+            double p99;      ///< The 99th percentile time.
+            double max;      ///< The longest time.
+        };
+
+        /**
+         * @brief Keeps timings of named scopes: every system and schedule the SystemManager runs, every render graph node and every event
+         * hook. Scopes report to it through CB_PROFILE_SCOPE, and frames end with CB_PROFILE_FRAME, both of which compile to nothing unless
+         * CB_PROFILING is defined.
+         * Statistics are kept by name, so scopes that should be told apart need different names. A capture records every scope of the next
+         * few frames and writes them to a file as Chrome trace events, which chrome://tracing and Perfetto can open.
+         * Every function is thread-safe. Runs are buffered by the thread that records them, with names interned into ids, so recording
+         * doesn't wait on other threads; they are merged into the statistics when a frame ends or statistics are read.
+         */
+        class Profiler {
+            public:
+            static inline constexpr uint64 WINDOW = CB_PROFILING_WINDOW;  ///< The number of runs the statistics of each scope cover.
+
+            /**
+             * @brief Gets the current time on the profiler's clock.
+             * @return The time in nanoseconds since the profiler was first used.
+             */
+            static uint64 now() noexcept;
+            /**
+             * @brief Records one run of a scope.
+             * @param name The name of the scope.
+             * @param category What the scope belongs to, e.g. the schedule of a system.
+             * @param start When the run started, as returned by now().
+             * @param end When the run ended, as returned by now().
+             */
+            static void record(const std::string_view name, const std::string_view category, const uint64 start, const uint64 end);
+            /**
+             * @brief Ends a frame, writing the capture in progress once it covers all of its frames.
+             */
+            static void endFrame();
+
+            /**
+             * @brief Gets the statistics of a scope.
+             * @param name The name of the scope.
+             * @return The statistics, all zero if the scope never ran.
+             */
+            static ProfileStats getStats(const std::string& name);
+            /**
+             * @brief Gets the names of every scope that ran so far.
+             * @return The names.
+             */
+            static Vec<std::string> getNames();
+            /**
+             * @brief Forgets the statistics of every scope.
+             */
+            static void reset();
+
+            /**
+             * @brief Starts capturing every scope until a number of frames have ended, then writes them as a Chrome trace. Replaces any
+             * capture in progress.
+             * @param path The file to write the trace to. Its directory must exist.
+             * @param frames The number of frames to capture.
+             */
+            static void capture(const io::Path& path, const uint frames = 1);
+            /**
+             * @brief Checks if a capture is in progress.
+             * @return True if a capture is in progress, false otherwise.
+             */
+            static bool isCapturing();
+        };
+
+        /**
+         * @brief Times the scope it lives in, recording it with the profiler when destroyed. Use through CB_PROFILE_SCOPE.
+         */
+        class ProfileScope {
+            public:
+            /**
+             * @brief Starts timing.
+             * @param name The name of the scope. Only needs to outlive the scope, as it is interned when recorded.
+             * @param category What the scope belongs to. Only needs to outlive the scope.
+             */
+            ProfileScope(const std::string_view name, const std::string_view category) noexcept
+                : name(name), category(category), start(Profiler::now()) {}
+            /**
+             * @brief Stops timing and records the run.
+             */
+            ~ProfileScope() { Profiler::record(name, category, start, Profiler::now()); }
+            ProfileScope(const ProfileScope&) = delete;
+            ProfileScope& operator=(const ProfileScope&) = delete;
+
+            private:
+            std::string_view name;      ///< The name of the scope.
+            std::string_view category;  ///< What the scope belongs to.
+            uint64 start;               ///< When the scope started.
+        };
+    }  // namespace core
+}  // namespace cobalt
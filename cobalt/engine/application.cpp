@@ -5,6 +5,7 @@
 
 #include "core/exception.h"
 #include "core/gl/context.h"
+#include "core/utils/profiler.h"
 #include "engine/bundle/base.h"
 
 namespace cobalt {
@@ -31,8 +32,11 @@ namespace cobalt {
             CB_INFO("Starting up game loop");
 
             uint64_t delta = 1000000 / targetFramerate, acc = 0, frametime = 0, counter = 0;
+            world.setTimestep((double)delta / 1000000.0);
             uint frames = 0;
             struct timespec start, end;
+            core::ecs::ResourceSlot<Time> timeSlot;
+            core::ecs::ResourceSlot<core::ecs::FrameArena> arenaSlot;
             while (!shouldStop && !shutdownInterrupt) {
                 clock_gettime(CLOCK_MONOTONIC_RAW, &start);
 
@@ -51,7 +55,7 @@ namespace cobalt {
                     frames = 0;
                 }
                 float delta = (float)frametime / 1000000.0f;
-                Time& time = world.getResource<Time>();
+                Time& time = world.getResource(timeSlot);
                 time.deltaTime = delta;
                 time.elapsedTime += delta;
 
@@ -63,6 +67,8 @@ namespace cobalt {
                 world.render();
                 variableTimeStep(delta);
                 window.swapBuffers();
+                world.getResource(arenaSlot).reset();
+                CB_PROFILE_FRAME();
 
                 clock_gettime(CLOCK_MONOTONIC_RAW, &end);
                 frametime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
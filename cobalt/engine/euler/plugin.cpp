@@ -22,38 +22,38 @@ namespace cobalt {
             /**
              * @brief Euler integration system.
              */
-            world.addSystem<ecs::Query<Transform&, const Velocity&>, ecs::ReadRequest<Time>>(ecs::DefaultSchedules::Update,
-                                                                                             [](auto query, auto time) {
-                                                                                                 const float deltaTime = time->getDeltaTime();
-                                                                                                 for (auto [transform, velocity] : query) {
-                                                                                                     transform.x += velocity.x * deltaTime;
-                                                                                                     transform.y += velocity.y * deltaTime;
-                                                                                                     transform.z += velocity.z * deltaTime;
-                                                                                                 }
-                                                                                             });
+            world.addSystem<ecs::Query<Transform&, const Velocity&>, ecs::ReadRequest<Time>>(
+                ecs::DefaultSchedules::Update, [](auto query, auto time) {
+                    const float deltaTime = time->getDeltaTime();
+                    query.parForEach([deltaTime](Transform& transform, const Velocity& velocity) {
+                        transform.x += velocity.x * deltaTime;
+                        transform.y += velocity.y * deltaTime;
+                        transform.z += velocity.z * deltaTime;
+                    });
+                });
             /**
              * @brief Euler integration system.
              */
-            world.addSystem<ecs::Query<Velocity&, const Acceleration&>, ecs::ReadRequest<Time>>(ecs::DefaultSchedules::Update,
-                                                                                                [](auto query, auto time) {
-                                                                                                    const float deltaTime = time->getDeltaTime();
-                                                                                                    for (auto [velocity, acceleration] : query) {
-                                                                                                        velocity.x += acceleration.x * deltaTime;
-                                                                                                        velocity.y += acceleration.y * deltaTime;
-                                                                                                        velocity.z += acceleration.z * deltaTime;
-                                                                                                    }
-                                                                                                });
+            world.addSystem<ecs::Query<Velocity&, const Acceleration&>, ecs::ReadRequest<Time>>(
+                ecs::DefaultSchedules::Update, [](auto query, auto time) {
+                    const float deltaTime = time->getDeltaTime();
+                    query.parForEach([deltaTime](Velocity& velocity, const Acceleration& acceleration) {
+                        velocity.x += acceleration.x * deltaTime;
+                        velocity.y += acceleration.y * deltaTime;
+                        velocity.z += acceleration.z * deltaTime;
+                    });
+                });
             /**
              * @brief Euler integration system.
              */
             world.addSystem<ecs::Query<Transform&, const AngularVelocity&>, ecs::ReadRequest<Time>>(
                 ecs::DefaultSchedules::Update, [](auto query, auto time) {
                     const float deltaTime = time->getDeltaTime();
-                    for (auto [transform, angularVelocity] : query) {
+                    query.parForEach([deltaTime](Transform& transform, const AngularVelocity& angularVelocity) {
                         transform.rotation.x += angularVelocity.x * deltaTime;
                         transform.rotation.y += angularVelocity.y * deltaTime;
                         transform.rotation.z += angularVelocity.z * deltaTime;
-                    }
+                    });
                 });
             /**
              * @brief Euler integration system.
@@ -61,11 +61,11 @@ namespace cobalt {
             world.addSystem<ecs::Query<AngularVelocity&, const AngularAcceleration&>, ecs::ReadRequest<Time>>(
                 ecs::DefaultSchedules::Update, [](auto query, auto time) {
                     const float deltaTime = time->getDeltaTime();
-                    for (auto [angularVelocity, angularAcceleration] : query) {
+                    query.parForEach([deltaTime](AngularVelocity& angularVelocity, const AngularAcceleration& angularAcceleration) {
                         angularVelocity.x += angularAcceleration.x * deltaTime;
                         angularVelocity.y += angularAcceleration.y * deltaTime;
                         angularVelocity.z += angularAcceleration.z * deltaTime;
-                    }
+                    });
                 });
         }
     }  // namespace engine
@@ -34,8 +34,8 @@ namespace cobalt {
             sceneNode->addOutput(scene.getCameraID(), RenderTarget(sceneFBO, "scene"));
             filterNode->addSource(RenderTarget(sceneFBO, "scene"));
 
-            addNode(Move(sceneNode));
-            addNode(Move(filterNode));
+            addNode(Move(sceneNode), "Scene");
+            addNode(Move(filterNode), "Filter");
         }
 
         void DefaultGraph::onResize(const uint width, const uint height) {
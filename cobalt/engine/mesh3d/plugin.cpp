@@ -7,6 +7,7 @@
 
 #include "engine/mesh3d/plugin.h"
 
+#include "core/memory/stack.h"
 #include "engine/material/plugin.h"
 
 namespace cobalt {
@@ -43,8 +44,10 @@ namespace cobalt {
             const float stackStep = M_PI / stacks;
             const float sliceStep = 2.0f * M_PI / slices;
 
-            float vertices[8 * (stacks + 1) * (slices + 1)];
-            uint indices[6 * stacks * slices];
+            memory::StackAllocator& scratch = memory::StackAllocator::getScratch();
+            memory::StackAllocator::ScopeGuard guard(scratch);
+            float* vertices = scratch.grabArray<float>(8 * (stacks + 1) * (slices + 1));
+            uint* indices = scratch.grabArray<uint>(6 * stacks * slices);
 
             for (uint i = 0; i <= stacks; i++) {
                 const float stackAngle = M_PI / 2.0f - i * stackStep;
@@ -4,12 +4,14 @@
 #include "engine/render/graph.h"
 
 #include "core/gl/context.h"
+#include "core/utils/profiler.h"
 
 namespace cobalt {
     using namespace core;
 
     namespace engine {
-        const uint RenderGraph::addNode(Scope<RenderNode> node) {
+        const uint RenderGraph::addNode(Scope<RenderNode> node, const std::string& name) {
+            names.push_back(name.empty() ? "Render node #" + std::to_string(nodes.size()) : name);
             nodes.push_back(Move(node));
             return nodes.size() - 1;
         }
@@ -22,6 +24,7 @@ namespace cobalt {
             }
 
             for (uint i = 0; i < nodes.size(); i++) {
+                CB_PROFILE_SCOPE(names[i], "Render graph");
                 nodes[i]->render(world);
             }
         }
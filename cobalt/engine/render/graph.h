@@ -18,9 +18,10 @@ namespace cobalt {
             /**
              * @brief Adds a node to the render graph.
              * @param node The node to add.
+             * @param name The name to profile the node under, or empty to name it after its index.
              * @return The index of the node in the graph.
              */
-            const uint addNode(Scope<RenderNode> node);
+            const uint addNode(Scope<RenderNode> node, const std::string& name = "");
 
             /**
              * @brief Called upon window resize.
@@ -37,6 +38,7 @@ namespace cobalt {
 
             protected:
             Vec<Scope<RenderNode>> nodes;  // All the nodes in the graph, in topological order.
+            Vec<std::string> names;        // The name of each node, for profiling.
 
             /**
              * @brief Creates an empty render graph. The graph is empty, so it is not possible to render anything.
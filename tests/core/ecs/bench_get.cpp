@@ -0,0 +1,118 @@
+// Created by tomas on
+// 07-09-2024.
+
+#include <chrono>
+
+#include "core/ecs/world.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::ecs;
+using namespace cobalt;
+
+struct Position : public Component {
+    Position(float x, float y, float z) : x(x), y(y), z(z) {}
+    float x;
+    float y;
+    float z;
+};
+
+struct Velocity : public Component {
+    Velocity(float x, float y, float z) : x(x), y(y), z(z) {}
+    float x;
+    float y;
+    float z;
+};
+
+class Gravity : public Resource {
+    public:
+    Gravity() noexcept : value(9.81f) {}
+    float value;
+};
+
+static constexpr uint64 ENTITIES = 10000;
+static constexpr uint64 ROUNDS = 200;
+static constexpr uint64 LOOKUPS = 10000000;
+
+/**
+ * @brief Runs a function a number of times, returning the average time per run in nanoseconds.
+ */
+template <typename Func>
+static double measure(const uint64 runs, Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64 i = 0; i < runs; i++) {
+        func(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares ComponentRegistry::get against the lookup it replaced: a hash map keyed by typeid().hash_code() and a dynamic_cast to
+ * the typed column.
+ */
+void bench_component_get() {
+    ComponentRegistry componentRegistry;
+    EntityRegistry entityRegistry(componentRegistry);
+    componentRegistry.registerComponent<Position>();
+    componentRegistry.registerComponent<Velocity>();
+    Vec<EntityProperties::ID> entities;
+    for (uint64 i = 0; i < ENTITIES; i++) {
+        const EntityProperties::ID entity = entityRegistry.add().getID();
+        componentRegistry.add<Position>(entity, float(i), 0.0f, 0.0f);
+        componentRegistry.add<Velocity>(entity, 1.0f, 0.0f, 0.0f);
+        entities.push_back(entity);
+    }
+
+    UMap<uint64, uint64> legacyIndices = {{typeid(Position).hash_code(), componentRegistry.getIndex<Position>()},
+                                          {typeid(Velocity).hash_code(), componentRegistry.getIndex<Velocity>()}};
+    Archetype& archetype = *componentRegistry.getArchetypes().back();
+    volatile float sink = 0.0f;
+
+    float sum = 0.0f;
+    const double current = measure(ENTITIES * ROUNDS, [&](const uint64 i) {
+        sum += componentRegistry.get<const Position&>(entities[i % ENTITIES]).x;
+    });
+    sink = sum;
+    float legacySum = 0.0f;
+    const double legacy = measure(ENTITIES * ROUNDS, [&](const uint64 i) {
+        const uint64 index = legacyIndices.at(typeid(Position).hash_code());
+        const ComponentStorageInterface& column = archetype.getColumn(index);
+        legacySum += dynamic_cast<const ComponentStorage<Position>&>(column).at(i % ENTITIES).x;
+    });
+    sink = legacySum;
+    printf("component get: %.2f ns (hash + dynamic_cast: %.2f ns)\n", current, legacy);
+    TEST_ASSERT_EQUAL_FLOAT(sum, legacySum);
+}
+
+/**
+ * @brief Compares ResourceRegistry::get against the lookup it replaced: a hash map keyed by typeid().hash_code() and a dynamic_cast to
+ * the resource type.
+ */
+void bench_resource_get() {
+    ResourceRegistry resourceRegistry;
+    resourceRegistry.add<Gravity>();
+    UMap<uint64, Scope<Resource>> legacyResources;
+    legacyResources.emplace(typeid(Gravity).hash_code(), CreateScope<Gravity>());
+    volatile float sink = 0.0f;
+
+    float sum = 0.0f;
+    const double current = measure(LOOKUPS, [&](const uint64 i) { sum += resourceRegistry.get<const Gravity&>().value; });
+    sink = sum;
+    float legacySum = 0.0f;
+    const double legacy = measure(LOOKUPS, [&](const uint64 i) {
+        legacySum += dynamic_cast<const Gravity*>(legacyResources.at(typeid(Gravity).hash_code()).get())->value;
+    });
+    sink = legacySum;
+    printf("resource get: %.2f ns (hash + dynamic_cast: %.2f ns)\n", current, legacy);
+    TEST_ASSERT_EQUAL_FLOAT(sum, legacySum);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_component_get);
+    RUN_TEST(bench_resource_get);
+    return UNITY_END();
+}
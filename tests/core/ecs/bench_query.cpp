@@ -0,0 +1,118 @@
+// Created by tomas on
+// 04-09-2024.
+
+#include <chrono>
+
+#include "core/ecs/world.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::ecs;
+using namespace cobalt;
+
+struct Position : public Component {
+    Position(float x, float y, float z) : x(x), y(y), z(z) {}
+    float x;
+    float y;
+    float z;
+};
+
+struct Velocity : public Component {
+    Velocity(float x, float y, float z) : x(x), y(y), z(z) {}
+    float x;
+    float y;
+    float z;
+};
+
+template <uint64 N>
+struct Tag : public Component {
+    uint64 value = N;
+};
+
+static constexpr uint64 ENTITIES = 1000000;
+static constexpr uint64 FRAMES = 20;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Integrates 1M entities with a varying number of threads, printing the time per frame and the speedup over a single thread.
+ * Scaling should stay close to linear up to the number of cores.
+ */
+void bench_par_for_each() {
+    Vec<uint> threadCounts = {0};
+    for (uint threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    if (threadCounts.back() + 1 < std::thread::hardware_concurrency()) {
+        threadCounts.push_back(std::thread::hardware_concurrency() - 1);
+    }
+    double baseline = 0.0;
+    for (const uint threads : threadCounts) {
+        World world(threads);
+        world.registerComponent<Position>();
+        world.registerComponent<Velocity>();
+        for (uint64 i = 0; i < ENTITIES; i++) {
+            Entity& entity = world.spawn();
+            entity.add<Position>(0.0f, 0.0f, 0.0f);
+            entity.add<Velocity>(1.0f, 2.0f, 3.0f);
+        }
+        auto query = world.makeQuery<Position&, const Velocity&>();
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64 frame = 0; frame < FRAMES; frame++) {
+            query.parForEach(
+                [](Position& position, const Velocity& velocity) {
+                    position.x += velocity.x * 0.016f;
+                    position.y += velocity.y * 0.016f;
+                    position.z += velocity.z * 0.016f;
+                },
+                4096);
+        }
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+        if (threads == 0) {
+            baseline = elapsed;
+        }
+        printf("par_for_each: %u thread(s), %.3f ms/frame, %.2fx\n", threads + 1, elapsed, baseline / elapsed);
+        for (auto [position, velocity] : world.makeQuery<const Position&, const Velocity&>()) {
+            TEST_ASSERT_FLOAT_WITHIN(0.01f, FRAMES * 0.016f, position.x);
+        }
+    }
+}
+
+/**
+ * @brief Iterates a query over 512 tables holding 4 entities each, so the time goes into matching table signatures rather than into the
+ * entities. Uses fewer than 64 component types, the common case.
+ */
+void bench_signature_matching() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    [&]<uint64... Ns>(std::index_sequence<Ns...>) { (world.registerComponent<Tag<Ns>>(), ...); }(std::make_index_sequence<9>{});
+    for (uint64 table = 0; table < 512; table++) {
+        for (uint64 i = 0; i < 4; i++) {
+            Entity& entity = world.spawn();
+            entity.add<Position>(0.0f, 0.0f, 0.0f);
+            [&]<uint64... Ns>(std::index_sequence<Ns...>) {
+                ((table & (uint64(1) << Ns) ? entity.add<Tag<Ns>>() : void()), ...);
+            }(std::make_index_sequence<9>{});
+        }
+    }
+    auto query = world.makeQuery<const Position&, const Tag<0>&>();
+    uint64 count = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64 frame = 0; frame < FRAMES * 500; frame++) {
+        for (auto [position, tag] : query) {
+            count += tag.value + 1;
+        }
+    }
+    const double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (FRAMES * 500);
+    printf("signature matching: %.3f us/iteration over 512 tables\n", elapsed);
+    TEST_ASSERT_EQUAL(FRAMES * 500 * 256 * 4, count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_par_for_each);
+    RUN_TEST(bench_signature_matching);
+    return UNITY_END();
+}
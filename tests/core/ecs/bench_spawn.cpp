@@ -0,0 +1,75 @@
+// Created by tomas on
+// 09-09-2024.
+
+#include <chrono>
+
+#include "core/ecs/world.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::ecs;
+using namespace cobalt;
+
+struct Position : public Component {
+    Position(float x, float y, float z) : x(x), y(y), z(z) {}
+    float x;
+    float y;
+    float z;
+};
+
+struct Velocity : public Component {
+    Velocity(float x, float y, float z) : x(x), y(y), z(z) {}
+    float x;
+    float y;
+    float z;
+};
+
+struct Mass : public Component {
+    Mass(float mass) : mass(mass) {}
+    float mass;
+};
+
+static constexpr uint64 ENTITIES = 100000;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Spawns 100k entities with three components, one at a time and then as a batch, printing the time each takes.
+ */
+void bench_spawn_batch() {
+    double single = 0.0;
+    {
+        World world;
+        world.registerComponent<Position>();
+        world.registerComponent<Velocity>();
+        world.registerComponent<Mass>();
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64 i = 0; i < ENTITIES; i++) {
+            Entity& entity = world.spawn();
+            entity.add<Position>(0.0f, 0.0f, 0.0f);
+            entity.add<Velocity>(1.0f, 0.0f, 0.0f);
+            entity.add<Mass>(1.0f);
+        }
+        single = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerComponent<Mass>();
+    const auto start = std::chrono::steady_clock::now();
+    world.spawnBatch(ENTITIES, Position(0.0f, 0.0f, 0.0f), Velocity(1.0f, 0.0f, 0.0f), Mass(1.0f));
+    const double batch = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("spawn %lu entities: %.2f ms one at a time, %.2f ms batched (%.1fx)\n", ENTITIES, single, batch, single / batch);
+    uint64 count = 0;
+    for (auto [position, velocity, mass] : world.makeQuery<const Position&, const Velocity&, const Mass&>()) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL(ENTITIES, count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_spawn_batch);
+    return UNITY_END();
+}
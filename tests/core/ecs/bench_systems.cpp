@@ -0,0 +1,112 @@
+// Created by tomas on
+// 17-09-2024.
+
+#include <chrono>
+
+#include "core/ecs/world.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::ecs;
+using namespace cobalt;
+
+class Gravity : public Resource {
+    public:
+    Gravity() noexcept : value(9.81f) {}
+    float value;
+};
+
+static constexpr uint64 SYSTEMS = 500;
+static constexpr uint64 FRAMES = 2000;
+
+static UMap<uint64, Resource*> legacyResources;  ///< The resource table the registry used to be: keyed by typeid().hash_code().
+
+/**
+ * @brief A ReadRequest as it used to be: looked up on every run through a hash map, a dynamic_cast and a try/catch.
+ */
+template <typename ResourceType>
+class LegacyReadRequest : SystemParameter {
+    public:
+    LegacyReadRequest(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                      EventManager& eventManager)
+        : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager), resource(lookup()) {}
+
+    static void declare(SystemAccess& access) noexcept { access.readResource(Resource::getType<ResourceType>()); }
+
+    const ResourceType* operator->() const { return &resource; }
+
+    private:
+    const ResourceType& resource;
+
+    static const ResourceType& lookup() {
+        try {
+            return *dynamic_cast<const ResourceType*>(legacyResources.at(typeid(ResourceType).hash_code()));
+        } catch (const std::out_of_range&) {
+            throw std::runtime_error("Resource not found");
+        }
+    }
+};
+
+/**
+ * @brief A ReadRequest without a cached slot: looked up in the registry's table on every run.
+ */
+template <typename ResourceType>
+class UncachedReadRequest : SystemParameter {
+    public:
+    UncachedReadRequest(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager,
+                        EventManager& eventManager)
+        : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager), resource(resourceRegistry.get<const ResourceType&>()) {}
+
+    static void declare(SystemAccess& access) noexcept { access.readResource(Resource::getType<ResourceType>()); }
+
+    const ResourceType* operator->() const { return &resource; }
+
+    private:
+    const ResourceType& resource;
+};
+
+/**
+ * @brief Runs a world with a number of trivial systems for a number of frames, returning the average time per frame in nanoseconds.
+ */
+template <typename Request>
+static double measure(const uint64 systems, float& sum) {
+    World world(0);
+    world.addResource<Gravity>();
+    legacyResources[typeid(Gravity).hash_code()] = &world.getResource<Gravity>();
+    for (uint64 i = 0; i < systems; i++) {
+        world.addSystem<Request>(DefaultSchedules::Update, [&sum](Request gravity) { sum += gravity->value; });
+    }
+    world.startup();
+    world.update();
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64 i = 0; i < FRAMES; i++) {
+        world.update();
+    }
+    const double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+    legacyResources.clear();
+    return time;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Measures the dispatch overhead of a trivial system reading one resource, with the resource cached in the system, looked up in
+ * the registry every run and looked up the way the registry used to. The cost of a frame with no systems is taken out.
+ */
+void bench_system_dispatch() {
+    float sum = 0.0f;
+    const double empty = measure<ReadRequest<Gravity>>(0, sum);
+    const double cached = (measure<ReadRequest<Gravity>>(SYSTEMS, sum) - empty) / SYSTEMS;
+    const double uncached = (measure<UncachedReadRequest<Gravity>>(SYSTEMS, sum) - empty) / SYSTEMS;
+    const double legacy = (measure<LegacyReadRequest<Gravity>>(SYSTEMS, sum) - empty) / SYSTEMS;
+    printf("%lu systems, per system: cached slot %.2f ns, registry lookup %.2f ns, hash + dynamic_cast %.2f ns\n", SYSTEMS, cached,
+           uncached, legacy);
+    TEST_ASSERT_TRUE(sum > 0.0f);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_system_dispatch);
+    return UNITY_END();
+}
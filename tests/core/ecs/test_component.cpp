@@ -3,6 +3,7 @@
 
 #include "core/ecs/component/registry.h"
 #include "core/ecs/entity/registry.h"
+#include "core/ecs/world.h"
 #include "unity/unity.h"
 
 using namespace cobalt;
@@ -32,6 +33,25 @@ struct Mass : public Component {
     int mass;
 };
 
+template <uint64 N>
+struct Tag : public Component {
+    uint64 value = N;
+};
+
+void test_component_types() {
+    const ComponentProperties::Type position = Component::getType<Position>();
+    const ComponentProperties::Type velocity = Component::getType<Velocity>();
+    const ComponentProperties::Type mass = Component::getType<Mass>();
+    TEST_ASSERT_NOT_EQUAL(position, velocity);
+    TEST_ASSERT_NOT_EQUAL(position, mass);
+    TEST_ASSERT_NOT_EQUAL(velocity, mass);
+    TEST_ASSERT_EQUAL(position, Component::getType<Position>());
+    // Types are dense, so they can index flat tables.
+    TEST_ASSERT_TRUE(position < 3 && velocity < 3 && mass < 3);
+    const Component& component = Velocity(1, 2);
+    TEST_ASSERT_EQUAL(velocity, component.getType());
+}
+
 void test_component_registry_register() {
     ComponentRegistry componentRegistry;
     componentRegistry.registerComponent<Position>();
@@ -141,12 +161,143 @@ void test_component_variadics() {
     TEST_ASSERT_TRUE_MESSAGE(check, "Entity should have Velocity component");
 }
 
+void test_component_archetype_moves() {
+    ComponentRegistry componentRegistry;
+    componentRegistry.registerComponent<Position>();
+    componentRegistry.registerComponent<Velocity>();
+    componentRegistry.registerComponent<Mass>();
+    EntityRegistry entityRegistry(componentRegistry);
+    auto& e1 = entityRegistry.add();
+    auto& e2 = entityRegistry.add();
+    auto& e3 = entityRegistry.add();
+    e1.add<Position>(1, 1);
+    e2.add<Position>(2, 2);
+    e3.add<Position>(3, 3);
+    e1.add<Velocity>(10, 10);
+    e2.add<Velocity>(20, 20);
+    e3.add<Velocity>(30, 30);
+    e1.remove<Velocity>();
+    TEST_ASSERT_EQUAL_INT(1, e1.get<const Position&>().x);
+    TEST_ASSERT_EQUAL_INT(2, e2.get<const Position&>().x);
+    TEST_ASSERT_EQUAL_INT(20, e2.get<const Velocity&>().x);
+    TEST_ASSERT_EQUAL_INT(3, e3.get<const Position&>().x);
+    TEST_ASSERT_EQUAL_INT(30, e3.get<const Velocity&>().x);
+    e2.add<Mass>(5);
+    e2.kill();
+    TEST_ASSERT_EQUAL_INT(3, e3.get<const Position&>().x);
+    TEST_ASSERT_EQUAL_INT(30, e3.get<const Velocity&>().x);
+    TEST_ASSERT_FALSE_MESSAGE(e2.has<Position>(), "Entity should not have Position component");
+    e1.add<Velocity>(40, 40);
+    bool check = e1.has<Position, Velocity>();
+    TEST_ASSERT_TRUE_MESSAGE(check, "Entity should have Position and Velocity components");
+    TEST_ASSERT_EQUAL_INT(40, e1.get<const Velocity&>().x);
+    TEST_ASSERT_EQUAL_INT(30, e3.get<const Velocity&>().x);
+}
+
+void test_component_registry_add_batch() {
+    ComponentRegistry componentRegistry;
+    componentRegistry.registerComponent<Position>();
+    componentRegistry.registerComponent<Velocity>();
+    componentRegistry.registerComponent<Mass>();
+    EntityRegistry entityRegistry(componentRegistry);
+    entityRegistry.add().add<Mass>(7);
+    const Vec<EntityProperties::ID> entityIDs = entityRegistry.addBatch(100);
+    TEST_ASSERT_EQUAL(100, entityIDs.size());
+    Vec<Position> positions;
+    for (int i = 0; i < 100; i++) {
+        positions.emplace_back(i, -i);
+    }
+    componentRegistry.addBatch<Position>(entityIDs, positions);
+    componentRegistry.fillBatch<Velocity, Mass>(std::span(entityIDs).subspan(0, 50), Velocity(1, 2), Mass(3));
+    for (int i = 0; i < 100; i++) {
+        const Entity& entity = entityRegistry.get(entityIDs[i]);
+        TEST_ASSERT_EQUAL_INT(i, componentRegistry.get<const Position&>(entity.getID()).x);
+        TEST_ASSERT_EQUAL_INT(-i, componentRegistry.get<const Position&>(entity.getID()).y);
+        TEST_ASSERT_EQUAL(i < 50, (componentRegistry.has<Velocity, Mass>(entity.getID())));
+    }
+    // Components the entities already have are left alone.
+    componentRegistry.fillBatch<Position, Mass>(entityIDs, Position(-1, -1), Mass(9));
+    TEST_ASSERT_EQUAL_INT(10, componentRegistry.get<const Position&>(entityIDs[10]).x);
+    TEST_ASSERT_EQUAL_INT(3, componentRegistry.get<const Mass&>(entityIDs[10]).mass);
+    TEST_ASSERT_EQUAL_INT(9, componentRegistry.get<const Mass&>(entityIDs[90]).mass);
+}
+
+void test_component_many_types() {
+    World world;
+    // Well past the 64 types that fit in a single word.
+    []<uint64... Ns>(World& world, std::index_sequence<Ns...>) { (world.registerComponent<Tag<Ns>>(), ...); }(world, std::make_index_sequence<200>{});
+    for (uint64 i = 0; i < 10; i++) {
+        Entity& entity = world.spawn();
+        entity.add<Tag<3>>();
+        entity.add<Tag<70>>();
+        if (i % 2 == 0) {
+            entity.add<Tag<199>>();
+        }
+    }
+    uint64 count = 0;
+    for (auto [low, high] : world.makeQuery<const Tag<3>&, const Tag<199>&>()) {
+        TEST_ASSERT_EQUAL(3, low.value);
+        TEST_ASSERT_EQUAL(199, high.value);
+        count++;
+    }
+    TEST_ASSERT_EQUAL(5, count);
+    Vec<EntityProperties::Handle> handles;
+    for (auto [entity, tag] : world.makeQuery<const Entity&, const Tag<70>&>()) {
+        handles.push_back(entity.getHandle());
+    }
+    TEST_ASSERT_EQUAL(10, handles.size());
+    for (const EntityProperties::Handle handle : handles) {
+        world.getEntity(handle)->get().remove<Tag<199>>();
+    }
+    count = 0;
+    for (auto [tag] : world.makeQuery<const Tag<199>&>()) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL(0, count);
+}
+
+void test_component_memory() {
+    core::memory::CountingResource components(std::pmr::new_delete_resource());
+    core::memory::CountingResource tables(std::pmr::new_delete_resource());
+    ComponentRegistry componentRegistry(MemoryConfig{&components, &tables});
+    componentRegistry.registerComponent<Position>();
+    componentRegistry.registerComponent<Mass>();
+    EntityRegistry entityRegistry(componentRegistry);
+    for (int i = 0; i < 1000; i++) {
+        Entity& entity = entityRegistry.add();
+        entity.add<Position>(i, i);
+        if (i % 2 == 0) {
+            entity.add<Mass>(i);
+        }
+    }
+    const core::memory::MemoryUsage& positions = componentRegistry.getMemoryUsage<Position>();
+    const core::memory::MemoryUsage& masses = componentRegistry.getMemoryUsage<Mass>();
+    // Each component keeps two ticks next to it.
+    TEST_ASSERT_TRUE(positions.bytes >= 1000 * (sizeof(Position) + 2 * sizeof(uint64)));
+    TEST_ASSERT_TRUE(masses.bytes >= 500 * (sizeof(Mass) + 2 * sizeof(uint64)));
+    TEST_ASSERT_TRUE(masses.bytes < positions.bytes);
+    TEST_ASSERT_EQUAL(positions.bytes + masses.bytes, components.getUsage().bytes);
+    TEST_ASSERT_EQUAL(positions.allocations + masses.allocations, components.getUsage().allocations);
+    TEST_ASSERT_TRUE(tables.getUsage().bytes >= 1000 * sizeof(EntityProperties::ID));
+    TEST_ASSERT_EQUAL(tables.getUsage().bytes, componentRegistry.getTableMemoryUsage().bytes);
+    try {
+        componentRegistry.getMemoryUsage<Velocity>();
+        TEST_FAIL();
+    } catch (const std::out_of_range& e) {
+    }
+}
+
 int main(void) {
     UNITY_BEGIN();
+    RUN_TEST(test_component_types);
     RUN_TEST(test_component_registry_register);
     RUN_TEST(test_component_registry_add);
     RUN_TEST(test_component_registry_remove);
     RUN_TEST(test_component_registry_get);
     RUN_TEST(test_component_variadics);
+    RUN_TEST(test_component_archetype_moves);
+    RUN_TEST(test_component_registry_add_batch);
+    RUN_TEST(test_component_many_types);
+    RUN_TEST(test_component_memory);
     return UNITY_END();
 }
\ No newline at end of file
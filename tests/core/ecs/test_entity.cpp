@@ -53,9 +53,66 @@ void test_entity_registry_remove() {
     entityRegistry.remove(entity);
 }
 
+void test_entity_registry_handles() {
+    ComponentRegistry componentRegistry;
+    EntityRegistry entityRegistry(componentRegistry);
+
+    auto& entity = entityRegistry.add();
+    auto& entity2 = entityRegistry.add();
+    const EntityProperties::Handle handle = entity.getHandle();
+    TEST_ASSERT_EQUAL_INT(0, EntityProperties::getID(handle));
+    TEST_ASSERT_EQUAL_INT(1, EntityProperties::getVersion(handle));
+    TEST_ASSERT_TRUE_MESSAGE(entityRegistry.isAlive(handle), "Handle is not alive.");
+    TEST_ASSERT_TRUE_MESSAGE(entityRegistry.get(handle).has_value(), "Handle does not resolve.");
+
+    entityRegistry.remove(entity);
+    TEST_ASSERT_FALSE_MESSAGE(entityRegistry.isAlive(handle), "Handle is alive.");
+    TEST_ASSERT_FALSE_MESSAGE(entityRegistry.get(handle).has_value(), "Handle resolves.");
+
+    entityRegistry.remove(entity2);
+    auto& entity3 = entityRegistry.add();
+    TEST_ASSERT_EQUAL_INT(1, entity3.getID());
+    TEST_ASSERT_EQUAL_INT(2, entity3.getVersion());
+    auto& entity4 = entityRegistry.add();
+    TEST_ASSERT_EQUAL_INT(0, entity4.getID());
+    TEST_ASSERT_EQUAL_INT(2, entity4.getVersion());
+    TEST_ASSERT_FALSE_MESSAGE(entityRegistry.isAlive(handle), "Stale handle is alive.");
+    TEST_ASSERT_TRUE_MESSAGE(entityRegistry.isAlive(entity4.getHandle()), "Handle is not alive.");
+    TEST_ASSERT_EQUAL_INT(2, entityRegistry.getSize());
+}
+
+void test_entity_registry_reserve() {
+    ComponentRegistry componentRegistry;
+    EntityRegistry entityRegistry(componentRegistry);
+
+    auto& entity = entityRegistry.add();
+    entityRegistry.remove(entity);
+    const EntityProperties::Handle reused = entityRegistry.reserve();
+    TEST_ASSERT_EQUAL_INT(0, EntityProperties::getID(reused));
+    TEST_ASSERT_EQUAL_INT(2, EntityProperties::getVersion(reused));
+    const EntityProperties::Handle appended = entityRegistry.reserve();
+    TEST_ASSERT_EQUAL_INT(1, EntityProperties::getID(appended));
+    TEST_ASSERT_EQUAL_INT(1, EntityProperties::getVersion(appended));
+    TEST_ASSERT_FALSE_MESSAGE(entityRegistry.isAlive(reused), "Reserved handle is alive.");
+    TEST_ASSERT_FALSE_MESSAGE(entityRegistry.isAlive(appended), "Reserved handle is alive.");
+
+    // Entities added before the reserved ones are spawned never take their slots.
+    auto& entity2 = entityRegistry.add();
+    TEST_ASSERT_EQUAL_INT(2, entity2.getID());
+    TEST_ASSERT_FALSE_MESSAGE(entityRegistry.isAlive(appended), "Reserved handle is alive.");
+
+    TEST_ASSERT_EQUAL(appended, entityRegistry.spawn(appended).getHandle());
+    TEST_ASSERT_EQUAL(reused, entityRegistry.spawn(reused).getHandle());
+    TEST_ASSERT_TRUE_MESSAGE(entityRegistry.isAlive(reused), "Spawned handle is not alive.");
+    TEST_ASSERT_TRUE_MESSAGE(entityRegistry.isAlive(appended), "Spawned handle is not alive.");
+    TEST_ASSERT_EQUAL_INT(3, entityRegistry.getSize());
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_entity_registry_add);
     RUN_TEST(test_entity_registry_remove);
+    RUN_TEST(test_entity_registry_handles);
+    RUN_TEST(test_entity_registry_reserve);
     return UNITY_END();
 }
\ No newline at end of file
@@ -7,6 +7,20 @@
 using namespace cobalt::core::ecs;
 using namespace cobalt;
 
+static std::atomic<uint64> allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t size) noexcept { std::free(ptr); }
+
 struct Position : public Component {
     Position(int x, int y) : x(x), y(y) {}
     Position() : x(0), y(0) {}
@@ -108,9 +122,104 @@ void test_entity_query() {
     }
 }
 
+void test_empty_query() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+
+    Entity& e1 = world.spawn();
+    e1.add<Position>(1, 2);
+
+    uint count = 0;
+    for (auto [position, velocity] : world.makeQuery<const Position&, const Velocity&>()) {
+        count++;
+    }
+    for (auto [mass] : world.makeQuery<const Mass&>()) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL_INT(0, count);
+}
+
+void test_query_allocations() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerComponent<Mass>();
+    world.addSystem<Query<Position&, const Velocity&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [position, velocity] : query) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        }
+    });
+    world.addSystem<Query<const Entity&, Velocity&, const Mass&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [entity, velocity, mass] : query) {
+            velocity.x += mass.mass;
+        }
+    });
+    for (int i = 0; i < 1000; i++) {
+        Entity& entity = world.spawn();
+        entity.add<Position>(i, i);
+        entity.add<Velocity>(1, 1);
+        if (i % 2 == 0) {
+            entity.add<Mass>(1);
+        }
+    }
+    world.update();
+
+    allocations = 0;
+    for (int i = 0; i < 100; i++) {
+        world.update();
+    }
+    TEST_ASSERT_EQUAL_INT(0, allocations);
+}
+
+void test_par_for_each() {
+    World world(3);
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerComponent<Mass>();
+    for (int i = 0; i < 10000; i++) {
+        Entity& entity = world.spawn();
+        entity.add<Position>(i, 0);
+        entity.add<Velocity>(1, 2);
+        if (i % 3 == 0) {
+            entity.add<Mass>(i);
+        }
+    }
+    world.makeQuery<Position&, const Velocity&>().parForEach(
+        [](Position& position, const Velocity& velocity) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        },
+        100);
+    // Unity can't fail a test from a worker thread, so mismatches are counted and checked afterwards.
+    std::atomic<uint64> count = 0;
+    std::atomic<uint64> mismatches = 0;
+    world.makeQuery<const Entity&, const Position&, Mass&>().parForEach([&](const Entity& entity, const Position& position, Mass& mass) {
+        if (position.x - 1 != mass.mass) {
+            mismatches++;
+        }
+        mass.mass = entity.getID();
+        count++;
+    });
+    TEST_ASSERT_EQUAL_INT(3334, count.load());
+    TEST_ASSERT_EQUAL_INT(0, mismatches.load());
+    for (auto [entity, position, velocity] : world.makeQuery<const Entity&, const Position&, const Velocity&>()) {
+        TEST_ASSERT_EQUAL_INT(entity.getID() + 1, position.x);
+        TEST_ASSERT_EQUAL_INT(2, position.y);
+    }
+    for (auto [entity, mass] : world.makeQuery<const Entity&, const Mass&>()) {
+        TEST_ASSERT_EQUAL_INT(entity.getID(), mass.mass);
+    }
+    world.makeQuery<const Mass&, const Velocity&>().parForEach([](const Mass& mass, const Velocity& velocity) {});
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_query);
     RUN_TEST(test_entity_query);
+    RUN_TEST(test_empty_query);
+    RUN_TEST(test_query_allocations);
+    RUN_TEST(test_par_for_each);
     return UNITY_END();
 }
\ No newline at end of file
@@ -51,9 +51,59 @@ void test_write() {
     TEST_ASSERT_EQUAL_FLOAT(42, resource2.valueFloat);
 }
 
+void test_cached_slot() {
+    World world(0);
+    world.addResource<MyResource>(1);
+    int seen = 0;
+    world.addSystem<ReadRequest<MyResource>>(DefaultSchedules::Update, [&seen](ReadRequest<MyResource> request) { seen = request->valueInt; });
+    world.startup();
+    world.update();
+    TEST_ASSERT_EQUAL(1, seen);
+
+    world.addResource<MyResource>(2);
+    world.update();
+    TEST_ASSERT_EQUAL(2, seen);
+
+    ResourceSlot<MyResource> slot;
+    world.getResource(slot).valueInt = 3;
+    TEST_ASSERT_EQUAL(3, world.getResource(slot).valueInt);
+    world.update();
+    TEST_ASSERT_EQUAL(3, seen);
+}
+
+void test_frame_arena() {
+    World world;
+    const FrameArena& arena = world.getResource<FrameArena>();
+    std::span<uint64> arrays[4];
+    Vec<std::thread> threads;
+    for (uint64 i = 0; i < 4; i++) {
+        threads.emplace_back([&arena, &arrays, i]() {
+            arrays[i] = arena.createArray<uint64>(1000);
+            for (uint64& value : arrays[i]) {
+                value = i;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (uint64 i = 0; i < 4; i++) {
+        for (const uint64 value : arrays[i]) {
+            TEST_ASSERT_EQUAL(i, value);
+        }
+    }
+    std::pmr::vector<int> values(&arena.getMemoryResource());
+    values.push_back(1);
+    TEST_ASSERT_TRUE(arena.getSize() >= 4 * 1000 * sizeof(uint64) + sizeof(int));
+    world.getResource<FrameArena>().reset();
+    TEST_ASSERT_EQUAL(0, arena.getSize());
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_read);
     RUN_TEST(test_write);
+    RUN_TEST(test_cached_slot);
+    RUN_TEST(test_frame_arena);
     return UNITY_END();
 }
\ No newline at end of file
@@ -27,6 +27,26 @@ struct Mass : public Component {
     int mass;
 };
 
+struct Score : public Resource {
+    int value = 0;
+};
+
+struct Level : public Resource {};
+
+struct Hit {
+    Hit(uint64 frame, int damage) : frame(frame), damage(damage) {}
+    uint64 frame;
+    int damage;
+};
+
+/**
+ * @brief A parameter that doesn't declare what it touches, so systems using it are exclusive.
+ */
+struct Anything : public SystemParameter {
+    Anything(EntityRegistry& entityRegistry, ResourceRegistry& resourceRegistry, SystemManager& systemManager, EventManager& eventManager)
+        : SystemParameter(entityRegistry, resourceRegistry, systemManager, eventManager) {}
+};
+
 void setUp(void) {}
 
 void tearDown(void) {}
@@ -78,9 +98,499 @@ void test_system() {
     TEST_ASSERT_EQUAL(6, entity.get<const Position&>().y);
 }
 
+void test_system_access() {
+    TEST_ASSERT_TRUE(SystemAccess::from<Query<Position&>>().conflicts(SystemAccess::from<Query<const Position&>>()));
+    TEST_ASSERT_TRUE(SystemAccess::from<Query<Position&>>().conflicts(SystemAccess::from<Query<Position&, const Mass&>>()));
+    TEST_ASSERT_FALSE(SystemAccess::from<Query<const Position&>>().conflicts(SystemAccess::from<Query<const Position&, Velocity&>>()));
+    TEST_ASSERT_FALSE(SystemAccess::from<Query<Position&>>().conflicts(SystemAccess::from<Query<const Entity&, Velocity&>>()));
+    TEST_ASSERT_TRUE(SystemAccess::from<Anything>().conflicts(SystemAccess()));
+    TEST_ASSERT_FALSE(SystemAccess::from<Commands>().conflicts(SystemAccess::from<Query<Position&>>()));
+    TEST_ASSERT_FALSE(SystemAccess().conflicts(SystemAccess()));
+}
+
+void test_parallel_systems() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerComponent<Mass>();
+    world.addSystem<Query<Position&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [position] : query) {
+            position.x += 1;
+        }
+    });
+    world.addSystem<Query<Velocity&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [velocity] : query) {
+            velocity.x += 1;
+        }
+    });
+    world.addSystem<Query<Position&, const Velocity&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [position, velocity] : query) {
+            position.x *= velocity.x;
+        }
+    });
+    world.addSystem<Query<Mass&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [mass] : query) {
+            mass.mass += 1;
+        }
+    });
+    world.addSystem<Query<const Position&, Mass&>>(DefaultSchedules::Update, [](auto query) {
+        for (auto [position, mass] : query) {
+            mass.mass += position.x;
+        }
+    });
+    const std::thread::id mainThread = std::this_thread::get_id();
+    uint64 exclusiveRuns = 0;
+    world.addSystem<Anything>(DefaultSchedules::Update, [&](auto anything) {
+        TEST_ASSERT_TRUE(std::this_thread::get_id() == mainThread);
+        exclusiveRuns++;
+    });
+    Vec<EntityProperties::Handle> handles;
+    for (int i = 0; i < 1000; i++) {
+        Entity& entity = world.spawn();
+        entity.add<Position>(i, 0);
+        entity.add<Velocity>(2, 0);
+        entity.add<Mass>(3);
+        handles.push_back(entity.getHandle());
+    }
+    for (int frame = 0; frame < 10; frame++) {
+        Vec<int> expected(handles.size());
+        for (uint64 i = 0; i < handles.size(); i++) {
+            const Entity& entity = world.getEntity(handles[i])->get();
+            const int x = (entity.get<const Position&>().x + 1) * (entity.get<const Velocity&>().x + 1);
+            expected[i] = entity.get<const Mass&>().mass + 1 + x;
+        }
+        world.update();
+        for (uint64 i = 0; i < handles.size(); i++) {
+            TEST_ASSERT_EQUAL(expected[i], world.getEntity(handles[i])->get().get<const Mass&>().mass);
+        }
+    }
+    TEST_ASSERT_EQUAL(10, exclusiveRuns);
+}
+
+void test_commands() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerComponent<Mass>();
+    Vec<EntityProperties::Handle> spawnedHandles;
+    world.addSystem<Query<const Entity&, const Position&>, Commands>(DefaultSchedules::PreUpdate, [&](auto query, auto commands) {
+        // Structural changes while iterating are deferred, so the query never sees them.
+        uint64 count = 0;
+        for (auto [entity, position] : query) {
+            if (position.x % 2 == 0) {
+                commands.kill(entity.getHandle());
+            } else {
+                commands.entity(entity.getHandle()).template add<Velocity>(position.x, 0).template add<Mass>(position.x);
+                commands.template remove<Position>(entity.getHandle());
+            }
+            // The spawned entity's handle is reserved right away, so later commands can target it.
+            const EntityProperties::Handle handle = commands.spawn().template add<Position>(position.x + 100, 0).getHandle();
+            TEST_ASSERT_FALSE(commands.isAlive(handle));
+            commands.entity(handle).template add<Mass>(1);
+            spawnedHandles.push_back(handle);
+            count++;
+        }
+        TEST_ASSERT_EQUAL(10, count);
+    });
+    Vec<EntityProperties::Handle> handles;
+    for (int i = 0; i < 10; i++) {
+        Entity& entity = world.spawn();
+        entity.add<Position>(i, 0);
+        handles.push_back(entity.getHandle());
+    }
+    world.update();
+    for (int i = 0; i < 10; i++) {
+        Opt<Wrap<Entity>> entity = world.getEntity(handles[i]);
+        if (i % 2 == 0) {
+            TEST_ASSERT_FALSE(entity);
+        } else {
+            TEST_ASSERT_TRUE(entity);
+            TEST_ASSERT_FALSE(entity->get().has<Position>());
+            TEST_ASSERT_EQUAL(i, entity->get().get<const Velocity&>().x);
+            TEST_ASSERT_EQUAL(i, entity->get().get<const Mass&>().mass);
+        }
+    }
+    uint64 spawned = 0;
+    for (auto [position, mass] : world.makeQuery<const Position&, const Mass&>()) {
+        TEST_ASSERT_TRUE(position.x >= 100);
+        TEST_ASSERT_EQUAL(1, mass.mass);
+        spawned++;
+    }
+    TEST_ASSERT_EQUAL(10, spawned);
+    TEST_ASSERT_EQUAL(10, spawnedHandles.size());
+    for (uint64 i = 0; i < spawnedHandles.size(); i++) {
+        Opt<Wrap<Entity>> entity = world.getEntity(spawnedHandles[i]);
+        TEST_ASSERT_TRUE(entity);
+        TEST_ASSERT_EQUAL(i + 100, entity->get().get<const Position&>().x);
+        TEST_ASSERT_EQUAL(1, entity->get().get<const Mass&>().mass);
+    }
+    // The next frame's spawns reserve the slots freed by the kills.
+    spawnedHandles.clear();
+    world.update();
+    TEST_ASSERT_EQUAL(10, spawnedHandles.size());
+    for (const EntityProperties::Handle handle : spawnedHandles) {
+        TEST_ASSERT_TRUE(world.getEntity(handle));
+    }
+}
+
+void test_parallel_commands() {
+    World world(3);
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    Vec<Vec<EntityProperties::Handle>> handles(8);
+    for (int i = 0; i < 8; i++) {
+        world.addSystem<Commands>(DefaultSchedules::Update, [&handles, i](auto commands) {
+            for (int j = 0; j < 1000; j++) {
+                handles[i].push_back(commands.spawn().template add<Position>(j, 0).template add<Velocity>(1, 1).getHandle());
+            }
+        });
+    }
+    world.update();
+    // Slots reserved from several threads at once never collide.
+    Vec<bool> taken(8000, false);
+    for (const Vec<EntityProperties::Handle>& systemHandles : handles) {
+        for (const EntityProperties::Handle handle : systemHandles) {
+            TEST_ASSERT_TRUE(world.getEntity(handle));
+            TEST_ASSERT_FALSE(taken[EntityProperties::getID(handle)]);
+            taken[EntityProperties::getID(handle)] = true;
+        }
+    }
+    uint64 count = 0;
+    int64 sum = 0;
+    for (auto [position, velocity] : world.makeQuery<const Position&, const Velocity&>()) {
+        sum += position.x;
+        count++;
+    }
+    TEST_ASSERT_EQUAL(8000, count);
+    TEST_ASSERT_EQUAL(8 * 499500, sum);
+}
+
+void test_commands_order() {
+    World world(4);
+    world.registerComponent<Position>();
+    world.registerComponent<Mass>();
+    const EntityProperties::Handle shared = world.spawn().getHandle();
+    for (int i = 0; i < 8; i++) {
+        world.addSystem<Commands>(DefaultSchedules::Update, [shared, i](auto commands) {
+            for (int j = 0; j < 16; j++) {
+                commands.spawn().template add<Position>(i, j);
+            }
+            // Every system replaces the same component, so whichever is applied last wins.
+            commands.template remove<Mass>(shared);
+            commands.entity(shared).template add<Mass>(i);
+        });
+    }
+    // However the systems are spread over the threads, their commands are applied in the order they were registered.
+    for (int frame = 1; frame <= 100; frame++) {
+        world.update();
+        TEST_ASSERT_EQUAL(7, world.getEntity(shared)->get().get<const Mass&>().mass);
+        int row = 0;
+        for (auto [position] : world.makeQuery<const Position&>()) {
+            TEST_ASSERT_EQUAL((row / 16) % 8, position.x);
+            TEST_ASSERT_EQUAL(row % 16, position.y);
+            row++;
+        }
+        TEST_ASSERT_EQUAL(frame * 128, row);
+    }
+}
+
+void test_change_detection() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    uint64 frame = 0;
+    uint64 added[7] = {};
+    uint64 changed[7] = {};
+    uint64 velocities[7] = {};
+    uint64 removed[7] = {};
+    world.addSystem<Query<const Position&, Added<Velocity>>, Query<const Entity&, Changed<Position>>, Removed<Velocity>>(
+        DefaultSchedules::PreUpdate, [&](auto addedQuery, auto changedQuery, auto removedVelocities) {
+            for (auto [position] : addedQuery) {
+                added[frame]++;
+            }
+            for (auto [entity] : changedQuery) {
+                changed[frame]++;
+            }
+            for (const EntityProperties::ID entity : removedVelocities) {
+                removed[frame]++;
+            }
+        });
+    world.addSystem<Query<const Position&>>(DefaultSchedules::Update, [](auto query) {
+        // Reading a component never marks it as changed.
+        for (auto [position] : query) {
+            TEST_ASSERT_TRUE(position.x >= 0);
+        }
+    });
+    world.addSystem<Query<Velocity&>>(DefaultSchedules::Update, [&](auto query) {
+        if (frame == 4) {
+            for (auto [velocity] : query) {
+                velocity.x++;
+            }
+        }
+    });
+    world.addSystem<Query<Changed<Velocity>>>(DefaultSchedules::PostUpdate, [&](auto query) {
+        for (auto row : query) {
+            velocities[frame]++;
+        }
+    });
+    Vec<EntityProperties::Handle> handles;
+    for (int i = 0; i < 10; i++) {
+        Entity& entity = world.spawn();
+        entity.add<Position>(i, 0);
+        entity.add<Velocity>(1, 0);
+        handles.push_back(entity.getHandle());
+    }
+    for (frame = 1; frame <= 6; frame++) {
+        if (frame == 3) {
+            for (int i = 0; i < 3; i++) {
+                world.getEntity(handles[i])->get().get<Position&>().x += 10;
+            }
+            Entity& entity = world.spawn();
+            entity.add<Position>(0, 0);
+            entity.add<Velocity>(1, 0);
+        } else if (frame == 5) {
+            world.getEntity(handles[3])->get().remove<Velocity>();
+            world.getEntity(handles[4])->get().remove<Velocity>();
+            world.getEntity(handles[5])->get().kill();
+        } else if (frame == 6) {
+            // Writing through getMany is seen as a change too, unlike reading the other component.
+            for (int i = 6; i < 8; i++) {
+                auto [position, velocity] = world.getEntity(handles[i])->get().getMany<Position&, const Velocity&>();
+                position.x += velocity.x;
+            }
+        }
+        world.update();
+    }
+    const uint64 expectedAdded[7] = {0, 10, 0, 1, 0, 0, 0};
+    const uint64 expectedChanged[7] = {0, 10, 0, 4, 0, 0, 2};
+    const uint64 expectedVelocities[7] = {0, 10, 0, 1, 11, 0, 0};
+    const uint64 expectedRemoved[7] = {0, 0, 0, 0, 0, 3, 0};
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expectedAdded, added, 7);
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expectedChanged, changed, 7);
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expectedVelocities, velocities, 7);
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expectedRemoved, removed, 7);
+}
+
+void test_spawn_batch() {
+    World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.spawn().add<Velocity>(5, 5);
+    const Vec<EntityProperties::Handle> handles = world.spawnBatch(1000, Position(1, 2), Velocity(3, 4));
+    TEST_ASSERT_EQUAL(1000, handles.size());
+    for (const EntityProperties::Handle handle : handles) {
+        Opt<Wrap<Entity>> entity = world.getEntity(handle);
+        TEST_ASSERT_TRUE(entity);
+        TEST_ASSERT_EQUAL(1, entity->get().get<const Position&>().x);
+        TEST_ASSERT_EQUAL(4, entity->get().get<const Velocity&>().y);
+    }
+    world.getEntity(handles[0])->get().kill();
+    // Freed slots are reused by the next batch.
+    const Vec<EntityProperties::Handle> more = world.spawnBatch(10, Position(0, 0));
+    TEST_ASSERT_EQUAL(EntityProperties::getID(handles[0]), EntityProperties::getID(more[0]));
+    uint64 count = 0;
+    for (auto [position] : world.makeQuery<const Position&>()) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL(1009, count);
+}
+
+void test_events() {
+    World world;
+    world.registerEvent<Hit>();
+    world.registerEvent<Hit>();
+    uint64 frame = 0;
+    uint64 early[6] = {};
+    uint64 late[6] = {};
+    int damage = 0;
+    world.addSystem<EventReader<Hit>>(DefaultSchedules::PreUpdate, [&](auto reader) {
+        early[frame] += reader.size();
+        for (const Hit& hit : reader) {
+            damage += hit.damage;
+        }
+    });
+    world.addSystem<EventWriter<Hit>>(DefaultSchedules::Update, [&](auto writer) {
+        if (frame != 3) {
+            writer.send(Hit(frame, 1));
+            writer.emplace(frame, 2);
+        }
+    });
+    world.addSystem<EventReader<Hit>>(DefaultSchedules::PostUpdate, [&](auto reader) {
+        for (const Hit& hit : reader) {
+            late[hit.frame]++;
+        }
+    });
+    for (frame = 1; frame <= 5; frame++) {
+        if (frame == 2) {
+            world.sendEvent(Hit(frame, 10));
+        }
+        world.update();
+    }
+    // The early reader sees each frame's events on the next frame, the late reader on the same frame. Neither sees an event twice.
+    const uint64 expectedEarly[6] = {0, 0, 3, 2, 0, 2};
+    const uint64 expectedLate[6] = {0, 2, 3, 0, 2, 2};
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expectedEarly, early, 6);
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expectedLate, late, 6);
+    TEST_ASSERT_EQUAL(3 * 3 + 10, damage);
+}
+
+void test_event_hooks() {
+    World world;
+    world.registerEvent("test", "A test event.");
+    uint64 first = 0;
+    uint64 second = 0;
+    world.addHook<Anything>("test", [&](auto anything) { first++; });
+    world.addHook<Anything>("test", [&](auto anything) { second++; });
+    world.triggerEvent("test");
+    world.triggerEvent("test");
+    world.update();
+    TEST_ASSERT_EQUAL(2, first);
+    TEST_ASSERT_EQUAL(2, second);
+}
+
+void test_commands_add_systems() {
+    World world;
+    world.registerEvent("test", "A test event.");
+    uint64 added = 0;
+    uint64 hooked = 0;
+    bool done = false;
+    // The Commands are gone by the time their deferred additions are applied, so these must not depend on them.
+    world.addSystem<Commands>(DefaultSchedules::Update, [&](auto commands) {
+        if (done) {
+            return;
+        }
+        commands.template addSystem<Anything>(DefaultSchedules::Update, [&](auto anything) { added++; });
+        commands.template addHook<Anything>("test", [&](auto anything) { hooked++; });
+        done = true;
+    });
+    world.update();
+    TEST_ASSERT_EQUAL(0, added);
+    world.triggerEvent("test");
+    world.update();
+    world.update();
+    TEST_ASSERT_EQUAL(2, added);
+    TEST_ASSERT_EQUAL(1, hooked);
+}
+
+void test_event_queue_threads() {
+    World world;
+    const Event& event = world.registerEvent("test", "A test event.");
+    uint64 handled = 0;
+    world.addHook<Anything>("test", [&](auto anything) { handled++; });
+    Vec<std::thread> producers;
+    for (uint64 i = 0; i < 16; i++) {
+        producers.emplace_back([&world, &event]() {
+            for (uint64 j = 0; j < 100; j++) {
+                world.triggerEvent(event);
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    world.update();
+    const EventQueueStats stats = world.getEventQueueStats();
+    TEST_ASSERT_EQUAL(1600, handled + stats.drops);
+    TEST_ASSERT_EQUAL(handled, stats.highWaterMark);
+}
+
+void test_run_conditions() {
+    World world;
+    world.addResource<Score>();
+    world.registerEvent<Hit>();
+    uint64 frame = 0;
+    uint64 changed = 0;
+    uint64 every = 0;
+    uint64 present = 0;
+    uint64 exists = 0;
+    uint64 both = 0;
+    uint64 always = 0;
+    world.addSystem<WriteRequest<Score>>(DefaultSchedules::Update, [&](auto score) {
+        if (frame == 3) {
+            score->value++;
+        }
+    });
+    world.addSystem<ReadRequest<Score>>(DefaultSchedules::PostUpdate, [&](auto score) { changed++; }, "changed",
+                                        RunCondition::resourceChanged<Score>());
+    world.addSystem<ReadRequest<Score>>(DefaultSchedules::PostUpdate, [&](auto score) { every++; }, "", RunCondition::everyTicks(3));
+    world.addSystem<ReadRequest<Score>>(DefaultSchedules::PostUpdate, [&](auto score) { always++; }, "", RunCondition::everyTicks(0));
+    world.addSystem<EventReader<Hit>>(DefaultSchedules::PostUpdate, [&](auto reader) { present += reader.size(); }, "",
+                                      RunCondition::eventPresent<Hit>());
+    // The parameters of a skipped system are never created, so it doesn't matter that the resource is missing.
+    world.addSystem<ReadRequest<Level>>(DefaultSchedules::PostUpdate, [&](auto level) { exists++; }, "", RunCondition::resourceExists<Level>());
+    world.addSystem<ReadRequest<Score>>(DefaultSchedules::PostUpdate, [&](auto score) { both++; }, "",
+                                        RunCondition::resourceChanged<Score>() && RunCondition::everyTicks(2));
+    for (frame = 1; frame <= 7; frame++) {
+        if (frame == 5) {
+            world.sendEvent(Hit(frame, 1));
+            world.addResource<Level>();
+        }
+        world.update();
+    }
+    // The score changes when added (seen on frame 1) and on frame 3.
+    TEST_ASSERT_EQUAL(2, changed);
+    TEST_ASSERT_EQUAL(3, every);
+    TEST_ASSERT_EQUAL(7, always);
+    TEST_ASSERT_EQUAL(1, present);
+    TEST_ASSERT_EQUAL(3, exists);
+    // Skipped on frame 3 by the second condition, the change is still unseen on frame 4.
+    TEST_ASSERT_EQUAL(2, both);
+}
+
+void test_custom_schedules() {
+    World world;
+    world.setTimestep(1.0 / 60.0);
+    world.addSchedule("physics", DefaultSchedules::Update, 120.0);
+    world.addSchedule("ai", DefaultSchedules::Update, 10.0);
+    world.addSchedule("late", DefaultSchedules::PostUpdate);
+    uint64 physics = 0;
+    uint64 ai = 0;
+    Vec<std::string> order;
+    world.addSystem<ReadRequest<FrameArena>>("physics", [&](auto arena) { physics++; });
+    world.addSystem<ReadRequest<FrameArena>>("ai", [&](auto arena) { ai++; });
+    world.addSystem<Anything>("late", [&](auto anything) { order.push_back("late"); });
+    world.addSystem<Anything>(DefaultSchedules::PostUpdate, [&](auto anything) { order.push_back("post"); });
+    for (uint64 i = 0; i < 60; i++) {
+        world.update();
+    }
+    TEST_ASSERT_EQUAL(120, physics);
+    TEST_ASSERT_EQUAL(10, ai);
+    TEST_ASSERT_EQUAL(120, order.size());
+    TEST_ASSERT_EQUAL_STRING("post", order[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("late", order[1].c_str());
+
+    bool thrown = false;
+    try {
+        world.addSystem<Anything>("missing", [](auto anything) {});
+    } catch (const ScheduleNotFoundException<SystemManager>&) {
+        thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown);
+    thrown = false;
+    try {
+        world.addSchedule("ai", DefaultSchedules::PreUpdate);
+    } catch (const DuplicateScheduleException<SystemManager>&) {
+        thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown);
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_entity);
     RUN_TEST(test_system);
+    RUN_TEST(test_system_access);
+    RUN_TEST(test_parallel_systems);
+    RUN_TEST(test_commands);
+    RUN_TEST(test_parallel_commands);
+    RUN_TEST(test_commands_order);
+    RUN_TEST(test_change_detection);
+    RUN_TEST(test_spawn_batch);
+    RUN_TEST(test_events);
+    RUN_TEST(test_event_hooks);
+    RUN_TEST(test_commands_add_systems);
+    RUN_TEST(test_event_queue_threads);
+    RUN_TEST(test_run_conditions);
+    RUN_TEST(test_custom_schedules);
     return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <chrono>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+#include "core/geom/aabb_batch.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt;
+
+static constexpr uint BOXES = 100000;
+static constexpr uint QUERIES = 200;
+static constexpr float WORLD = 1000.0f;
+
+/**
+ * @brief Gets the time since a point in seconds.
+ */
+static double since(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Runs a test against every box once per query, returning millions of boxes tested per second and adding the number of boxes found
+ * to a total.
+ */
+template <typename TestFunc>
+static double rate(TestFunc&& test, uint64& total) {
+    Vec<uint> found;
+    found.reserve(BOXES);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint i = 0; i < QUERIES; i++) {
+        found.clear();
+        test(found, i);
+        total += found.size();
+    }
+    return (double)BOXES * QUERIES / since(start) / 1e6;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares testing a hundred thousand boxes one AABB at a time against every kernel the CPU supports, for box queries and frustums.
+ */
+void bench_aabb_batch() {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0f, WORLD);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    Vec<AABB> boxes;
+    for (uint i = 0; i < BOXES; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        boxes.emplace_back(min, min + glm::vec3(size(random), size(random), size(random)));
+    }
+    const AABBBatch batch(boxes);
+    Vec<AABB> ranges;
+    Vec<Frustum> frustums;
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 1.0f, WORLD / 4.0f);
+    for (uint i = 0; i < QUERIES; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        ranges.emplace_back(min, min + glm::vec3(50.0f));
+        frustums.emplace_back(projection * glm::lookAt(min, glm::vec3(WORLD / 2.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    }
+
+    uint64 expectedRange = 0, expectedFrustum = 0;
+    const double aabbRange = rate(
+        [&](Vec<uint>& found, const uint query) {
+            for (uint i = 0; i < BOXES; i++) {
+                if (boxes[i].intersects(ranges[query])) {
+                    found.push_back(i);
+                }
+            }
+        },
+        expectedRange);
+    const double aabbFrustum = rate(
+        [&](Vec<uint>& found, const uint query) {
+            for (uint i = 0; i < BOXES; i++) {
+                if (frustums[query].intersects(boxes[i])) {
+                    found.push_back(i);
+                }
+            }
+        },
+        expectedFrustum);
+    printf("%u boxes, millions of boxes tested per second:\n", BOXES);
+    printf("  AABB:   range %8.1f, frustum %8.1f\n", aabbRange, aabbFrustum);
+
+    const AABBBatch::Kernel picked = AABBBatch::getKernel();
+    for (const AABBBatch::Kernel kernel :
+         {AABBBatch::Kernel::Scalar, AABBBatch::Kernel::SSE2, AABBBatch::Kernel::AVX2, AABBBatch::Kernel::NEON}) {
+        if (!AABBBatch::setKernel(kernel)) {
+            continue;
+        }
+        uint64 foundRange = 0, foundFrustum = 0;
+        const double batchRange = rate([&](Vec<uint>& found, const uint query) { batch.intersects(found, ranges[query]); }, foundRange);
+        const double batchFrustum = rate([&](Vec<uint>& found, const uint query) { batch.intersects(found, frustums[query]); }, foundFrustum);
+        TEST_ASSERT_EQUAL(expectedRange, foundRange);
+        TEST_ASSERT_EQUAL(expectedFrustum, foundFrustum);
+        printf("  %-7s range %8.1f, frustum %8.1f\n", AABBBatch::getName(kernel), batchRange, batchFrustum);
+    }
+    AABBBatch::setKernel(picked);
+    printf("picked at startup: %s\n", AABBBatch::getName(picked));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_aabb_batch);
+    return UNITY_END();
+}
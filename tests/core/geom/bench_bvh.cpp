@@ -0,0 +1,123 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <chrono>
+#include <random>
+
+#include "core/geom/bvh.h"
+#include "core/geom/octree.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt;
+
+static constexpr uint BOXES = 1000000;
+static constexpr uint QUERIES = 10000;
+static constexpr float WORLD = 1000.0f;
+
+struct Box {
+    AABB bounds;
+    uint id;
+};
+
+static AABB getBoxBounds(const Box& box) { return box.bounds; }
+
+/**
+ * @brief Gets the time since a point in milliseconds.
+ */
+static double since(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Times a number of range and point queries, returning the time per query in microseconds and adding the number of elements found to
+ * a total.
+ */
+template <typename QueryFunc>
+static double time(const Vec<AABB>& ranges, QueryFunc&& query, uint64& total) {
+    Vec<Wrap<Box>> found;
+    const auto start = std::chrono::steady_clock::now();
+    for (const AABB& range : ranges) {
+        found.clear();
+        query(found, range);
+        total += found.size();
+    }
+    return since(start) * 1000.0 / ranges.size();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares building and querying a BVH against the octree, at a million boxes.
+ */
+void bench_bvh() {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0f, WORLD);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    Vec<Box> boxes;
+    boxes.reserve(BOXES);
+    for (uint i = 0; i < BOXES; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        boxes.push_back({AABB(min, min + glm::vec3(size(random), size(random), size(random))), i});
+    }
+    Vec<AABB> ranges;
+    Vec<AABB> points;
+    for (uint i = 0; i < QUERIES; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        ranges.emplace_back(min, min + glm::vec3(20.0f));
+        points.emplace_back(min, min);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Octree<Box>::Configuration config(getBoxBounds, 10, 8);
+    Octree<Box> octree(AABB(glm::vec3(0.0f), glm::vec3(WORLD + 4.0f)), config);
+    for (const Box& box : boxes) {
+        octree.insert(box);
+    }
+    const double octreeBuild = since(start);
+
+    start = std::chrono::steady_clock::now();
+    BVH<Box> sah(getBoxBounds);
+    sah.build(boxes);
+    const double sahBuild = since(start);
+
+    start = std::chrono::steady_clock::now();
+    BVH<Box> longestAxis(getBoxBounds);
+    longestAxis.build(boxes, LongestAxisSplitStrategy());
+    const double longestAxisBuild = since(start);
+
+    // The octree only finds the boxes a range contains, which are fewer than the ones it intersects.
+    uint64 octreeFound = 0, sahFound = 0, longestAxisFound = 0;
+    const double octreeRange = time(ranges, [&](Vec<Wrap<Box>>& found, const AABB& range) { octree.query(found, range); }, octreeFound);
+    const double sahRange = time(ranges, [&](Vec<Wrap<Box>>& found, const AABB& range) { sah.query(found, range); }, sahFound);
+    const double longestAxisRange =
+        time(ranges, [&](Vec<Wrap<Box>>& found, const AABB& range) { longestAxis.query(found, range); }, longestAxisFound);
+    TEST_ASSERT_EQUAL(sahFound, longestAxisFound);
+    TEST_ASSERT_TRUE(octreeFound <= sahFound);
+
+    octreeFound = sahFound = 0;
+    const double octreePoint = time(points, [&](Vec<Wrap<Box>>& found, const AABB& point) { octree.query(found, point.getMin()); }, octreeFound);
+    const double sahPoint = time(points, [&](Vec<Wrap<Box>>& found, const AABB& point) { sah.query(found, point.getMin()); }, sahFound);
+    TEST_ASSERT_EQUAL(octreeFound, sahFound);
+
+    uint64 hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint i = 0; i < QUERIES; i++) {
+        const glm::vec3 direction = points[(i + 1) % QUERIES].getMin() - points[i].getMin();
+        hits += sah.raycast(points[i].getMin(), direction).has_value();
+    }
+    const double sahRay = since(start) * 1000.0 / QUERIES;
+    TEST_ASSERT_TRUE(hits > 0);
+
+    printf("%u boxes, build: octree %.1f ms, BVH %.1f ms (SAH) / %.1f ms (longest axis)\n", BOXES, octreeBuild, sahBuild, longestAxisBuild);
+    printf("range query: octree %.2f us, BVH %.2f us (SAH) / %.2f us (longest axis)\n", octreeRange, sahRange, longestAxisRange);
+    printf("point query: octree %.2f us, BVH %.2f us; closest ray: BVH %.2f us\n", octreePoint, sahPoint, sahRay);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_bvh);
+    return UNITY_END();
+}
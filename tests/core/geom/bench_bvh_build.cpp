@@ -0,0 +1,66 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <chrono>
+#include <random>
+
+#include "core/geom/bvh.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt::core;
+using namespace cobalt;
+
+/**
+ * @brief Builds a BVH over some boxes, returning the time it took in milliseconds.
+ */
+template <typename BuildFunc>
+static double time(BuildFunc&& build) {
+    const auto start = std::chrono::steady_clock::now();
+    build();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares building on one thread against building on a thread pool, from a hundred thousand to ten million boxes.
+ */
+void bench_bvh_build() {
+    thread::ThreadPool threadPool;
+    for (const uint count : {100000u, 1000000u, 10000000u}) {
+        // The elements are indices into the boxes, to keep the copies the BVH makes small.
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+        std::uniform_real_distribution<float> size(0.5f, 4.0f);
+        Vec<AABB> boxes;
+        Vec<uint> indices;
+        boxes.reserve(count);
+        indices.reserve(count);
+        for (uint i = 0; i < count; i++) {
+            const glm::vec3 min(position(random), position(random), position(random));
+            boxes.emplace_back(min, min + glm::vec3(size(random), size(random), size(random)));
+            indices.push_back(i);
+        }
+        BVH<uint> bvh([&boxes](const uint& index) { return boxes[index]; });
+
+        const double serial = time([&]() { bvh.build(indices); });
+        const uint64 nodes = bvh.getNodes().size();
+        const double longestAxis = time([&]() { bvh.build(indices, LongestAxisSplitStrategy()); });
+        const double parallel = time([&]() { bvh.build(indices, threadPool); });
+        TEST_ASSERT_EQUAL(nodes, bvh.getNodes().size());
+        const double parallelLongestAxis = time([&]() { bvh.build(indices, threadPool, LongestAxisSplitStrategy()); });
+        TEST_ASSERT_EQUAL(count, bvh.getSize());
+
+        printf("%u boxes: SAH %.1f ms, %.1f ms on %u threads; longest axis %.1f ms, %.1f ms on %u threads\n", count, serial, parallel,
+               threadPool.getThreadCount() + 1, longestAxis, parallelLongestAxis, threadPool.getThreadCount() + 1);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_bvh_build);
+    return UNITY_END();
+}
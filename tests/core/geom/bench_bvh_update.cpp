@@ -0,0 +1,109 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <chrono>
+#include <random>
+
+#include "core/geom/bvh.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt;
+
+static constexpr uint BOXES = 20000;
+static constexpr uint MOVERS = 4000;
+static constexpr uint FRAMES = 300;
+static constexpr uint64 BUDGET = 1024;
+static constexpr float WORLD = 500.0f;
+
+static Vec<AABB> boxes;
+static Vec<glm::vec3> velocities;
+
+static AABB getBoxBounds(const uint& index) { return boxes[index]; }
+
+/**
+ * @brief Moves the first MOVERS boxes one frame, bouncing them off the edges of the world.
+ */
+static void move() {
+    for (uint i = 0; i < MOVERS; i++) {
+        glm::vec3 min = boxes[i].getMin() + velocities[i];
+        for (int axis = 0; axis < 3; axis++) {
+            if (min[axis] < 0.0f || min[axis] > WORLD) {
+                velocities[i][axis] = -velocities[i][axis];
+                min[axis] = glm::clamp(min[axis], 0.0f, WORLD);
+            }
+        }
+        boxes[i] = AABB(min, min + boxes[i].getSize());
+    }
+}
+
+/**
+ * @brief Runs every frame, moving the boxes and keeping a BVH up to date, returning the mean and longest time per frame in milliseconds.
+ */
+template <typename UpdateFunc>
+static Pair<double, double> run(BVH<uint>& bvh, const Vec<AABB>& start, UpdateFunc&& update) {
+    boxes = start;
+    velocities.clear();
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+    for (uint i = 0; i < MOVERS; i++) {
+        velocities.emplace_back(speed(random), speed(random), speed(random));
+    }
+    Vec<uint> indices;
+    for (uint i = 0; i < BOXES; i++) {
+        indices.push_back(i);
+    }
+    bvh.build(indices);
+    double total = 0.0, longest = 0.0;
+    for (uint frame = 0; frame < FRAMES; frame++) {
+        move();
+        const auto start = std::chrono::steady_clock::now();
+        update();
+        const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        total += time;
+        longest = std::max(longest, time);
+    }
+    return {total / FRAMES, longest};
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares keeping a BVH up to date with moving boxes by refitting, by updating within a budget and by rebuilding it every frame.
+ */
+void bench_bvh_update() {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0f, WORLD);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    Vec<AABB> start;
+    for (uint i = 0; i < BOXES; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        start.emplace_back(min, min + glm::vec3(size(random), size(random), size(random)));
+    }
+
+    BVH<uint> refitted(getBoxBounds);
+    const Pair<double, double> refit = run(refitted, start, [&]() { refitted.refit(); });
+    BVH<uint> updated(getBoxBounds);
+    uint64 rebuilt = 0;
+    const Pair<double, double> update = run(updated, start, [&]() { rebuilt += updated.update(BUDGET); });
+    BVH<uint> full(getBoxBounds);
+    Vec<uint> indices;
+    for (uint i = 0; i < BOXES; i++) {
+        indices.push_back(i);
+    }
+    const Pair<double, double> rebuild = run(full, start, [&]() { full.build(indices); });
+    TEST_ASSERT_TRUE(rebuilt > 0);
+    TEST_ASSERT_TRUE(updated.getCost() < refitted.getCost());
+
+    printf("%u boxes, %u moving, per frame: refit %.3f ms (longest %.3f), update %.3f ms (longest %.3f, %lu elements rebuilt), rebuild %.3f ms\n",
+           BOXES, MOVERS, refit.first, refit.second, update.first, update.second, rebuilt / FRAMES, rebuild.first);
+    printf("query cost after %u frames: refit %.1f, update %.1f, rebuild %.1f\n", FRAMES, refitted.getCost(), updated.getCost(), full.getCost());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_bvh_update);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <chrono>
+#include <random>
+
+#include "core/geom/octree.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt;
+
+static constexpr uint BOXES = 20000;
+static constexpr uint MOVERS = 4000;
+static constexpr uint FRAMES = 100;
+static constexpr uint QUERIES = 2000;
+static constexpr float WORLD = 1000.0f;
+
+static Vec<glm::vec3> positions;  // The position of each box, which is its index.
+static Vec<glm::vec3> sizes;      // The size of each box.
+
+static AABB getBoxBounds(const uint& box) { return AABB(positions[box], positions[box] + sizes[box]); }
+
+/**
+ * @brief Gets the time since a point in milliseconds.
+ */
+static double since(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Counts the elements kept in a node and its descendants above a given depth.
+ */
+static uint64 countShallow(const auto& node, const uint depth) {
+    if (depth == 0) {
+        return 0;
+    }
+    uint64 count = Octree<uint>::Debug::getData(node).size();
+    for (const auto& child : Octree<uint>::Debug::getChildren(node)) {
+        count += countShallow(child, depth - 1);
+    }
+    return count;
+}
+
+/**
+ * @brief Moves the same boxes around an octree every frame, updating it, then times range queries against it.
+ */
+static void simulate(const char* name, const float looseness) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0f, WORLD - 4.0f);
+    std::uniform_real_distribution<float> size(0.5f, 4.0f);
+    std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+    positions.clear();
+    sizes.clear();
+    for (uint i = 0; i < BOXES; i++) {
+        positions.emplace_back(position(random), position(random), position(random));
+        sizes.emplace_back(size(random), size(random), size(random));
+    }
+    Vec<AABB> ranges;
+    for (uint i = 0; i < QUERIES; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        ranges.emplace_back(min, min + glm::vec3(20.0f));
+    }
+
+    Octree<uint>::Configuration config(getBoxBounds, 10, 8, looseness);
+    Octree<uint> octree(AABB(glm::vec3(0.0f), glm::vec3(WORLD)), config);
+    auto start = std::chrono::steady_clock::now();
+    for (uint i = 0; i < BOXES; i++) {
+        octree.insert(i);
+    }
+    const double build = since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (uint frame = 0; frame < FRAMES; frame++) {
+        for (uint i = 0; i < MOVERS; i++) {
+            const AABB oldBounds = getBoxBounds(i);
+            positions[i] = glm::clamp(positions[i] + glm::vec3(step(random), step(random), step(random)), glm::vec3(0.0f),
+                                      glm::vec3(WORLD - 4.0f));
+            TEST_ASSERT_TRUE(octree.update(i, oldBounds));
+        }
+    }
+    const double update = since(start) / FRAMES;
+
+    Vec<Wrap<uint>> found;
+    uint64 total = 0;
+    start = std::chrono::steady_clock::now();
+    for (const AABB& range : ranges) {
+        found.clear();
+        octree.query(found, range);
+        total += found.size();
+    }
+    const double query = since(start) * 1000.0 / QUERIES;
+    found.clear();
+    octree.query(found);
+    TEST_ASSERT_EQUAL(BOXES, found.size());
+
+    const uint64 shallow = countShallow(Octree<uint>::Debug::getRoot(octree), 3);
+    printf("%-8s build %6.1f ms, update %5.2f ms/frame (%.2f us/box), range query %6.2f us (%lu found), %lu boxes above depth 3\n", name,
+           build, update, update * 1000.0 / MOVERS, query, (unsigned long)total, (unsigned long)shallow);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares updating a regular and a loose octree as a fifth of their boxes move every frame.
+ */
+void bench_octree_update() {
+    printf("%u boxes, %u moving for %u frames:\n", BOXES, MOVERS, FRAMES);
+    simulate("regular", 1.0f);
+    simulate("loose", 2.0f);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_octree_update);
+    return UNITY_END();
+}
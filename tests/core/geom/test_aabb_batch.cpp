@@ -0,0 +1,158 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+#include "core/geom/aabb_batch.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt;
+
+static const AABBBatch::Kernel KERNELS[] = {AABBBatch::Kernel::Scalar, AABBBatch::Kernel::SSE2, AABBBatch::Kernel::AVX2,
+                                            AABBBatch::Kernel::NEON};
+static const AABBBatch::Kernel PICKED = AABBBatch::getKernel();  // The kernel picked at startup, restored after each test.
+
+/**
+ * @brief Scatters boxes of random sizes over a 100-unit cube centered on the origin. The count is not a multiple of any kernel's width, so
+ * the padding is always in play.
+ */
+static Vec<AABB> scatter(const uint count) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.1f, 8.0f);
+    Vec<AABB> boxes;
+    for (uint i = 0; i < count; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        boxes.emplace_back(min, min + glm::vec3(size(random), size(random), size(random)));
+    }
+    return boxes;
+}
+
+/**
+ * @brief A camera at the edge of the cube, looking into it.
+ */
+static Frustum getFrustum() {
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.5f, 60.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 50.0f), glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum(projection * view);
+}
+
+void setUp() {}
+
+void tearDown() { AABBBatch::setKernel(PICKED); }
+
+void test_storage() {
+    AABBBatch batch;
+    TEST_ASSERT_EQUAL(0, batch.getSize());
+    for (uint i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL(i, batch.push(AABB(glm::vec3((float)i), glm::vec3((float)i + 1.0f))));
+    }
+    TEST_ASSERT_EQUAL(20, batch.getSize());
+    batch.set(7, AABB({-1, -2, -3}, {1, 2, 3}));
+    const AABB box = batch.get(7);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0f, box.getMin().y);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, box.getMax().z);
+    TEST_ASSERT_EQUAL_FLOAT(19.0f, batch.get(19).getMin().x);
+    batch.clear();
+    TEST_ASSERT_EQUAL(0, batch.getSize());
+}
+
+void test_empty() {
+    for (const AABBBatch::Kernel kernel : KERNELS) {
+        if (!AABBBatch::setKernel(kernel)) {
+            continue;
+        }
+        AABBBatch batch;
+        Vec<uint> found;
+        // Even a query spanning everything must not find the padding.
+        TEST_ASSERT_EQUAL(0, batch.intersects(found, AABB(glm::vec3(-FLT_MAX), glm::vec3(FLT_MAX))));
+        batch.push(AABB({0, 0, 0}, {1, 1, 1}));
+        TEST_ASSERT_EQUAL(1, batch.intersects(found, AABB(glm::vec3(-FLT_MAX), glm::vec3(FLT_MAX))));
+        TEST_ASSERT_EQUAL(0, found[0]);
+        TEST_ASSERT_EQUAL_FLOAT(1.0f, batch.getBounds().getMax().x);
+    }
+}
+
+void test_kernels() {
+    TEST_ASSERT_TRUE(AABBBatch::isSupported(AABBBatch::Kernel::Scalar));
+    const Vec<AABB> boxes = scatter(1003);
+    const AABBBatch batch(boxes);
+    const Vec<AABB> queries = scatter(50);
+    for (const AABBBatch::Kernel kernel : KERNELS) {
+        if (!AABBBatch::setKernel(kernel)) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL(kernel, AABBBatch::getKernel());
+        for (const AABB& query : queries) {
+            Vec<uint> expected;
+            for (uint i = 0; i < boxes.size(); i++) {
+                if (boxes[i].intersects(query)) {
+                    expected.push_back(i);
+                }
+            }
+            Vec<uint> found;
+            TEST_ASSERT_EQUAL(expected.size(), batch.intersects(found, query));
+            TEST_ASSERT_TRUE(expected == found);
+
+            expected.clear();
+            for (uint i = 0; i < boxes.size(); i++) {
+                if (boxes[i].contains(query.getMin())) {
+                    expected.push_back(i);
+                }
+            }
+            found.clear();
+            TEST_ASSERT_EQUAL(expected.size(), batch.contains(found, query.getMin()));
+            TEST_ASSERT_TRUE(expected == found);
+        }
+
+        AABB bounds;
+        for (const AABB& box : boxes) {
+            bounds += box;
+        }
+        const AABB batchBounds = batch.getBounds();
+        TEST_ASSERT_TRUE(bounds.getMin() == batchBounds.getMin());
+        TEST_ASSERT_TRUE(bounds.getMax() == batchBounds.getMax());
+    }
+}
+
+void test_frustum() {
+    const Frustum frustum = getFrustum();
+    TEST_ASSERT_TRUE(frustum.contains({0, 0, 40}));
+    TEST_ASSERT_FALSE(frustum.contains({0, 0, 60}));
+    TEST_ASSERT_FALSE(frustum.contains({0, 0, -20}));
+    TEST_ASSERT_TRUE(frustum.intersects(AABB({-1, -1, 30}, {1, 1, 32})));
+    TEST_ASSERT_TRUE(frustum.intersects(AABB({-100, -1, 30}, {100, 1, 32})));
+    TEST_ASSERT_FALSE(frustum.intersects(AABB({-1, -1, 51}, {1, 1, 52})));
+    TEST_ASSERT_FALSE(frustum.intersects(AABB({-1, 30, 40}, {1, 32, 42})));
+    const glm::vec4& near = frustum.getPlane(Frustum::Plane::Near);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, glm::length(glm::vec3(near)));
+
+    const Vec<AABB> boxes = scatter(1003);
+    const AABBBatch batch(boxes);
+    Vec<uint> expected;
+    for (uint i = 0; i < boxes.size(); i++) {
+        if (frustum.intersects(boxes[i])) {
+            expected.push_back(i);
+        }
+    }
+    TEST_ASSERT_TRUE(expected.size() > 0 && expected.size() < boxes.size());
+    for (const AABBBatch::Kernel kernel : KERNELS) {
+        if (!AABBBatch::setKernel(kernel)) {
+            continue;
+        }
+        Vec<uint> found;
+        TEST_ASSERT_EQUAL(expected.size(), batch.intersects(found, frustum));
+        TEST_ASSERT_TRUE(expected == found);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_storage);
+    RUN_TEST(test_empty);
+    RUN_TEST(test_kernels);
+    RUN_TEST(test_frustum);
+    return UNITY_END();
+}
@@ -0,0 +1,341 @@
+// Created by tomas on
+// 19-09-2024.
+
+#include <random>
+
+#include "core/geom/bvh.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::geom;
+using namespace cobalt::core;
+using namespace cobalt;
+
+struct Box {
+    AABB bounds;
+    uint id;
+};
+
+static AABB getBoxBounds(const Box& box) { return box.bounds; }
+
+/**
+ * @brief Scatters small boxes of random sizes over a 100-unit cube.
+ */
+static Vec<Box> scatter(const uint count) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    Vec<Box> boxes;
+    for (uint i = 0; i < count; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        boxes.push_back({AABB(min, min + glm::vec3(size(random), size(random), size(random))), i});
+    }
+    return boxes;
+}
+
+/**
+ * @brief Sorts the ids of found boxes, to compare them regardless of order.
+ */
+static Vec<uint> getIds(const Vec<Wrap<Box>>& found) {
+    Vec<uint> ids;
+    for (const Box& box : found) {
+        ids.push_back(box.id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_empty() {
+    BVH<Box> bvh(getBoxBounds);
+    bvh.build({});
+    Vec<Wrap<Box>> found;
+    bvh.query(found, AABB({0, 0, 0}, {1, 1, 1}));
+    bvh.query(found, glm::vec3(0.0f));
+    bvh.raycast(found, {0, 0, 0}, {1, 1, 1});
+    TEST_ASSERT_EQUAL(0, found.size());
+    TEST_ASSERT_FALSE(bvh.raycast({0, 0, 0}, {1, 1, 1}).has_value());
+    TEST_ASSERT_EQUAL(0, bvh.getNodes().size());
+}
+
+void test_layout() {
+    const Vec<Box> boxes = scatter(1000);
+    for (const uint maxLeafSize : {1u, 4u, 16u}) {
+        BVH<Box> bvh(getBoxBounds, maxLeafSize);
+        bvh.build(boxes);
+        const Vec<BVH<Box>::Node>& nodes = bvh.getNodes();
+        TEST_ASSERT_EQUAL(1000, bvh.getSize());
+        TEST_ASSERT_TRUE(nodes.size() <= 2 * 1000 - 1);
+
+        // Every element is in exactly one leaf, and every node encloses its children.
+        Vec<uint> seen(1000, 0);
+        for (uint i = 0; i < nodes.size(); i++) {
+            const BVH<Box>::Node& node = nodes[i];
+            if (node.isLeaf()) {
+                TEST_ASSERT_TRUE(node.count <= maxLeafSize);
+                for (uint element = node.index; element < node.index + node.count; element++) {
+                    seen[bvh.getElements()[element].id]++;
+                    TEST_ASSERT_TRUE(node.getBounds().contains(bvh.getElements()[element].bounds));
+                }
+            } else {
+                TEST_ASSERT_TRUE(node.getBounds().contains(nodes[i + 1].getBounds()));
+                TEST_ASSERT_TRUE(node.getBounds().contains(nodes[node.index].getBounds()));
+            }
+        }
+        for (const uint count : seen) {
+            TEST_ASSERT_EQUAL(1, count);
+        }
+    }
+}
+
+void test_query() {
+    const Vec<Box> boxes = scatter(2000);
+    BVH<Box> sah(getBoxBounds);
+    sah.build(boxes);
+    BVH<Box> longestAxis(getBoxBounds);
+    longestAxis.build(boxes, LongestAxisSplitStrategy());
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-10.0f, 110.0f);
+    for (uint i = 0; i < 100; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        const AABB range(min, min + glm::vec3(8.0f));
+        Vec<uint> expected;
+        for (const Box& box : boxes) {
+            if (box.bounds.intersects(range)) {
+                expected.push_back(box.id);
+            }
+        }
+        Vec<Wrap<Box>> found;
+        sah.query(found, range);
+        TEST_ASSERT_TRUE(getIds(found) == expected);
+        found.clear();
+        longestAxis.query(found, range);
+        TEST_ASSERT_TRUE(getIds(found) == expected);
+
+        const glm::vec3 point = range.getCenter();
+        expected.clear();
+        for (const Box& box : boxes) {
+            if (box.bounds.contains(point)) {
+                expected.push_back(box.id);
+            }
+        }
+        found.clear();
+        sah.query(found, point);
+        TEST_ASSERT_TRUE(getIds(found) == expected);
+    }
+}
+
+void test_raycast() {
+    BVH<Box> bvh(getBoxBounds, 1);
+    bvh.build({{AABB({4, -1, -1}, {5, 1, 1}), 0},
+               {AABB({2, -1, -1}, {3, 1, 1}), 1},
+               {AABB({8, -1, -1}, {9, 1, 1}), 2},
+               {AABB({2, 5, -1}, {3, 6, 1}), 3},
+               {AABB({-3, -1, -1}, {-2, 1, 1}), 4}});
+
+    // The closest box in front of the ray.
+    Opt<BVH<Box>::Hit> hit = bvh.raycast({0, 0, 0}, {1, 0, 0});
+    TEST_ASSERT_TRUE(hit.has_value());
+    TEST_ASSERT_EQUAL(1, hit->element.get().id);
+    TEST_ASSERT_TRUE(hit->distance == 2.0f);
+    // The direction's length scales distances.
+    hit = bvh.raycast({0, 0, 0}, {2, 0, 0});
+    TEST_ASSERT_TRUE(hit->distance == 1.0f);
+    // A ray that starts inside a box hits it right away.
+    hit = bvh.raycast({4.5f, 0, 0}, {1, 0, 0});
+    TEST_ASSERT_EQUAL(0, hit->element.get().id);
+    TEST_ASSERT_TRUE(hit->distance == 0.0f);
+    // Too short, or pointing away.
+    TEST_ASSERT_FALSE(bvh.raycast({0, 0, 0}, {1, 0, 0}, 1.5f).has_value());
+    TEST_ASSERT_FALSE(bvh.raycast({10, 0, 0}, {1, 0, 0}).has_value());
+
+    Vec<Wrap<Box>> found;
+    bvh.raycast(found, {0, 0, 0}, {1, 0, 0});
+    TEST_ASSERT_TRUE(getIds(found) == Vec<uint>({0, 1, 2}));
+    found.clear();
+    bvh.raycast(found, {0, 0, 0}, {1, 0, 0}, 4.5f);
+    TEST_ASSERT_TRUE(getIds(found) == Vec<uint>({0, 1}));
+
+    // Against brute force, over many boxes.
+    const Vec<Box> boxes = scatter(2000);
+    bvh.build(boxes);
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (uint i = 0; i < 100; i++) {
+        const glm::vec3 origin(50.0f + 60.0f * unit(random), 50.0f + 60.0f * unit(random), 50.0f + 60.0f * unit(random));
+        const glm::vec3 direction(unit(random), unit(random), unit(random));
+        const glm::vec3 inverse = 1.0f / direction;
+        float closest = FLT_MAX;
+        for (const Box& box : boxes) {
+            const glm::vec3 toMin = (box.bounds.getMin() - origin) * inverse;
+            const glm::vec3 toMax = (box.bounds.getMax() - origin) * inverse;
+            const glm::vec3 entries = glm::min(toMin, toMax);
+            const glm::vec3 exits = glm::max(toMin, toMax);
+            const float entry = std::max({entries.x, entries.y, entries.z, 0.0f});
+            if (entry <= std::min({exits.x, exits.y, exits.z})) {
+                closest = std::min(closest, entry);
+            }
+        }
+        hit = bvh.raycast(origin, direction);
+        TEST_ASSERT_EQUAL(closest != FLT_MAX, hit.has_value());
+        if (hit.has_value()) {
+            TEST_ASSERT_TRUE(hit->distance == closest);
+        }
+    }
+}
+
+void test_parallel_build() {
+    const Vec<Box> boxes = scatter(50000);
+    BVH<Box> serial(getBoxBounds);
+    serial.build(boxes);
+    thread::ThreadPool threadPool(3);
+    BVH<Box> parallel(getBoxBounds);
+    parallel.build(boxes, threadPool);
+
+    // Same splits, same depth-first order.
+    TEST_ASSERT_EQUAL(serial.getNodes().size(), parallel.getNodes().size());
+    TEST_ASSERT_EQUAL_MEMORY(serial.getNodes().data(), parallel.getNodes().data(), serial.getNodes().size() * sizeof(BVH<Box>::Node));
+    for (uint i = 0; i < boxes.size(); i++) {
+        TEST_ASSERT_EQUAL(serial.getElements()[i].id, parallel.getElements()[i].id);
+    }
+    Vec<Wrap<Box>> found;
+    parallel.query(found, AABB({10, 10, 10}, {20, 20, 20}));
+    TEST_ASSERT_TRUE(found.size() > 0);
+
+    parallel.build({}, threadPool);
+    TEST_ASSERT_EQUAL(0, parallel.getNodes().size());
+}
+
+/**
+ * @brief Checks that every element is in exactly one leaf and every node encloses its children.
+ */
+template <typename ElementType>
+static void checkStructure(const BVH<ElementType>& bvh, const Func<AABB(const ElementType&)>& getBounds) {
+    const Vec<typename BVH<ElementType>::Node>& nodes = bvh.getNodes();
+    uint64 elements = 0;
+    for (uint i = 0; i < nodes.size(); i++) {
+        const auto& node = nodes[i];
+        if (node.isLeaf()) {
+            TEST_ASSERT_EQUAL(elements, node.index);
+            elements += node.count;
+            for (uint element = node.index; element < node.index + node.count; element++) {
+                TEST_ASSERT_TRUE(node.getBounds().contains(getBounds(bvh.getElements()[element])));
+            }
+        } else {
+            TEST_ASSERT_TRUE(node.index > i + 1 && node.index < nodes.size());
+            TEST_ASSERT_TRUE(node.getBounds().contains(nodes[i + 1].getBounds()));
+            TEST_ASSERT_TRUE(node.getBounds().contains(nodes[node.index].getBounds()));
+        }
+    }
+    TEST_ASSERT_EQUAL(bvh.getSize(), elements);
+}
+
+static Vec<AABB> moving;
+
+static AABB getMovingBounds(const uint& index) { return moving[index]; }
+
+/**
+ * @brief Checks range queries against brute force.
+ */
+static void checkQueries(BVH<uint>& bvh) {
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> position(-10.0f, 210.0f);
+    for (uint i = 0; i < 50; i++) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        const AABB range(min, min + glm::vec3(15.0f));
+        Vec<uint> expected;
+        for (uint box = 0; box < moving.size(); box++) {
+            if (moving[box].intersects(range)) {
+                expected.push_back(box);
+            }
+        }
+        Vec<Wrap<uint>> found;
+        bvh.query(found, range);
+        Vec<uint> ids;
+        for (const uint box : found) {
+            ids.push_back(box);
+        }
+        std::sort(ids.begin(), ids.end());
+        TEST_ASSERT_TRUE(ids == expected);
+    }
+}
+
+void test_refit() {
+    moving.clear();
+    Vec<uint> indices;
+    for (const Box& box : scatter(3000)) {
+        moving.push_back(box.bounds);
+        indices.push_back(box.id);
+    }
+    BVH<uint> bvh(getMovingBounds);
+    bvh.build(indices);
+    const Vec<BVH<uint>::Node> built = bvh.getNodes();
+
+    // Everything drifts, some boxes far.
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+    for (uint i = 0; i < moving.size(); i++) {
+        const glm::vec3 move(offset(random), offset(random), offset(random));
+        moving[i] = AABB(moving[i].getMin() + move * (i % 10 == 0 ? 5.0f : 1.0f), moving[i].getMax() + move * (i % 10 == 0 ? 5.0f : 1.0f));
+    }
+    bvh.refit();
+    TEST_ASSERT_EQUAL(built.size(), bvh.getNodes().size());
+    for (uint i = 0; i < built.size(); i++) {
+        TEST_ASSERT_EQUAL(built[i].index, bvh.getNodes()[i].index);
+    }
+    checkStructure<uint>(bvh, getMovingBounds);
+    checkQueries(bvh);
+}
+
+void test_update() {
+    moving.clear();
+    Vec<uint> indices;
+    for (const Box& box : scatter(3000)) {
+        moving.push_back(box.bounds);
+        indices.push_back(box.id);
+    }
+    BVH<uint> refitted(getMovingBounds);
+    refitted.build(indices);
+    BVH<uint> updated(getMovingBounds);
+    updated.build(indices);
+    const float built = updated.getCost();
+
+    // Nothing moved, nothing to rebuild.
+    TEST_ASSERT_EQUAL(0, updated.update(3000));
+
+    // Shuffle a third of the boxes across the world.
+    std::mt19937 random(9);
+    std::uniform_real_distribution<float> position(0.0f, 200.0f);
+    for (uint i = 0; i < moving.size(); i += 3) {
+        const glm::vec3 min(position(random), position(random), position(random));
+        moving[i] = AABB(min, min + moving[i].getSize());
+    }
+    refitted.refit();
+    TEST_ASSERT_TRUE(refitted.getCost() > 1.5f * built);
+
+    // A small budget rebuilds a little, a large one restores the tree.
+    const uint64 rebuilt = updated.update(200);
+    TEST_ASSERT_TRUE(rebuilt > 0 && rebuilt <= 200);
+    checkStructure<uint>(updated, getMovingBounds);
+    checkQueries(updated);
+    TEST_ASSERT_TRUE(updated.update(3000) > 0);
+    checkStructure<uint>(updated, getMovingBounds);
+    checkQueries(updated);
+    TEST_ASSERT_TRUE(updated.getCost() < refitted.getCost());
+    TEST_ASSERT_EQUAL(0, updated.update(3000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_layout);
+    RUN_TEST(test_query);
+    RUN_TEST(test_raycast);
+    RUN_TEST(test_parallel_build);
+    RUN_TEST(test_refit);
+    RUN_TEST(test_update);
+    return UNITY_END();
+}
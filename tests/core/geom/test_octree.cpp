@@ -1,5 +1,7 @@
 // Created by tomas on 11-09-2024.
 
+#include <random>
+
 #include "core/geom/octree.h"
 #include "unity/unity.h"
 
@@ -148,6 +150,172 @@ void test_insert_duplicate_elements() {
     TEST_ASSERT_EQUAL_INT(2, found[1].get());
 }
 
+void test_remove() {
+    Octree<int>::Configuration config(getElementBounds, 10, 3);
+    Octree<int> octree(AABB({0.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 10.0f}), config);
+    for (int i = 0; i < 10; i++) {
+        octree.insert(i);
+    }
+    TEST_ASSERT_TRUE(octree.remove(5));
+    TEST_ASSERT_FALSE(octree.remove(5));
+    TEST_ASSERT_FALSE(octree.remove(42));
+    Vec<Wrap<int>> found;
+    octree.query(found);
+    TEST_ASSERT_EQUAL_INT(9, found.size());
+    for (int& element : found) {
+        TEST_ASSERT_NOT_EQUAL(5, element);
+    }
+    // Removing with the bounds it was inserted with, rather than its current ones
+    TEST_ASSERT_TRUE(octree.remove(7, getElementBounds(7)));
+    found.clear();
+    octree.query(found, glm::vec3(7.0f));
+    TEST_ASSERT_EQUAL_INT(0, found.size());
+}
+
+void test_collapse() {
+    // Test the children collapsing back into their parent when they empty out
+    Octree<int>::Configuration config(getElementBounds, 10, 2);
+    Octree<int> octree(AABB({0.0f, 0.0f, 0.0f}, {4.0f, 4.0f, 4.0f}), config);
+    octree.insert(1);
+    octree.insert(2);
+    octree.insert(3);  // This should cause a split
+    const auto& root = Octree<int>::Debug::getRoot(octree);
+    TEST_ASSERT_FALSE(root.isLeaf());
+
+    TEST_ASSERT_TRUE(octree.remove(3));  // Two elements left, which fit in the root again
+    TEST_ASSERT_TRUE(root.isLeaf());
+    TEST_ASSERT_EQUAL_INT(2, Octree<int>::Debug::getData(root).size());
+    Vec<Wrap<int>> found;
+    octree.query(found, glm::vec3(1.0f));
+    TEST_ASSERT_EQUAL_INT(1, found.size());
+    TEST_ASSERT_EQUAL_INT(1, found[0].get());
+}
+
+static Vec<glm::vec3> positions;  // The position of each moving element, which is its index.
+
+AABB getMovingBounds(const int& element) { return AABB(positions[element] - glm::vec3(0.5f), positions[element] + glm::vec3(0.5f)); }
+
+/**
+ * @brief An element compared by its id alone, carrying its position along.
+ */
+struct Body {
+    int id;
+    glm::vec3 position;
+
+    bool operator==(const Body& other) const { return id == other.id; }
+};
+
+AABB getBodyBounds(const Body& body) { return AABB(body.position - glm::vec3(0.5f), body.position + glm::vec3(0.5f)); }
+
+/**
+ * @brief Moves elements around an octree for a few rounds, checking they can all be found where they are after every round.
+ */
+void checkUpdates(const float looseness) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(1.0f, 99.0f);
+    std::uniform_real_distribution<float> step(-5.0f, 5.0f);
+    positions.clear();
+    for (int i = 0; i < 200; i++) {
+        positions.emplace_back(position(random), position(random), position(random));
+    }
+    Octree<int>::Configuration config(getMovingBounds, 8, 4, looseness);
+    Octree<int> octree(AABB({0.0f, 0.0f, 0.0f}, {100.0f, 100.0f, 100.0f}), config);
+    for (int i = 0; i < 200; i++) {
+        octree.insert(i);
+    }
+    for (int round = 0; round < 20; round++) {
+        for (int i = round % 2; i < 200; i += 2) {
+            const AABB oldBounds = getMovingBounds(i);
+            positions[i] = glm::clamp(positions[i] + glm::vec3(step(random), step(random), step(random)), glm::vec3(1.0f), glm::vec3(99.0f));
+            TEST_ASSERT_TRUE(octree.update(i, oldBounds));
+        }
+        Vec<Wrap<int>> found;
+        octree.query(found);
+        TEST_ASSERT_EQUAL_INT(200, found.size());
+        for (int i = 0; i < 200; i++) {
+            found.clear();
+            octree.query(found, positions[i]);
+            TEST_ASSERT_TRUE(std::find(found.begin(), found.end(), i) != found.end());
+        }
+    }
+    // Every element is still where its bounds lead to
+    for (int i = 0; i < 200; i++) {
+        TEST_ASSERT_TRUE(octree.remove(i));
+    }
+    TEST_ASSERT_TRUE(Octree<int>::Debug::getRoot(octree).isLeaf());
+    TEST_ASSERT_EQUAL_INT(0, Octree<int>::Debug::getData(Octree<int>::Debug::getRoot(octree)).size());
+}
+
+void test_update() {
+    checkUpdates(1.0f);
+    checkUpdates(2.0f);
+
+    // Elements that leave the octree are removed, like inserting them would have dropped them
+    positions = {glm::vec3(1.0f)};
+    Octree<int>::Configuration config(getMovingBounds, 8, 4);
+    Octree<int> octree(AABB({0.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 10.0f}), config);
+    octree.insert(0);
+    positions[0] = glm::vec3(20.0f);
+    TEST_ASSERT_TRUE(octree.update(0, AABB(glm::vec3(0.5f), glm::vec3(1.5f))));
+    TEST_ASSERT_FALSE(octree.update(0, AABB(glm::vec3(0.5f), glm::vec3(1.5f))));
+    Vec<Wrap<int>> found;
+    octree.query(found);
+    TEST_ASSERT_EQUAL_INT(0, found.size());
+
+    // The stored copy is replaced, whether the element stays in its node or moves to another
+    Octree<Body>::Configuration bodyConfig(getBodyBounds, 8, 4);
+    Octree<Body> bodies(AABB({0.0f, 0.0f, 0.0f}, {100.0f, 100.0f, 100.0f}), bodyConfig);
+    for (int i = 1; i <= 8; i++) {
+        bodies.insert(Body{i, glm::vec3(i % 2 ? 30.0f : 70.0f, i % 4 < 2 ? 30.0f : 70.0f, i < 5 ? 30.0f : 70.0f)});
+    }
+    Body body{0, glm::vec3(10.0f)};
+    bodies.insert(body);
+    for (const glm::vec3 position : {glm::vec3(10.5f), glm::vec3(80.0f)}) {
+        const AABB oldBounds = getBodyBounds(body);
+        body.position = position;
+        TEST_ASSERT_TRUE(bodies.update(body, oldBounds));
+        Vec<Wrap<Body>> foundBodies;
+        bodies.query(foundBodies, position);
+        TEST_ASSERT_EQUAL_INT(1, foundBodies.size());
+        TEST_ASSERT_EQUAL_FLOAT(position.x, foundBodies[0].get().position.x);
+    }
+}
+
+void test_loose() {
+    // An element straddling the root's split planes stays in the root of a regular octree, but not of a loose one
+    Octree<int>::Configuration regularConfig(getElementBounds, 10, 1);
+    Octree<int>::Configuration looseConfig(getElementBounds, 10, 1, 2.0f);
+    Octree<int> regular(AABB({0.0f, 0.0f, 0.0f}, {8.0f, 8.0f, 8.0f}), regularConfig);
+    Octree<int> loose(AABB({0.0f, 0.0f, 0.0f}, {8.0f, 8.0f, 8.0f}), looseConfig);
+    for (const int element : {1, 4}) {
+        regular.insert(element);
+        loose.insert(element);
+    }
+    const auto& regularRoot = Octree<int>::Debug::getRoot(regular);
+    const auto& looseRoot = Octree<int>::Debug::getRoot(loose);
+    TEST_ASSERT_EQUAL_INT(1, Octree<int>::Debug::getData(regularRoot).size());
+    TEST_ASSERT_EQUAL_INT(0, Octree<int>::Debug::getData(looseRoot).size());
+    const AABB& child = Octree<int>::Debug::getLooseBounds(Octree<int>::Debug::getChildren(looseRoot)[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0f, child.getMin().x);
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, child.getMax().x);
+
+    // Both find the same elements
+    for (int i = 0; i < 8; i++) {
+        regular.insert(i);
+        loose.insert(i);
+    }
+    Vec<Wrap<int>> regularFound, looseFound;
+    regular.query(regularFound, AABB({0.5f, 0.5f, 0.5f}, {4.5f, 4.5f, 4.5f}));
+    loose.query(looseFound, AABB({0.5f, 0.5f, 0.5f}, {4.5f, 4.5f, 4.5f}));
+    TEST_ASSERT_EQUAL_INT(regularFound.size(), looseFound.size());
+    regularFound.clear();
+    looseFound.clear();
+    regular.query(regularFound, glm::vec3(4.0f));
+    loose.query(looseFound, glm::vec3(4.0f));
+    TEST_ASSERT_EQUAL_INT(2, regularFound.size());  // 4 was inserted twice
+    TEST_ASSERT_EQUAL_INT(2, looseFound.size());
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_insert);
@@ -157,5 +325,9 @@ int main() {
     RUN_TEST(test_octree_split);
     RUN_TEST(test_out_of_bounds_insertion);
     RUN_TEST(test_insert_duplicate_elements);
+    RUN_TEST(test_remove);
+    RUN_TEST(test_collapse);
+    RUN_TEST(test_update);
+    RUN_TEST(test_loose);
     return UNITY_END();
 }
\ No newline at end of file
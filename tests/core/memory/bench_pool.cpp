@@ -0,0 +1,146 @@
+// Created by tomas on
+// 13-09-2024.
+
+#include <chrono>
+
+#include "core/memory/pool.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::memory;
+using namespace cobalt;
+
+static constexpr uint64 ALLOCATIONS = 1000000;
+
+struct Particle {
+    float position[3];
+    float velocity[3];
+    float lifetime;
+};
+
+/**
+ * @brief The pool this benchmark replaced: every chunk keeps an array of free block indices, grab() looks for the first chunk with room
+ * and drop() searches for the chunk that owns the block.
+ */
+template <typename T>
+class LegacyPool {
+    public:
+    explicit LegacyPool(const uint capacity) : heap(), chunkCount(1), blockCount(0) {
+        chunks = (Chunk*)heap.grab(sizeof(Chunk));
+        chunks[0] = createChunk(capacity);
+    }
+    ~LegacyPool() {
+        for (uint i = 0; i < chunkCount; i++) {
+            heap.drop(chunks[i].data);
+            heap.drop(chunks[i].freeBlocks);
+        }
+        heap.drop(chunks);
+    }
+
+    T* grab() {
+        blockCount++;
+        for (uint i = 0; i < chunkCount; i++) {
+            if (chunks[i].blockCount < chunks[i].blockCapacity) {
+                uint index = chunks[i].freeBlocks[chunks[i].blockCount++];
+                return (T*)((char*)chunks[i].data + index * sizeof(T));
+            }
+        }
+        chunks = (Chunk*)heap.resize(chunks, (chunkCount + 1) * sizeof(Chunk));
+        chunks[chunkCount++] = createChunk(blockCount * sizeof(T));
+        return (T*)((char*)chunks[chunkCount - 1].data + chunks[chunkCount - 1].blockCount++ * sizeof(T));
+    }
+    void drop(T* ptr) {
+        blockCount--;
+        for (uint i = 0; i < chunkCount; i++) {
+            if (ptr >= (T*)chunks[i].data && ptr < (T*)((char*)chunks[i].data + chunks[i].blockCapacity * sizeof(T))) {
+                chunks[i].freeBlocks[--chunks[i].blockCount] = (uint)((char*)ptr - (char*)chunks[i].data) / sizeof(T);
+                return;
+            }
+        }
+    }
+
+    private:
+    struct Chunk {
+        void* data;
+        uint* freeBlocks;
+        uint blockCount;
+        uint blockCapacity;
+    };
+
+    HeapAllocator heap;
+    Chunk* chunks;
+    uint chunkCount;
+    uint blockCount;
+
+    Chunk createChunk(const uint capacity) {
+        Chunk chunk = {heap.grab(capacity * sizeof(T)), (uint*)heap.grab(capacity * sizeof(uint)), 0, capacity};
+        for (uint i = 0; i < capacity; i++) {
+            chunk.freeBlocks[i] = i;
+        }
+        return chunk;
+    }
+};
+
+/**
+ * @brief Grabs a million blocks, drops every other one, grabs them back and drops everything in reverse, returning the time it took in
+ * milliseconds.
+ */
+template <typename Grab, typename Drop>
+static double churn(Grab&& grab, Drop&& drop) {
+    Vec<Particle*> particles(ALLOCATIONS);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64 i = 0; i < ALLOCATIONS; i++) {
+        particles[i] = grab();
+        particles[i]->lifetime = float(i);
+    }
+    for (uint64 i = 0; i < ALLOCATIONS; i += 2) {
+        drop(particles[i]);
+    }
+    for (uint64 i = 0; i < ALLOCATIONS; i += 2) {
+        particles[i] = grab();
+        particles[i]->lifetime = float(i);
+    }
+    float sum = 0.0f;
+    for (uint64 i = ALLOCATIONS; i-- > 0;) {
+        sum += particles[i]->lifetime;
+        drop(particles[i]);
+    }
+    const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT_TRUE(sum > 0.0f);
+    return time;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * @brief Compares the pool against new/delete and the pool it replaced, at a million allocations.
+ */
+void bench_pool() {
+    const double heap = churn([]() { return new Particle(); }, [](Particle* particle) { delete particle; });
+    double pool;
+    {
+        PoolAllocator<Particle> allocator(1024);
+        pool = churn([&]() { return allocator.grab(); }, [&](Particle* particle) { allocator.drop(particle); });
+        TEST_ASSERT_EQUAL(0, allocator.getSize());
+    }
+    double cached;
+    {
+        PoolAllocator<Particle> allocator(1024);
+        PoolAllocator<Particle>::Cache cache(allocator);
+        cached = churn([&]() { return cache.grab(); }, [&](Particle* particle) { cache.drop(particle); });
+    }
+    double legacy;
+    {
+        LegacyPool<Particle> allocator(1024);
+        legacy = churn([&]() { return allocator.grab(); }, [&](Particle* particle) { allocator.drop(particle); });
+    }
+    printf("%lu allocations: pool %.2f ms, pool through a cache %.2f ms, new/delete %.2f ms, previous pool %.2f ms\n", ALLOCATIONS, pool,
+           cached, heap, legacy);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(bench_pool);
+    return UNITY_END();
+}
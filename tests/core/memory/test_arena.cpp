@@ -6,6 +6,8 @@
 // 19-11-2023.
 //
 
+#include <memory_resource>
+
 #include "core/memory/arena.h"
 #include "unity/unity.h"
 
@@ -76,10 +78,55 @@ void test_arena_expand() {
     }
 }
 
+void test_arena_align() {
+    cobalt::core::memory::ArenaAllocator arena(64);
+    arena.grab(1);
+    for (size_t alignment = 1; alignment <= 256; alignment *= 2) {
+        void* ptr = arena.grab(3, alignment);
+        TEST_ASSERT_EQUAL_INT(0, reinterpret_cast<uintptr_t>(ptr) % alignment);
+    }
+    TEST_ASSERT_EQUAL_INT(1 + 9 * 3, arena.getSize());
+}
+
+void test_arena_reset() {
+    cobalt::core::memory::ArenaAllocator arena(16);
+    for (int i = 0; i < 100; i++) {
+        *(int*)arena.grab(sizeof(int), alignof(int)) = i;
+    }
+    const size_t reserved = arena.getReserved();
+    TEST_ASSERT_TRUE(reserved >= 100 * sizeof(int));
+    arena.reset();
+    TEST_ASSERT_EQUAL_INT(0, arena.getSize());
+    TEST_ASSERT_EQUAL_INT(reserved, arena.getReserved());
+    // After a reset, the blocks the arena grew into are merged, so the same amount of memory fits in one block.
+    char* first = (char*)arena.grab(sizeof(int), alignof(int));
+    for (int i = 1; i < 100; i++) {
+        char* ptr = (char*)arena.grab(sizeof(int), alignof(int));
+        TEST_ASSERT_EQUAL_PTR(first + i * sizeof(int), ptr);
+    }
+}
+
+void test_arena_memory_resource() {
+    cobalt::core::memory::ArenaAllocator arena(256);
+    cobalt::core::memory::ArenaResource resource(arena);
+    std::pmr::vector<int64_t> values(&resource);
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i);
+    }
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(i, values[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, reinterpret_cast<uintptr_t>(values.data()) % alignof(int64_t));
+    TEST_ASSERT_TRUE(arena.getSize() >= 1000 * sizeof(int64_t));
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_arena_grab);
     RUN_TEST(test_arena_resize);
     RUN_TEST(test_arena_expand);
+    RUN_TEST(test_arena_align);
+    RUN_TEST(test_arena_reset);
+    RUN_TEST(test_arena_memory_resource);
     return UNITY_END();
 }
\ No newline at end of file
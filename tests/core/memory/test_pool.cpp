@@ -60,10 +60,68 @@ void test_pool_expand() {
     TEST_ASSERT_EQUAL_INT(0 * sizeof(int), pool.getSize());
 }
 
+struct alignas(64) Aligned {
+    char data[3];
+};
+
+void test_pool_align() {
+    cobalt::core::memory::PoolAllocator<Aligned> pool(3);
+    for (int i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL_INT(0, reinterpret_cast<uintptr_t>(pool.grab()) % 64);
+    }
+}
+
+void test_pool_reuse() {
+    cobalt::core::memory::PoolAllocator<int> pool(4);
+    int* ptr[100];
+    for (int i = 0; i < 100; i++) {
+        ptr[i] = pool.grab();
+        TEST_ASSERT_TRUE(pool.owns(ptr[i]));
+    }
+    int outside = 0;
+    TEST_ASSERT_FALSE(pool.owns(&outside));
+    pool.drop(ptr[42]);
+    pool.drop(ptr[7]);
+    TEST_ASSERT_EQUAL_PTR(ptr[7], pool.grab());
+    TEST_ASSERT_EQUAL_PTR(ptr[42], pool.grab());
+    TEST_ASSERT_EQUAL_INT(100 * sizeof(int), pool.getSize());
+}
+
+void test_pool_cache() {
+    cobalt::core::memory::PoolAllocator<uint64_t> pool(16);
+    std::vector<std::thread> threads;
+    std::atomic<int> corrupted = 0;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&pool, &corrupted, t]() {
+            cobalt::core::memory::PoolAllocator<uint64_t>::Cache cache(pool, 8);
+            std::vector<uint64_t*> ptr;
+            for (int round = 0; round < 10; round++) {
+                for (int i = 0; i < 100; i++) {
+                    ptr.push_back(cache.grab());
+                    *ptr.back() = t * 1000 + i;
+                }
+                for (int i = 0; i < 100; i++) {
+                    corrupted += *ptr[i] != uint64_t(t * 1000 + i);
+                    cache.drop(ptr[i]);
+                }
+                ptr.clear();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    TEST_ASSERT_EQUAL_INT(0, corrupted.load());
+    TEST_ASSERT_EQUAL_INT(0, pool.getSize());
+}
+
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_pool_grab);
     RUN_TEST(test_pool_drop);
     RUN_TEST(test_pool_expand);
+    RUN_TEST(test_pool_align);
+    RUN_TEST(test_pool_reuse);
+    RUN_TEST(test_pool_cache);
     return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+// Created by tomas on
+// 16-09-2024.
+
+#include <thread>
+
+#include "core/memory/stack.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::memory;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_stack_marker() {
+    StackAllocator stack(1024);
+    int* first = stack.grabArray<int>(4);
+    const StackAllocator::Marker marker = stack.getMarker();
+    int* second = stack.grabArray<int>(16);
+    TEST_ASSERT_EQUAL_INT(20 * sizeof(int), stack.getSize());
+    stack.freeToMarker(marker);
+    TEST_ASSERT_EQUAL_INT(4 * sizeof(int), stack.getSize());
+    // The freed memory is handed out again.
+    TEST_ASSERT_EQUAL_PTR(second, stack.grabArray<int>(16));
+    stack.reset();
+    TEST_ASSERT_EQUAL_INT(0, stack.getSize());
+    TEST_ASSERT_EQUAL_PTR(first, stack.grabArray<int>(4));
+}
+
+void test_stack_scope_guard() {
+    StackAllocator stack(1024);
+    stack.grab(100);
+    {
+        StackAllocator::ScopeGuard outer(stack);
+        stack.grab(200);
+        {
+            StackAllocator::ScopeGuard inner(stack);
+            stack.grab(300);
+            TEST_ASSERT_EQUAL_INT(600, stack.getSize());
+        }
+        TEST_ASSERT_EQUAL_INT(300, stack.getSize());
+    }
+    TEST_ASSERT_EQUAL_INT(100, stack.getSize());
+}
+
+void test_stack_grow() {
+    StackAllocator stack(64);
+    const StackAllocator::Marker marker = stack.getMarker();
+    for (int i = 0; i < 100; i++) {
+        double* value = (double*)stack.grab(sizeof(double), alignof(double));
+        TEST_ASSERT_EQUAL_INT(0, (uintptr_t)value % alignof(double));
+        *value = i;
+    }
+    TEST_ASSERT_EQUAL_INT(100 * sizeof(double), stack.getSize());
+    const size_t reserved = stack.getReserved();
+    TEST_ASSERT_TRUE(reserved >= 100 * sizeof(double));
+    stack.freeToMarker(marker);
+    TEST_ASSERT_EQUAL_INT(0, stack.getSize());
+    // The blocks are kept after freeing, until trimmed.
+    TEST_ASSERT_EQUAL_INT(reserved, stack.getReserved());
+    stack.trim();
+    TEST_ASSERT_EQUAL_INT(64, stack.getReserved());
+}
+
+void test_stack_resize() {
+    StackAllocator stack(1024);
+    int* values = stack.grabArray<int>(4);
+    for (int i = 0; i < 4; i++) {
+        values[i] = i;
+    }
+    // The top of the stack grows in place.
+    TEST_ASSERT_EQUAL_PTR(values, stack.resize(values, 4 * sizeof(int), 8 * sizeof(int)));
+    TEST_ASSERT_EQUAL_INT(8 * sizeof(int), stack.getSize());
+    stack.grab(1);
+    // Anything below it is copied.
+    int* moved = (int*)stack.resize(values, 8 * sizeof(int), 16 * sizeof(int));
+    TEST_ASSERT_TRUE(moved != values);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(i, moved[i]);
+    }
+}
+
+void test_stack_scratch() {
+    StackAllocator* local = &StackAllocator::getScratch();
+    StackAllocator* other = nullptr;
+    std::thread thread([&]() { other = &StackAllocator::getScratch(); });
+    thread.join();
+    TEST_ASSERT_TRUE(local == &StackAllocator::getScratch());
+    TEST_ASSERT_TRUE(local != other);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stack_marker);
+    RUN_TEST(test_stack_scope_guard);
+    RUN_TEST(test_stack_grow);
+    RUN_TEST(test_stack_resize);
+    RUN_TEST(test_stack_scratch);
+    return UNITY_END();
+}
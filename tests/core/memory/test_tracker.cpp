@@ -0,0 +1,108 @@
+// Created by tomas on
+// 15-09-2024.
+
+#include <thread>
+#include <vector>
+
+#include "core/memory/heap.h"
+#include "core/memory/tracker.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::memory;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_tracker_usage() {
+    const MemoryUsage before = MemoryTracker::getUsage(MemoryTag::General);
+    MemoryTracker::record(MemoryTag::General, 1000);
+    MemoryTracker::record(MemoryTag::General, 500);
+    MemoryUsage usage = MemoryTracker::getUsage(MemoryTag::General);
+    TEST_ASSERT_EQUAL_UINT64(before.bytes + 1500, usage.bytes);
+    TEST_ASSERT_EQUAL_UINT64(before.allocations + 2, usage.allocations);
+    TEST_ASSERT_TRUE(usage.peak >= before.bytes + 1500);
+    MemoryTracker::release(MemoryTag::General, 1500);
+    usage = MemoryTracker::snapshot()[(size_t)MemoryTag::General];
+    TEST_ASSERT_EQUAL_UINT64(before.bytes, usage.bytes);
+    TEST_ASSERT_EQUAL_UINT64(before.allocations + 2, usage.allocations);
+    TEST_ASSERT_TRUE(usage.peak >= before.bytes + 1500);
+}
+
+void test_tracker_budget() {
+    const uint64_t base = MemoryTracker::getUsage(MemoryTag::Shaders).bytes;
+    int calls = 0;
+    uint64_t reported = 0;
+    MemoryTracker::setBudget(MemoryTag::Shaders, base + 1000, [&](const MemoryTag tag, const MemoryUsage& usage) {
+        calls++;
+        reported = usage.bytes;
+    });
+    MemoryTracker::record(MemoryTag::Shaders, 600);
+    MemoryTracker::flush();
+    TEST_ASSERT_EQUAL_INT(0, calls);
+    MemoryTracker::record(MemoryTag::Shaders, 600);
+    MemoryTracker::flush();
+    TEST_ASSERT_EQUAL_INT(1, calls);
+    TEST_ASSERT_EQUAL_UINT64(base + 1200, reported);
+    // Only called again once the tag has come back under the budget.
+    MemoryTracker::record(MemoryTag::Shaders, 100);
+    MemoryTracker::flush();
+    TEST_ASSERT_EQUAL_INT(1, calls);
+    MemoryTracker::release(MemoryTag::Shaders, 1300);
+    MemoryTracker::flush();
+    MemoryTracker::record(MemoryTag::Shaders, 2000);
+    MemoryTracker::flush();
+    TEST_ASSERT_EQUAL_INT(2, calls);
+    MemoryTracker::clearBudget(MemoryTag::Shaders);
+    MemoryTracker::release(MemoryTag::Shaders, 2000);
+    MemoryTracker::record(MemoryTag::Shaders, 2000);
+    MemoryTracker::release(MemoryTag::Shaders, 2000);
+    MemoryTracker::flush();
+    TEST_ASSERT_EQUAL_INT(2, calls);
+}
+
+void test_tracker_threads() {
+    const MemoryUsage before = MemoryTracker::getUsage(MemoryTag::Events);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 100; i++) {
+                MemoryTracker::record(MemoryTag::Events, 1000);
+            }
+            for (int i = 0; i < 50; i++) {
+                MemoryTracker::release(MemoryTag::Events, 1000);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    // Every thread flushed its counters on exit.
+    const MemoryUsage after = MemoryTracker::getUsage(MemoryTag::Events);
+    TEST_ASSERT_EQUAL_UINT64(before.bytes + 8 * 50 * 1000, after.bytes);
+    TEST_ASSERT_EQUAL_UINT64(before.allocations + 8 * 100, after.allocations);
+}
+
+#ifdef CB_MEMORY_TRACKING
+void test_tracker_heap() {
+    const MemoryUsage before = MemoryTracker::getUsage(MemoryTag::Meshes);
+    HeapAllocator heap(MemoryTag::Meshes);
+    void* ptr = heap.grab(256);
+    TEST_ASSERT_EQUAL_UINT64(before.bytes + 256, MemoryTracker::getUsage(MemoryTag::Meshes).bytes);
+    ptr = heap.resize(ptr, 512);
+    TEST_ASSERT_EQUAL_UINT64(before.bytes + 512, MemoryTracker::getUsage(MemoryTag::Meshes).bytes);
+    heap.drop(ptr);
+    TEST_ASSERT_EQUAL_UINT64(before.bytes, MemoryTracker::getUsage(MemoryTag::Meshes).bytes);
+}
+#endif
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tracker_usage);
+    RUN_TEST(test_tracker_budget);
+    RUN_TEST(test_tracker_threads);
+#ifdef CB_MEMORY_TRACKING
+    RUN_TEST(test_tracker_heap);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,94 @@
+// Created by tomas on
+// 11-09-2024.
+
+#include "core/thread/queue.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::thread;
+using namespace cobalt;
+
+static constexpr uint64 PRODUCERS = 16;
+static constexpr uint64 PUSHES = 10000;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_queue_push_pop() {
+    MPSCQueue<uint64> queue(6);
+    TEST_ASSERT_EQUAL(8, queue.getCapacity());
+    TEST_ASSERT_FALSE(queue.pop());
+    for (uint64 i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(i < 8, queue.push(i));
+    }
+    TEST_ASSERT_EQUAL(2, queue.getDrops());
+    TEST_ASSERT_EQUAL(0, *queue.pop());
+    TEST_ASSERT_EQUAL(1, *queue.pop());
+    TEST_ASSERT_TRUE(queue.push(8));
+    uint64 expected = 2;
+    const uint64 handled = queue.drain([&](const uint64 value) {
+        TEST_ASSERT_EQUAL(expected, value);
+        expected++;
+    });
+    TEST_ASSERT_EQUAL(7, handled);
+    TEST_ASSERT_EQUAL(7, queue.getHighWaterMark());
+    TEST_ASSERT_FALSE(queue.pop());
+    // The ring wraps around.
+    for (uint64 i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+        TEST_ASSERT_EQUAL(i, *queue.pop());
+    }
+    TEST_ASSERT_EQUAL(2, queue.getDrops());
+}
+
+void test_queue_stress() {
+    MPSCQueue<uint64> queue(1024);
+    std::atomic<uint64> finished = 0;
+    Vec<std::thread> producers;
+    for (uint64 producer = 0; producer < PRODUCERS; producer++) {
+        producers.emplace_back([&queue, &finished, producer]() {
+            // Back off and retry when the queue is full, so every value gets through and the order can be checked.
+            for (uint64 i = 0; i < PUSHES; i++) {
+                while (!queue.push((producer << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+            finished.fetch_add(1);
+        });
+    }
+    Vec<int64> last(PRODUCERS, -1);
+    uint64 received = 0;
+    uint64 outOfOrder = 0;
+    const auto receive = [&](const uint64 value) {
+        const uint64 producer = value >> 32;
+        const int64 index = int64(value & 0xFFFFFFFF);
+        if (producer >= PRODUCERS || index <= last[producer]) {
+            outOfOrder++;
+        } else {
+            last[producer] = index;
+        }
+        received++;
+    };
+    while (finished.load() < PRODUCERS) {
+        if (queue.drain(receive) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    queue.drain(receive);
+    TEST_ASSERT_EQUAL(0, outOfOrder);
+    TEST_ASSERT_EQUAL(PRODUCERS * PUSHES, received);
+    TEST_ASSERT_TRUE(queue.getHighWaterMark() <= queue.getCapacity());
+    TEST_ASSERT_FALSE(queue.pop());
+    printf("%lu producers, %lu pushes each: %lu received, %lu pushes refused, high-water mark %lu of %lu\n", PRODUCERS, PUSHES, received,
+           queue.getDrops(), queue.getHighWaterMark(), queue.getCapacity());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_queue_push_pop);
+    RUN_TEST(test_queue_stress);
+    return UNITY_END();
+}
@@ -0,0 +1,59 @@
+// Created by tomas on
+// 03-09-2024.
+
+#include "core/thread/pool.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core::thread;
+using namespace cobalt;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_thread_pool_submit() {
+    std::atomic<uint64> sum = 0;
+    {
+        ThreadPool pool(4);
+        TEST_ASSERT_EQUAL(4, pool.getThreadCount());
+        for (uint64 i = 1; i <= 1000; i++) {
+            pool.submit([&sum, i]() { sum.fetch_add(i); });
+        }
+    }
+    TEST_ASSERT_EQUAL(500500, sum.load());
+}
+
+void test_thread_pool_nested() {
+    ThreadPool pool(3);
+    std::atomic<uint64> done = 0;
+    for (uint64 i = 0; i < 100; i++) {
+        pool.submit([&pool, &done]() {
+            for (uint64 j = 0; j < 10; j++) {
+                pool.submit([&done]() { done.fetch_add(1); });
+            }
+            done.fetch_add(1);
+        });
+    }
+    while (done.load() < 1100) {
+        if (!pool.help()) {
+            std::this_thread::yield();
+        }
+    }
+    TEST_ASSERT_EQUAL(1100, done.load());
+}
+
+void test_thread_pool_empty() {
+    ThreadPool pool(0);
+    uint64 ran = 0;
+    pool.submit([&ran]() { ran++; });
+    TEST_ASSERT_EQUAL(1, ran);
+    TEST_ASSERT_FALSE(pool.help());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_thread_pool_submit);
+    RUN_TEST(test_thread_pool_nested);
+    RUN_TEST(test_thread_pool_empty);
+    return UNITY_END();
+}
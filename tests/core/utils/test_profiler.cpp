@@ -0,0 +1,102 @@
+// Created by tomas on
+// 17-09-2024.
+
+#include <filesystem>
+#include <thread>
+
+#include "core/utils/profiler.h"
+#include "unity/unity.h"
+
+using namespace cobalt::core;
+using namespace cobalt;
+
+void setUp(void) { Profiler::reset(); }
+
+void tearDown(void) {}
+
+void test_stats() {
+    TEST_ASSERT_EQUAL(0, Profiler::getStats("physics").samples);
+    for (uint64 i = 1; i <= 100; i++) {
+        Profiler::record("physics", "Update", 0, i * 1000);
+    }
+    ProfileStats stats = Profiler::getStats("physics");
+    TEST_ASSERT_EQUAL(100, stats.samples);
+    TEST_ASSERT_TRUE(stats.mean == 50.5);
+    TEST_ASSERT_TRUE(stats.p50 == 50.0);
+    TEST_ASSERT_TRUE(stats.p99 == 99.0);
+    TEST_ASSERT_TRUE(stats.max == 100.0);
+
+    // Only the last runs are kept.
+    for (uint64 i = 0; i < Profiler::WINDOW; i++) {
+        Profiler::record("physics", "Update", 0, 1000);
+    }
+    stats = Profiler::getStats("physics");
+    TEST_ASSERT_EQUAL(Profiler::WINDOW, stats.samples);
+    TEST_ASSERT_TRUE(stats.max == 1.0);
+    TEST_ASSERT_EQUAL(1, Profiler::getNames().size());
+}
+
+void test_scope() {
+    {
+        ProfileScope scope("sleep", "Update");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const ProfileStats stats = Profiler::getStats("sleep");
+    TEST_ASSERT_EQUAL(1, stats.samples);
+    TEST_ASSERT_TRUE(stats.max >= 2000.0);
+}
+
+void test_threads() {
+    // Every thread buffers its own runs, which all show up once merged.
+    Vec<std::thread> workers;
+    for (uint t = 0; t < 4; t++) {
+        workers.emplace_back([]() {
+            for (uint64 i = 0; i < 16; i++) {
+                ProfileScope scope("parallel", "Update");
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    Profiler::endFrame();
+    TEST_ASSERT_EQUAL(64, Profiler::getStats("parallel").samples);
+    Profiler::reset();
+    TEST_ASSERT_EQUAL(0, Profiler::getStats("parallel").samples);
+    TEST_ASSERT_EQUAL(0, Profiler::getNames().size());
+}
+
+void test_capture() {
+    const std::string path = (std::filesystem::temp_directory_path() / "cobalt_trace.json").string();
+    std::filesystem::remove(path);
+    Profiler::capture(io::Path(path, false), 2);
+    TEST_ASSERT_TRUE(Profiler::isCapturing());
+    Profiler::record("\"quoted\"", "Update", 10000, 20000);
+    Profiler::endFrame();
+    TEST_ASSERT_FALSE(std::filesystem::exists(path));
+    std::thread worker([]() { Profiler::record("worker", "Update", 30000, 35500); });
+    worker.join();
+    Profiler::endFrame();
+    TEST_ASSERT_FALSE(Profiler::isCapturing());
+
+    const std::string trace = io::File(io::Path(path, false)).read();
+    TEST_ASSERT_EQUAL(0, trace.find("{\"traceEvents\":["));
+    TEST_ASSERT_TRUE(trace.find("\"name\":\"\\\"quoted\\\"\",\"cat\":\"Update\",\"ph\":\"X\",\"ts\":10.000,\"dur\":10.000") != std::string::npos);
+    TEST_ASSERT_TRUE(trace.find("\"name\":\"worker\",\"cat\":\"Update\",\"ph\":\"X\",\"ts\":30.000,\"dur\":5.500") != std::string::npos);
+    TEST_ASSERT_TRUE(trace.find("\"name\":\"Frame\"") != std::string::npos);
+
+    // Nothing is captured once the capture is over.
+    Profiler::record("late", "Update", 0, 1);
+    Profiler::endFrame();
+    TEST_ASSERT_EQUAL(trace.size(), io::File(io::Path(path, false)).read().size());
+    std::filesystem::remove(path);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stats);
+    RUN_TEST(test_scope);
+    RUN_TEST(test_threads);
+    RUN_TEST(test_capture);
+    return UNITY_END();
+}